@@ -0,0 +1,51 @@
+#include "benchmark/benchmark.h"
+#include "HeapBenchmark.hpp"
+
+#include <queue>
+
+#include "heaps/BinomialHeap.hpp"
+#include "heaps/CompactFibonacciHeap.hpp"
+#include "heaps/FibonacciHeap.hpp"
+#include "heaps/PairingHeap.hpp"
+#include "heaps/PersistentBinomialHeap.hpp"
+#include "heaps/WilliamHeap.hpp"
+
+BENCHMARK_TEMPLATE(push_benchmark, std::priority_queue<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(push_benchmark, WilliamHeap<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(push_benchmark, BinomialHeap<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(push_benchmark, FibonacciHeap<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(push_benchmark, EagerFibonacciHeap<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(push_benchmark, CompactFibonacciHeap<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(push_benchmark, PairingHeap<int>)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_TEMPLATE(push_pop_benchmark, std::priority_queue<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(push_pop_benchmark, WilliamHeap<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(push_pop_benchmark, BinomialHeap<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(push_pop_benchmark, FibonacciHeap<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(push_pop_benchmark, EagerFibonacciHeap<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(push_pop_benchmark, CompactFibonacciHeap<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(push_pop_benchmark, PairingHeap<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(push_pop_benchmark, PersistentBinomialHeap<int>)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_TEMPLATE(range_build_benchmark, std::priority_queue<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(range_build_benchmark, BinomialHeap<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(range_build_benchmark, FibonacciHeap<int>)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_TEMPLATE(fork_benchmark, BinomialHeap<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(fork_benchmark, PersistentBinomialHeap<int>)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_TEMPLATE(dijkstra_benchmark, FibonacciHeap<std::int64_t>)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(dijkstra_benchmark, EagerFibonacciHeap<std::int64_t>)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(dijkstra_benchmark, CompactFibonacciHeap<std::int64_t>)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(dijkstra_benchmark, PairingHeap<std::int64_t>)->Range(1 << 10, 1 << 18);
+
+BENCHMARK_TEMPLATE(meld_benchmark, BinomialHeap<int>)->Ranges({{8, 512}, {0, 1}});
+BENCHMARK_TEMPLATE(meld_benchmark, FibonacciHeap<int>)->Ranges({{8, 512}, {0, 1}});
+
+BENCHMARK_TEMPLATE(latency_benchmark, std::priority_queue<int>)->Range(1 << 8, 1 << 14);
+BENCHMARK_TEMPLATE(latency_benchmark, BinomialHeap<int>)->Range(1 << 8, 1 << 14);
+BENCHMARK_TEMPLATE(latency_benchmark, FibonacciHeap<int>)->Range(1 << 8, 1 << 14);
+BENCHMARK_TEMPLATE(latency_benchmark, EagerFibonacciHeap<int>)->Range(1 << 8, 1 << 14);
+BENCHMARK_TEMPLATE(latency_benchmark, PairingHeap<int>)->Range(1 << 8, 1 << 14);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,244 @@
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+template<class T>
+void push_benchmark(benchmark::State& state) {
+	std::size_t size = state.range(0);
+	for (auto _ : state) {
+		std::default_random_engine random(1227992885);
+		T heap;
+		for (std::size_t i = 0; i < size; ++i) {
+			heap.push(random());
+		}
+		benchmark::DoNotOptimize(heap.top());
+	}
+	state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<class T>
+void push_pop_benchmark(benchmark::State& state) {
+	std::size_t size = state.range(0);
+	for (auto _ : state) {
+		std::default_random_engine random(1227992885);
+		T heap;
+		for (std::size_t i = 0; i < size; ++i) {
+			heap.push(random());
+		}
+		while (!heap.empty()) {
+			benchmark::DoNotOptimize(heap.top());
+			heap.pop();
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * size);
+}
+
+/**
+ * @brief Builds a heap from a range and pops its top, like reloading it from a snapshot
+ */
+template<class T>
+void range_build_benchmark(benchmark::State& state) {
+	std::size_t size = state.range(0);
+	std::default_random_engine random(1227992885);
+	std::vector<int> elems;
+	for (std::size_t i = 0; i < size; ++i) {
+		elems.push_back(random());
+	}
+
+	for (auto _ : state) {
+		T heap(elems.begin(), elems.end());
+		heap.pop();
+		benchmark::DoNotOptimize(heap.top());
+	}
+	state.SetItemsProcessed(state.iterations() * size);
+}
+
+/**
+ * @brief What-if exploration: a base heap of range(0) elements is forked many times,
+ * and each fork pushes and pops a few elements
+ */
+template<class T>
+void fork_benchmark(benchmark::State& state) {
+	std::size_t size = state.range(0);
+	std::default_random_engine random(1227992885);
+	T base;
+	for (std::size_t i = 0; i < size; ++i) {
+		base.push(random());
+	}
+
+	for (auto _ : state) {
+		T fork(base);
+		for (std::size_t i = 0; i < 4; ++i) {
+			fork.push(random());
+			fork.pop();
+		}
+		benchmark::DoNotOptimize(fork.top());
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Random directed graph used by the Dijkstra benchmarks.
+ * Adjacency lists are stored in CSR format.
+ */
+struct Graph {
+	std::vector<std::size_t> first;
+	std::vector<std::size_t> target;
+	std::vector<std::int64_t> weight;
+
+	Graph(std::size_t vertices, std::size_t degree) {
+		std::default_random_engine random(1227992885);
+		first.reserve(vertices + 1);
+		for (std::size_t v = 0; v < vertices; ++v) {
+			first.push_back(target.size());
+			for (std::size_t i = 0; i < degree; ++i) {
+				target.push_back(random() % vertices);
+				weight.push_back(1 + random() % 1000);
+			}
+		}
+		first.push_back(target.size());
+	}
+
+	std::size_t vertices() const {
+		return first.size() - 1;
+	}
+};
+
+/**
+ * @brief Dijkstra using decreaseKey. The heaps are max-heaps, so the keys are the
+ * negated distances, packed together with the vertex: -(distance * vertices + vertex)
+ */
+template<class T>
+void dijkstra_benchmark(benchmark::State& state) {
+	Graph graph(state.range(0), 8);
+	std::size_t n = graph.vertices();
+	std::int64_t unreached = std::numeric_limits<std::int64_t>::max();
+
+	for (auto _ : state) {
+		T heap;
+		std::vector<std::int64_t> distance(n, unreached);
+		std::vector<decltype(heap.push(0))> node(n);
+		std::vector<bool> popped(n, false);
+
+		distance[0] = 0;
+		node[0] = heap.push(0);
+		while (!heap.empty()) {
+			std::int64_t key = -heap.pop();
+			std::size_t v = key % n;
+			popped[v] = true;
+
+			for (std::size_t e = graph.first[v]; e < graph.first[v + 1]; ++e) {
+				std::size_t w = graph.target[e];
+				std::int64_t d = distance[v] + graph.weight[e];
+				if (d < distance[w]) {
+					std::int64_t newKey = -(d * (std::int64_t)n + (std::int64_t)w);
+					if (distance[w] == unreached) node[w] = heap.push(newKey);
+					else if (!popped[w]) heap.decreaseKey(node[w], newKey);
+					distance[w] = d;
+				}
+			}
+		}
+		benchmark::DoNotOptimize(distance.data());
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+/**
+ * @brief Folds range(0) heaps of 256 elements into one, either merging them one by one
+ * (range(1) == 0) or with a single meld_all (range(1) == 1)
+ */
+template<class T>
+void meld_benchmark(benchmark::State& state) {
+	std::size_t count = state.range(0);
+	bool meld_all = state.range(1) == 1;
+	std::default_random_engine random(1227992885);
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		T heap;
+		std::vector<T> others(count);
+		for (std::size_t h = 0; h < count; ++h) {
+			for (std::size_t i = 0; i < 256; ++i) {
+				others[h].push(random());
+			}
+		}
+		state.ResumeTiming();
+
+		if (meld_all) {
+			heap.meld_all(others.begin(), others.end());
+		}
+		else {
+			for (std::size_t h = 0; h < count; ++h) {
+				heap.merge(others[h]);
+			}
+		}
+		benchmark::DoNotOptimize(heap.top());
+
+		state.PauseTiming();
+		// The teardown is not measured
+		heap = T();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+/**
+ * @brief Percentile of a sorted list of latencies
+ */
+inline double percentile(std::vector<double> const& sorted, double p) {
+	std::size_t index = (std::size_t)(p * (sorted.size() - 1));
+	return sorted[index];
+}
+
+/**
+ * @brief Latency histogram of push and pop. Each round pushes a burst of range(0)
+ * elements and then pops half of them, so the heap grows and every burst is followed
+ * by a pop that may have to consolidate it. Every operation is timed, and the
+ * percentiles (in nanoseconds) are reported as counters.
+ */
+template<class T>
+void latency_benchmark(benchmark::State& state) {
+	std::size_t burst = state.range(0);
+	std::size_t rounds = 64;
+	std::vector<double> push_latency, pop_latency;
+	push_latency.reserve(burst * rounds);
+	pop_latency.reserve(burst * rounds / 2);
+
+	for (auto _ : state) {
+		std::default_random_engine random(1227992885);
+		T heap;
+		for (std::size_t r = 0; r < rounds; ++r) {
+			for (std::size_t i = 0; i < burst; ++i) {
+				int elem = random();
+				auto start = std::chrono::steady_clock::now();
+				heap.push(elem);
+				auto end = std::chrono::steady_clock::now();
+				push_latency.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+			}
+			for (std::size_t i = 0; i < burst / 2; ++i) {
+				auto start = std::chrono::steady_clock::now();
+				benchmark::DoNotOptimize(heap.top());
+				heap.pop();
+				auto end = std::chrono::steady_clock::now();
+				pop_latency.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+			}
+		}
+	}
+
+	std::sort(push_latency.begin(), push_latency.end());
+	std::sort(pop_latency.begin(), pop_latency.end());
+	state.counters["push_p50"] = percentile(push_latency, 0.5);
+	state.counters["push_p99"] = percentile(push_latency, 0.99);
+	state.counters["push_p99.9"] = percentile(push_latency, 0.999);
+	state.counters["push_max"] = push_latency.back();
+	state.counters["pop_p50"] = percentile(pop_latency, 0.5);
+	state.counters["pop_p99"] = percentile(pop_latency, 0.99);
+	state.counters["pop_p99.9"] = percentile(pop_latency, 0.999);
+	state.counters["pop_max"] = pop_latency.back();
+	state.SetItemsProcessed(state.iterations() * rounds * (burst + burst / 2));
+}
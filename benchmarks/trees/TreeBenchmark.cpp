@@ -0,0 +1,93 @@
+#include "benchmark/benchmark.h"
+#include "TreeBenchmark.hpp"
+
+#include <set>
+#include <string>
+
+#include "trees/AVLTree.hpp"
+#include "trees/BPlusTree.hpp"
+#include "trees/CompactAVLTree.hpp"
+#include "trees/SplayTree.hpp"
+#include "trees/FrozenSet.hpp"
+#include "trees/IntegerSet.hpp"
+#include "trees/RedBlackTree.hpp"
+
+BENCHMARK_TEMPLATE(insert_benchmark, std::set<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(insert_benchmark, AVLTree<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(insert_benchmark, CompactAVLTree<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(insert_benchmark, LeftLeaningRedBlackTree<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(insert_benchmark, BPlusTree<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(insert_benchmark, IntegerSet<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(insert_benchmark, std::set<std::string>, std::string)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(insert_benchmark, AVLTree<std::string>, std::string)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(insert_benchmark, LeftLeaningRedBlackTree<std::string>, std::string)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(insert_benchmark, BPlusTree<std::string>, std::string)->Range(1 << 10, 1 << 18);
+
+BENCHMARK_TEMPLATE(insert_erase_benchmark, std::set<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(insert_erase_benchmark, AVLTree<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(insert_erase_benchmark, CompactAVLTree<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(insert_erase_benchmark, LeftLeaningRedBlackTree<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(insert_erase_benchmark, BPlusTree<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(insert_erase_benchmark, IntegerSet<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(insert_erase_benchmark, std::set<std::string>, std::string)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(insert_erase_benchmark, AVLTree<std::string>, std::string)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(insert_erase_benchmark, LeftLeaningRedBlackTree<std::string>, std::string)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(insert_erase_benchmark, BPlusTree<std::string>, std::string)->Range(1 << 10, 1 << 18);
+
+BENCHMARK_TEMPLATE(contains_benchmark, std::set<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(contains_benchmark, AVLTree<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(contains_benchmark, CompactAVLTree<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(contains_benchmark, LeftLeaningRedBlackTree<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(contains_benchmark, BPlusTree<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(contains_benchmark, IntegerSet<int>, int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(contains_benchmark, std::set<std::string>, std::string)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(contains_benchmark, AVLTree<std::string>, std::string)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(contains_benchmark, LeftLeaningRedBlackTree<std::string>, std::string)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(contains_benchmark, BPlusTree<std::string>, std::string)->Range(1 << 10, 1 << 18);
+
+BENCHMARK_TEMPLATE(zipf_contains_benchmark, std::set<int>, int)->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {0, 80, 99, 120}});
+BENCHMARK_TEMPLATE(zipf_contains_benchmark, AVLTree<int>, int)->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {0, 80, 99, 120}});
+BENCHMARK_TEMPLATE(zipf_contains_benchmark, LeftLeaningRedBlackTree<int>, int)->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {0, 80, 99, 120}});
+BENCHMARK_TEMPLATE(zipf_contains_benchmark, SplayTree<int>, int)->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {0, 80, 99, 120}});
+BENCHMARK_TEMPLATE(zipf_contains_benchmark, AVLTree<std::string>, std::string)->ArgsProduct({{1 << 10, 1 << 18}, {0, 99, 120}});
+BENCHMARK_TEMPLATE(zipf_contains_benchmark, SplayTree<std::string>, std::string)->ArgsProduct({{1 << 10, 1 << 18}, {0, 99, 120}});
+
+BENCHMARK_TEMPLATE(sorted_build_benchmark, std::set<int>, int)->Ranges({{1 << 10, 1 << 20}, {0, 1}});
+BENCHMARK_TEMPLATE(sorted_build_benchmark, AVLTree<int>, int)->Ranges({{1 << 10, 1 << 20}, {0, 1}});
+BENCHMARK_TEMPLATE(sorted_build_benchmark, CompactAVLTree<int>, int)->Ranges({{1 << 10, 1 << 20}, {0, 1}});
+BENCHMARK_TEMPLATE(sorted_build_benchmark, LeftLeaningRedBlackTree<int>, int)->Ranges({{1 << 10, 1 << 20}, {0, 1}});
+BENCHMARK_TEMPLATE(sorted_build_benchmark, BPlusTree<int>, int)->Ranges({{1 << 10, 1 << 20}, {0, 1}});
+BENCHMARK_TEMPLATE(sorted_build_benchmark, IntegerSet<int>, int)->Ranges({{1 << 10, 1 << 20}, {0, 1}});
+
+BENCHMARK_TEMPLATE(lookup_benchmark, std::set<int>, int)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(lookup_benchmark, AVLTree<int>, int)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(lookup_benchmark, CompactAVLTree<int>, int)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(lookup_benchmark, BPlusTree<int>, int)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(lookup_benchmark, FrozenSet<int>, int)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(lookup_benchmark, IntegerSet<int>, int)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(lookup_benchmark, AVLTree<std::string>, std::string)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(lookup_benchmark, FrozenSet<std::string>, std::string)->Range(1 << 10, 1 << 18);
+
+BENCHMARK_TEMPLATE(successor_benchmark, std::set<int>, int)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(successor_benchmark, AVLTree<int>, int)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(successor_benchmark, BPlusTree<int>, int)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(successor_benchmark, FrozenSet<int>, int)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(successor_benchmark, IntegerSet<int>, int)->Range(1 << 10, 1 << 22);
+
+BENCHMARK_TEMPLATE(contains_batch_benchmark, AVLTree<int>, int)->Ranges({{1 << 10, 1 << 22}, {0, 1}});
+BENCHMARK_TEMPLATE(contains_batch_benchmark, LeftLeaningRedBlackTree<int>, int)->Ranges({{1 << 10, 1 << 22}, {0, 1}});
+BENCHMARK_TEMPLATE(contains_batch_benchmark, AVLTree<std::string>, std::string)->Ranges({{1 << 10, 1 << 18}, {0, 1}});
+
+BENCHMARK_TEMPLATE(union_benchmark, AVLTree<int>)->Ranges({{1 << 20, 1 << 20}, {1 << 10, 1 << 20}, {0, 2}});
+
+BENCHMARK(interval_scan_benchmark)->Range(1 << 10, 1 << 20);
+BENCHMARK(interval_tree_benchmark)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(locked_read_benchmark)->ThreadRange(2, 16)->UseRealTime();
+BENCHMARK(snapshot_read_benchmark)->ThreadRange(2, 16)->UseRealTime();
+
+BENCHMARK_TEMPLATE(locked_mixed_benchmark, AVLTree<int>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(locked_mixed_benchmark, LeftLeaningRedBlackTree<int>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(skiplist_mixed_benchmark)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,447 @@
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "trees/AVLTree.hpp"
+#include "trees/ConcurrentAVLTree.hpp"
+#include "trees/ConcurrentSkipList.hpp"
+#include "trees/IntervalTree.hpp"
+
+/**
+ * @brief Keys used by the benchmarks. Heavy keys are long strings with a common
+ * prefix, so copying and comparing them is expensive.
+ */
+template<class Key>
+Key make_key(std::uint32_t value);
+
+template<>
+inline int make_key<int>(std::uint32_t value) {
+	return (int)value;
+}
+
+template<>
+inline std::string make_key<std::string>(std::uint32_t value) {
+	return std::string(48, 'k') + std::to_string(value);
+}
+
+template<class Key>
+std::vector<Key> make_keys(std::size_t size) {
+	std::default_random_engine random(1227992885);
+	std::vector<Key> keys;
+	keys.reserve(size);
+	for (std::size_t i = 0; i < size; ++i) {
+		keys.push_back(make_key<Key>(random()));
+	}
+	return keys;
+}
+
+template<class T, class Key>
+void insert_benchmark(benchmark::State& state) {
+	std::vector<Key> keys = make_keys<Key>(state.range(0));
+	for (auto _ : state) {
+		T tree;
+		for (Key const& key : keys) {
+			tree.insert(key);
+		}
+		benchmark::DoNotOptimize(tree.count(keys[0]));
+	}
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template<class T, class Key>
+void insert_erase_benchmark(benchmark::State& state) {
+	std::vector<Key> keys = make_keys<Key>(state.range(0));
+	for (auto _ : state) {
+		T tree;
+		for (Key const& key : keys) {
+			tree.insert(key);
+		}
+		for (Key const& key : keys) {
+			tree.erase(key);
+		}
+		benchmark::DoNotOptimize(tree.count(keys[0]));
+	}
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template<class T, class Key>
+void contains_benchmark(benchmark::State& state) {
+	std::vector<Key> keys = make_keys<Key>(state.range(0));
+	T tree;
+	for (Key const& key : keys) {
+		tree.insert(key);
+	}
+
+	for (auto _ : state) {
+		std::size_t found = 0;
+		for (Key const& key : keys) {
+			found += tree.count(key);
+		}
+		benchmark::DoNotOptimize(found);
+	}
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+/**
+ * @brief Indices on [0, size) following a Zipf distribution with exponent s: the index i
+ * has a probability proportional to 1 / (i + 1)^s. s == 0 is the uniform distribution
+ */
+inline std::vector<std::size_t> zipf_indices(std::size_t size, double s, std::size_t count) {
+	std::vector<double> cdf(size);
+	double total = 0;
+	for (std::size_t i = 0; i < size; ++i) {
+		total += std::pow((double)(i + 1), -s);
+		cdf[i] = total;
+	}
+
+	std::mt19937 gen(42);
+	std::uniform_real_distribution<double> dist(0, total);
+	std::vector<std::size_t> indices;
+	indices.reserve(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		std::size_t index = std::lower_bound(cdf.begin(), cdf.end(), dist(gen)) - cdf.begin();
+		indices.push_back(std::min(index, size - 1));
+	}
+	return indices;
+}
+
+/**
+ * @brief Lookups with a Zipfian access pattern, with exponent range(1) / 100. The hot
+ * keys are random keys, not the smallest ones, so they are spread over the tree
+ */
+template<class T, class Key>
+void zipf_contains_benchmark(benchmark::State& state) {
+	std::vector<Key> keys = make_keys<Key>(state.range(0));
+	T tree;
+	for (Key const& key : keys) {
+		tree.insert(key);
+	}
+
+	std::vector<Key> queries;
+	for (std::size_t index : zipf_indices(keys.size(), state.range(1) / 100.0, 1 << 16)) {
+		queries.push_back(keys[index]);
+	}
+
+	for (auto _ : state) {
+		std::size_t found = 0;
+		for (Key const& key : queries) {
+			found += tree.count(key);
+		}
+		benchmark::DoNotOptimize(found);
+	}
+	state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+/**
+ * @brief Builds a tree from sorted keys, with one insert per key (range(1) == 0) or with
+ * the range constructor (range(1) == 1)
+ */
+template<class T, class Key>
+void sorted_build_benchmark(benchmark::State& state) {
+	std::vector<Key> keys = make_keys<Key>(state.range(0));
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+	for (auto _ : state) {
+		if (state.range(1) == 0) {
+			T tree;
+			for (Key const& key : keys) {
+				tree.insert(key);
+			}
+			benchmark::DoNotOptimize(tree.count(keys[0]));
+		}
+		else {
+			T tree(keys.begin(), keys.end());
+			benchmark::DoNotOptimize(tree.count(keys[0]));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+/**
+ * @brief Union of a tree of range(0) keys with a tree of range(1) keys, inserting the keys
+ * one by one (range(2) == 0), with union_with (range(2) == 1) or with union_with_parallel
+ * (range(2) == 2)
+ */
+template<class T>
+void union_benchmark(benchmark::State& state) {
+	std::vector<int> keys = make_keys<int>(state.range(0) + state.range(1));
+	T big(keys.begin(), keys.begin() + state.range(0));
+	T small(keys.begin() + state.range(0), keys.end());
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		T tree(big);
+		state.ResumeTiming();
+
+		if (state.range(2) == 0) {
+			for (int key : small) {
+				tree.insert(key);
+			}
+		}
+		else if (state.range(2) == 1) {
+			tree.union_with(small);
+		}
+		else {
+			tree.union_with_parallel(small);
+		}
+		benchmark::DoNotOptimize(tree.size());
+
+		state.PauseTiming();
+		tree = T();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+/**
+ * @brief Lookups of present keys (on random order), with the set built from the sorted keys
+ * by its range constructor
+ */
+template<class T, class Key>
+void lookup_benchmark(benchmark::State& state) {
+	std::vector<Key> keys = make_keys<Key>(state.range(0));
+	std::vector<Key> queries = keys;
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+	T set(keys.begin(), keys.end());
+
+	for (auto _ : state) {
+		std::size_t found = 0;
+		for (Key const& key : queries) {
+			found += set.count(key);
+		}
+		benchmark::DoNotOptimize(found);
+	}
+	state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+/**
+ * @brief Successor queries (upper_bound) of random keys, mostly not on the set, with the set
+ * built from the sorted keys by its range constructor
+ */
+template<class T, class Key>
+void successor_benchmark(benchmark::State& state) {
+	std::vector<Key> keys = make_keys<Key>(2 * state.range(0));
+	std::vector<Key> queries(keys.begin() + state.range(0), keys.end());
+	keys.resize(state.range(0));
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+	T set(keys.begin(), keys.end());
+
+	for (auto _ : state) {
+		std::size_t found = 0;
+		for (Key const& key : queries) {
+			found += set.upper_bound(key) != set.end();
+		}
+		benchmark::DoNotOptimize(found);
+	}
+	state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+/**
+ * @brief Lookups of present keys (on random order), one contains per key (range(1) == 0) or
+ * with contains_batch (range(1) == 1)
+ */
+template<class T, class Key>
+void contains_batch_benchmark(benchmark::State& state) {
+	std::vector<Key> keys = make_keys<Key>(state.range(0));
+	T tree(keys.begin(), keys.end());
+	std::vector<char> found(keys.size());
+
+	for (auto _ : state) {
+		if (state.range(1) == 0) {
+			for (std::size_t i = 0; i < keys.size(); ++i) {
+				found[i] = tree.contains(keys[i]);
+			}
+		}
+		else {
+			tree.contains_batch(keys.begin(), keys.end(), found.begin());
+		}
+		benchmark::DoNotOptimize(found.data());
+	}
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+/**
+ * @brief Keys of the trees shared by the threads of the concurrent benchmarks, the writer
+ * inserts and erases other keys
+ */
+inline std::vector<int> const& shared_keys() {
+	static std::vector<int> keys = make_keys<int>(1 << 16);
+	return keys;
+}
+
+/**
+ * @brief Lookups of threads 1.. on an AVLTree behind a mutex, while thread 0 inserts and
+ * erases keys
+ */
+inline void locked_read_benchmark(benchmark::State& state) {
+	static std::mutex mutex;
+	static AVLTree<int> tree(shared_keys().begin(), shared_keys().end());
+	std::vector<int> const& keys = shared_keys();
+
+	std::size_t i = 0;
+	for (auto _ : state) {
+		int key = keys[i++ % keys.size()];
+		std::lock_guard<std::mutex> lock(mutex);
+		if (state.thread_index() == 0) {
+			tree.insert(key + 1);
+			tree.erase(key + 1);
+		}
+		else {
+			benchmark::DoNotOptimize(tree.contains(key));
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Lookups of threads 1.. on snapshots of a ConcurrentAVLTree, while thread 0 inserts
+ * and erases keys
+ */
+inline void snapshot_read_benchmark(benchmark::State& state) {
+	static ConcurrentAVLTree<int> tree;
+	static std::once_flag built;
+	std::call_once(built, []() {
+		for (int key : shared_keys()) {
+			tree.insert(key);
+		}
+	});
+	std::vector<int> const& keys = shared_keys();
+	ConcurrentAVLTree<int>::Reader reader(tree);
+
+	std::size_t i = 0;
+	for (auto _ : state) {
+		int key = keys[i++ % keys.size()];
+		if (state.thread_index() == 0) {
+			tree.insert(key + 1);
+			tree.erase(key + 1);
+		}
+		else {
+			ConcurrentAVLTree<int>::Snapshot snapshot(reader);
+			benchmark::DoNotOptimize(snapshot.contains(key));
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Operation of the mixed workloads on keys of [0, 2^20): 80% lookups, 10% inserts
+ * and 10% erases
+ */
+enum class MixedOp { CONTAINS, INSERT, ERASE };
+
+inline MixedOp mixed_op(std::uint32_t random) {
+	std::uint32_t percent = (random >> 20) % 100;
+	if (percent < 80) return MixedOp::CONTAINS;
+	else if (percent < 90) return MixedOp::INSERT;
+	else return MixedOp::ERASE;
+}
+
+/**
+ * @brief Mixed workload of all the threads on a tree protected by a mutex
+ */
+template<class T>
+void locked_mixed_benchmark(benchmark::State& state) {
+	static std::mutex mutex;
+	static T tree;
+	static std::once_flag filled;
+	std::call_once(filled, []() {
+		for (int key = 0; key < (1 << 20); key += 2) tree.insert(key);
+	});
+	std::mt19937 gen(state.thread_index());
+
+	for (auto _ : state) {
+		std::uint32_t random = gen();
+		int key = random & ((1 << 20) - 1);
+		std::lock_guard<std::mutex> lock(mutex);
+		switch (mixed_op(random)) {
+			case MixedOp::CONTAINS: benchmark::DoNotOptimize(tree.contains(key)); break;
+			case MixedOp::INSERT: tree.insert(key); break;
+			case MixedOp::ERASE: tree.erase(key); break;
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Mixed workload of all the threads on a ConcurrentSkipList, each one with its
+ * own Handle
+ */
+inline void skiplist_mixed_benchmark(benchmark::State& state) {
+	static ConcurrentSkipList<int> list;
+	static std::once_flag filled;
+	std::call_once(filled, []() {
+		ConcurrentSkipList<int>::Handle handle(list);
+		for (int key = 0; key < (1 << 20); key += 2) handle.insert(key);
+	});
+	ConcurrentSkipList<int>::Handle handle(list);
+	std::mt19937 gen(state.thread_index());
+
+	for (auto _ : state) {
+		std::uint32_t random = gen();
+		int key = random & ((1 << 20) - 1);
+		switch (mixed_op(random)) {
+			case MixedOp::CONTAINS: benchmark::DoNotOptimize(handle.contains(key)); break;
+			case MixedOp::INSERT: handle.insert(key); break;
+			case MixedOp::ERASE: handle.erase(key); break;
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Random time ranges: starts are uniform on [0, 2^30) and lengths are up to 2^30 / n
+ * times 64, so every point is covered by about 32 ranges
+ */
+inline std::vector<Interval<int>> make_intervals(std::size_t n) {
+	std::mt19937 gen(1227992885);
+	int max_length = (int)((1u << 30) / n * 64);
+	std::vector<Interval<int>> intervals;
+	for (std::size_t i = 0; i < n; ++i) {
+		int lo = (int)(gen() >> 2);
+		intervals.push_back(Interval<int>(lo, lo + (int)(gen() % max_length)));
+	}
+	return intervals;
+}
+
+/**
+ * @brief Stabbing queries (ranges containing a point) scanning all the ranges, the baseline
+ * for interval_tree_benchmark
+ */
+inline void interval_scan_benchmark(benchmark::State& state) {
+	std::vector<Interval<int>> intervals = make_intervals(state.range(0));
+	std::mt19937 gen(42);
+
+	for (auto _ : state) {
+		int point = (int)(gen() >> 2);
+		std::size_t found = 0;
+		for (Interval<int> const& interval : intervals) {
+			if (interval.contains(point)) ++found;
+		}
+		benchmark::DoNotOptimize(found);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Stabbing queries on an IntervalTree
+ */
+inline void interval_tree_benchmark(benchmark::State& state) {
+	std::vector<Interval<int>> intervals = make_intervals(state.range(0));
+	IntervalTree<int> tree(intervals.begin(), intervals.end());
+	std::mt19937 gen(42);
+
+	for (auto _ : state) {
+		int point = (int)(gen() >> 2);
+		benchmark::DoNotOptimize(tree.count_overlapping(point, point));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
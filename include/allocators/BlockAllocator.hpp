@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstring>
+#include <memory>
 #include <limits>
 #include <cmath>
 
@@ -301,6 +302,15 @@ class BlockAllocator
         this->p_default();
     }
 
+    /**
+     * @brief Rebind constructor. Pools are never shared, so the new allocator starts empty.
+     * @tparam U Type of the other allocator
+     */
+    template<typename U>
+    BlockAllocator(BlockAllocator<U> const&){
+        this->p_default();
+    }
+
     BlockAllocator(BlockAllocator&& other){
         this->p_move(other);
     }
@@ -325,6 +335,16 @@ class BlockAllocator
         return *this;
     }
 
+    /**
+     * @brief Frees every block list at once. All the pointers returned by allocate(1)
+     * become invalid, so the owner must not use (nor deallocate) them anymore.
+     * Time complexity: O(number of block lists)
+     */
+    void release() {
+        this->p_delete();
+        this->available_blocks = LinkedVector();
+    }
+
     /**
      * @brief Allocates n * sizeof(T) bytes of uninitialized storage
      * @param n number of blocks
@@ -352,7 +372,21 @@ class BlockAllocator
             this->p_deallocate(p);
         }
         else{
-            ::delete(p);
+            ::operator delete(p);
         }
 	}
 };
+
+/**
+ * @brief Two BlockAllocators are equal only if they are the same pool, memory allocated
+ * by one of them can not be deallocated by other.
+ */
+template<typename T, typename U>
+bool operator==(BlockAllocator<T> const& lhs, BlockAllocator<U> const& rhs) {
+    return (void const*)&lhs == (void const*)&rhs;
+}
+
+template<typename T, typename U>
+bool operator!=(BlockAllocator<T> const& lhs, BlockAllocator<U> const& rhs) {
+    return !(lhs == rhs);
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+/**
+ * @brief EpochManager <br>
+ * Epoch-based memory reclamation. Readers pin the current epoch while they use shared
+ * memory, and the writer tags the memory it unlinks with the epoch of the moment. That
+ * memory can be freed once every pinned reader has an epoch greater than its tag. <br>
+ * Every reader thread owns a slot on its own cache line, so pinning and unpinning are a
+ * store on it and readers never write to shared cache lines. <br>
+ * Writer methods (epoch, advance) can be called by several threads at the same time, as
+ * long as every thread only frees the memory it tagged itself.
+ * @see Keir Fraser, Practical lock-freedom, 5.2.3
+ */
+class EpochManager {
+private:
+	static const std::size_t CACHE_LINE = 64;
+
+	struct Slot {
+		std::atomic<std::uint64_t> epoch; // 0 when not pinned
+		std::atomic<bool> used;
+	};
+
+	struct alignas(CACHE_LINE) PaddedSlot {
+		Slot slot;
+		char padding[CACHE_LINE - sizeof(Slot)];
+	};
+
+	std::atomic<std::uint64_t> global;
+
+	std::unique_ptr<unsigned char[]> storage;
+	PaddedSlot* slots;
+	std::size_t max_readers;
+
+public:
+	/**
+	 * @brief Construct a new EpochManager object
+	 * @param max_readers Maximum number of reader slots used at the same time
+	 */
+	explicit EpochManager(std::size_t max_readers = 128) : global(1), max_readers(max_readers) {
+		storage.reset(new unsigned char[(max_readers + 1) * sizeof(PaddedSlot)]);
+
+		// Slots must start on a cache line
+		std::uintptr_t address = reinterpret_cast<std::uintptr_t>(storage.get());
+		std::uintptr_t aligned = (address + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+		slots = reinterpret_cast<PaddedSlot*>(aligned);
+		for (std::size_t i = 0; i < max_readers; ++i) {
+			new (&slots[i]) PaddedSlot();
+			slots[i].slot.epoch.store(0);
+			slots[i].slot.used.store(false);
+		}
+	}
+
+	EpochManager(EpochManager const&) = delete;
+	EpochManager& operator=(EpochManager const&) = delete;
+
+	~EpochManager() {
+		for (std::size_t i = 0; i < max_readers; ++i) {
+			slots[i].~PaddedSlot();
+		}
+	}
+
+	/**
+	 * @brief Takes a free reader slot. Every reader thread takes one and uses it for all
+	 * its pins
+	 * Time complexity: O(max_readers)
+	 * @return std::size_t Index of the slot
+	 */
+	std::size_t acquire() {
+		for (std::size_t i = 0; i < max_readers; ++i) {
+			bool expected = false;
+			if (!slots[i].slot.used.load(std::memory_order_relaxed) &&
+				slots[i].slot.used.compare_exchange_strong(expected, true))
+			{
+				return i;
+			}
+		}
+		throw std::runtime_error("No free reader slot");
+	}
+
+	/**
+	 * @brief Gives back a slot, that must not be pinned
+	 * Time complexity: O(1)
+	 */
+	void release(std::size_t slot) {
+		slots[slot].slot.used.store(false, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Pins the current epoch on the slot. Shared memory read after this is not
+	 * freed until unpin
+	 * Time complexity: O(1)
+	 */
+	void pin(std::size_t slot) {
+		slots[slot].slot.epoch.store(global.load());
+	}
+
+	/**
+	 * @brief Time complexity: O(1)
+	 */
+	void unpin(std::size_t slot) {
+		slots[slot].slot.epoch.store(0, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Writer: current epoch. Memory unlinked (after publishing its replacement)
+	 * is tagged with it
+	 * Time complexity: O(1)
+	 */
+	std::uint64_t epoch() const {
+		return global.load();
+	}
+
+	/**
+	 * @brief Writer: starts a new epoch. A pin that this scan misses is stored after it,
+	 * so its reader cannot reach memory unlinked before the call
+	 * Time complexity: O(max_readers)
+	 * @return std::uint64_t Memory tagged with an epoch less than this can be freed
+	 */
+	std::uint64_t advance() {
+		std::uint64_t safe = global.fetch_add(1) + 1;
+		for (std::size_t i = 0; i < max_readers; ++i) {
+			std::uint64_t pinned = slots[i].slot.epoch.load();
+			if (pinned != 0 && pinned < safe) safe = pinned;
+		}
+		return safe;
+	}
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Detects if an allocator is a pool that can free all its memory at once,
+ * through a 'void release()' member. <br>
+ * Containers use it to skip the node by node teardown: if the keys do not need to be
+ * destroyed, releasing the whole pool costs O(chunks) instead of O(nodes). <br>
+ * The pool must only hold nodes of the container that releases it.
+ * @tparam Alloc Allocator type
+ */
+template<class Alloc>
+class pool_traits {
+	template<class A>
+	static auto p_test(int) -> decltype(std::declval<A&>().release(), std::true_type());
+
+	template<class A>
+	static std::false_type p_test(...);
+
+	static void p_release(Alloc& alloc, std::true_type) {
+		alloc.release();
+	}
+
+	static void p_release(Alloc&, std::false_type) {}
+
+public:
+	/**
+	 * @brief If Alloc has a 'release' member
+	 */
+	static constexpr bool can_release = decltype(p_test<Alloc>(0))::value;
+
+	/**
+	 * @brief Frees all the memory owned by the pool. Does nothing if 'can_release' is false
+	 * @param alloc Pool to release
+	 */
+	static void release(Alloc& alloc) {
+		p_release(alloc, std::integral_constant<bool, can_release>());
+	}
+};
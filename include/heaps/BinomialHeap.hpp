@@ -1,10 +1,17 @@
 #pragma once
 
 #include <cstddef>
+#include <algorithm>
 #include <functional>
+#include <limits>
 #include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "../allocators/BlockAllocator.hpp"
+#include "../allocators/PoolTraits.hpp"
 
 /**
  * @brief Heap
@@ -41,7 +48,7 @@ protected:
 		Node* child;
 	};
 	
-	using NodeAllocator = std::allocator<Node>;
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
 
 	using alloc_key_traits = std::allocator_traits<Allocator>;
 	using alloc_node_traits = std::allocator_traits<NodeAllocator>;
@@ -68,21 +75,65 @@ protected:
 		return node;
 	}
 
+	/**
+	 * @brief Deallocates a node, its childs and its siblings. <br>
+	 * It does not recurse: every time a node with childs is found, its first child is
+	 * moved in front of it, so the pending list always stays linked through 'sibling'. <br>
+	 * Time complexity: O(number of nodes)
+	 * @param root First node of the list to deallocate
+	 */
 	void p_delete(Node* root) {
-		if (root != nullptr) {
-			p_delete(root->child);
-			p_delete(root->sibling);
-			alloc_key_traits::destroy(alloc_key, &root->key);
-			alloc_node_traits::deallocate(alloc_node, root, 1);
+		while (root != nullptr) {
+			if (root->child != nullptr) {
+				Node* first = root->child;
+				root->child = first->sibling;
+				first->sibling = root;
+				root = first;
+			}
+			else {
+				Node* next = root->sibling;
+				alloc_key_traits::destroy(alloc_key, &root->key);
+				alloc_node_traits::deallocate(alloc_node, root, 1);
+				root = next;
+			}
 		}
 	}
 
+	/**
+	 * @brief Duplicates a list of trees, keeping the order of every list. <br>
+	 * It uses an explicit stack instead of recursion. <br>
+	 * Time complexity: O(number of nodes)
+	 * @param root First node of the list
+	 * @return Node* First node of the new list
+	 */
 	Node* p_copy(Node* root) {
-		if (root == nullptr) return nullptr;
-		Node* new_node = p_create(root->key); //copy key
-		new_node->child = p_copy(root->child);
-		new_node->sibling = p_copy(root->sibling);
-		return new_node;
+		Node* new_root = nullptr;
+
+		// (original first node, duplicate father) pairs of the lists left to copy
+		std::vector<std::pair<Node*, Node*>> pending;
+		pending.push_back(std::make_pair(root, (Node*)nullptr));
+
+		while (!pending.empty()) {
+			Node* orig = pending.back().first;
+			Node* father = pending.back().second;
+			pending.pop_back();
+
+			Node** slot = father == nullptr ? &new_root : &father->child;
+			for (Node* it = orig; it != nullptr; it = it->sibling) {
+				Node* dupl = p_create(it->key); //copy key
+				dupl->degree = it->degree;
+				dupl->father = father;
+
+				*slot = dupl;
+				slot = &dupl->sibling;
+
+				if (it->child != nullptr) {
+					pending.push_back(std::make_pair(it->child, dupl));
+				}
+			}
+		}
+
+		return new_root;
 	}
 
 	void p_default() {
@@ -95,16 +146,24 @@ protected:
 		this->p_default();
 		this->comparator = c;
 		this->alloc_key = alloc;
+		this->alloc_node = NodeAllocator(alloc);
 	}
 
 	void p_delete() {
-		this->p_delete(this->_root);
+		if (std::is_trivially_destructible<T>::value && pool_traits<NodeAllocator>::can_release) {
+			// Nothing to destroy, all the nodes are freed with the pool
+			pool_traits<NodeAllocator>::release(alloc_node);
+		}
+		else {
+			this->p_delete(this->_root);
+		}
 		this->p_default();
 	}
 
 	void p_copy(BinomialHeap const& other) {
 		this->comparator = other.comparator;
 		this->alloc_key = other.alloc_key;
+		this->alloc_node = alloc_node_traits::select_on_container_copy_construction(other.alloc_node);
 
 		this->_root = p_copy(other._root);
 		this->_size = other._size;
@@ -126,6 +185,7 @@ protected:
 	void p_swap(BinomialHeap& other) {
 		p_adl_swap(this->comparator, other.comparator);
 		p_adl_swap(this->alloc_key, other.alloc_key);
+		p_adl_swap(this->alloc_node, other.alloc_node);
 		p_adl_swap(this->_root, other._root);
 		p_adl_swap(this->_greater, other._greater);
 		p_adl_swap(this->_size, other._size);
@@ -181,22 +241,18 @@ protected:
 		return orig;
 	}
 
+	/**
+	 * @brief Converts 'child' to the first child of 'father'. The child lists are
+	 * kept on decreasing degree order.
+	 * Time complexity: O(1)
+	 * @param father New father
+	 * @param child New child
+	 */
 	void p_link(Node* father, Node* child) {
-		if (father->degree == 0) {
-			father->child = child;
-		}
-		else {
-			Node* origChild = father->child;
-
-			while (origChild->sibling != nullptr) {
-				origChild = origChild->sibling;
-			} // father->degree iterations
-
-			origChild->sibling = child;
-		}
-		++father->degree;
-		child->sibling = nullptr;
+		child->sibling = father->child;
 		child->father = father;
+		father->child = child;
+		++father->degree;
 	}
 
 	void p_update_greater() {
@@ -254,16 +310,45 @@ protected:
 		return head;
 	}
 
+	/**
+	 * @brief Inserts a new node. It is linked with the first roots while their degree
+	 * is the same (like the carry of a binary increment), so the root list is not
+	 * walked and the greater element is updated only with the resulting root.
+	 * Time complexity: O(log(this->size))
+	 * Amortized time complexity: O(1)
+	 */
 	template<class... Args>
 	void p_emplace(Args&&... args) {
 		Node* node = p_create(std::forward<Args>(args)...);
 
-		this->_root = p_union(this->_root, node);
-		this->p_update_greater();
+		while (this->_root != nullptr && this->_root->degree == node->degree) {
+			Node* root = this->_root;
+			this->_root = root->sibling;
+
+			if (comparator(root->key, node->key)) {
+				p_adl_swap(root, node); // node always wins
+			}
+			p_link(node, root);
+		}
+		node->sibling = this->_root;
+		this->_root = node;
+
+		// If the greater element has been linked, it is on the tree of node, so node is not less
+		if (this->_greater == nullptr || this->_greater->father != nullptr || comparator(node->key, this->_greater->key)) {
+			this->_greater = node;
+		}
 		++this->_size;
 	}
 
 	void p_merge(BinomialHeap& other){
+		if (!(this->alloc_node == other.alloc_node)) {
+			// The nodes can not change of allocator, so the elements are moved one by one
+			while (other._root != nullptr) {
+				this->p_emplace(other.p_pop());
+			}
+			return;
+		}
+
 		Node* this_root = this->_root;
 		Node* other_root = other._root;
 
@@ -274,6 +359,143 @@ protected:
 		other.p_default();
 	}
 
+	/**
+	 * @brief Inserts a tree on the degree table, linking it with the tree that has
+	 * the same degree as many times as needed (like the carry of a binary addition)
+	 * @param table Trees indexed by degree
+	 * @param tree Tree to insert. It must be a root
+	 */
+	void p_carry(Node** table, Node* tree) {
+		tree->sibling = nullptr;
+		while (table[tree->degree] != nullptr) {
+			Node* other = table[tree->degree];
+			table[tree->degree] = nullptr;
+
+			if (comparator(other->key, tree->key)) {
+				p_adl_swap(other, tree);
+			}
+			p_link(tree, other);
+		}
+		table[tree->degree] = tree;
+	}
+
+	/**
+	 * @brief Inserts all the roots of a list on the degree table
+	 * @param table Trees indexed by degree
+	 * @param list Root list
+	 */
+	void p_carry_list(Node** table, Node* list) {
+		while (list != nullptr) {
+			Node* next = list->sibling;
+			p_carry(table, list);
+			list = next;
+		}
+	}
+
+	/**
+	 * @brief Merge all the heaps of the range at once. Each root of each heap is
+	 * inserted on a degree table, so there is only one pass of links. <br>
+	 * Heaps that use a different node allocator give their elements one by one.
+	 */
+	template<class Iterator>
+	void p_meld_all(Iterator first, Iterator last) {
+		Node* table[std::numeric_limits<std::size_t>::digits] = {};
+
+		p_carry_list(table, this->_root);
+		for (; first != last; ++first) {
+			BinomialHeap& other = *first;
+			if (this->alloc_node == other.alloc_node) {
+				p_carry_list(table, other._root);
+				this->_size += other._size;
+				other.p_default();
+			}
+			else {
+				while (other._root != nullptr) {
+					p_carry(table, p_create(other.p_pop()));
+					++this->_size;
+				}
+			}
+		}
+
+		p_set_roots(table);
+	}
+
+	/**
+	 * @brief Rebuilds the root list, on increasing degree order, and the greater
+	 * element from a degree table
+	 * @param table Trees indexed by degree
+	 */
+	void p_set_roots(Node** table) {
+		this->_root = nullptr;
+		this->_greater = nullptr;
+		for (std::size_t d = std::numeric_limits<std::size_t>::digits; d-- > 0;) {
+			Node* tree = table[d];
+			if (tree == nullptr) continue;
+
+			tree->sibling = this->_root;
+			this->_root = tree;
+			if (this->_greater == nullptr || comparator(tree->key, this->_greater->key)) {
+				this->_greater = tree;
+			}
+		}
+	}
+
+	/**
+	 * @brief Inserts all the elements of the range. The new nodes are linked on a
+	 * degree table, so the forest is built like counting up to n in binary, and the
+	 * root list is rebuilt only once.
+	 * Time complexity: O(n + log(this->size))
+	 */
+	template<class Iterator>
+	void p_push_range(Iterator first, Iterator last) {
+		Node* table[std::numeric_limits<std::size_t>::digits] = {};
+
+		p_carry_list(table, this->_root);
+		for (; first != last; ++first) {
+			p_carry(table, p_create(*first));
+			++this->_size;
+		}
+		p_set_roots(table);
+	}
+
+	/**
+	 * @brief Merge all the heaps of the range with a tree reduction. On each level,
+	 * the merges of disjoint pairs are made by different threads.
+	 */
+	template<class RandomIterator>
+	void p_meld_all_parallel(RandomIterator first, RandomIterator last, std::size_t threads) {
+		std::vector<BinomialHeap*> heaps;
+		heaps.reserve(1 + (last - first));
+		heaps.push_back(this);
+		for (; first != last; ++first) {
+			heaps.push_back(&*first);
+		}
+
+		if (threads == 0) threads = 1;
+		for (std::size_t step = 1; step < heaps.size(); step *= 2) {
+			// Pairs (i, i + step), with i multiple of 2 * step
+			std::size_t pairs = (heaps.size() - step + 2 * step - 1) / (2 * step);
+			std::size_t workers = std::min(threads, pairs);
+
+			auto reduce = [&heaps, step, workers](std::size_t worker) {
+				for (std::size_t p = worker; p * 2 * step + step < heaps.size(); p += workers) {
+					std::size_t i = p * 2 * step;
+					heaps[i]->p_merge(*heaps[i + step]);
+				}
+			};
+
+			std::vector<std::thread> pool;
+			pool.reserve(workers - 1);
+			for (std::size_t w = 1; w < workers; ++w) {
+				pool.emplace_back(reduce, w);
+			}
+			reduce(0);
+			for (std::thread& t : pool) {
+				t.join();
+			}
+		}
+	}
+
 	T p_pop() {
 		Node* iter = this->_root;
 		Node* ant = nullptr;
@@ -287,17 +509,20 @@ protected:
 			ant->sibling = iter->sibling;
 		}
 
-		Node* firstChild = this->_greater->child;
-		if (firstChild != nullptr) {
-			while (firstChild->sibling != nullptr) {
-				firstChild->father = nullptr;
-				firstChild = firstChild->sibling;
-			}
-			firstChild = this->_greater->child;
+		// The children are on decreasing degree order, p_union needs them reversed
+		Node* firstChild = nullptr;
+		Node* child = this->_greater->child;
+		while (child != nullptr) {
+			Node* next = child->sibling;
+			child->father = nullptr;
+			child->sibling = firstChild;
+			firstChild = child;
+			child = next;
 		}
 		if (this->_root == this->_greater) this->_root = this->_root->sibling;
 		
 		T key = std::move(this->_greater->key);
+		alloc_key_traits::destroy(alloc_key, &this->_greater->key);
 		alloc_node_traits::deallocate(alloc_node, this->_greater, 1);
 
 		this->_root = p_union(this->_root, firstChild);
@@ -319,6 +544,20 @@ public:
 		this->p_new(c, alloc);
 	}
 
+	/**
+	 * @brief Construct a new Binomial Heap object with the elements of the range
+	 * Time complexity: O(n)
+	 * @param first Iterator to the first element
+	 * @param last Iterator past the last element
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	template<class Iterator>
+	BinomialHeap(Iterator first, Iterator last, Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_new(c, alloc);
+		this->p_push_range(first, last);
+	}
+
 	/**
 	 * @brief Construct a new Binomial Heap object by copy
 	 * Time complexity: O(other.size())
@@ -388,6 +627,7 @@ public:
 	/**
 	 * @brief Push 'elem' to the heap, copying it
 	 * Time complexity: O(log(this->size()) + copy)
+	 * Amortized time complexity: O(1 + copy)
 	 * @param key element to push
 	 */
 	void push(T const& key) {
@@ -397,6 +637,7 @@ public:
 	/**
 	 * @brief Push 'elem' to the heap, moving it
 	 * Time complexity: O(log(this->size()) + move)
+	 * Amortized time complexity: O(1 + move)
 	 * @param key element to push
 	 */
 	void push(T&& key) {
@@ -406,6 +647,7 @@ public:
 	/**
 	 * @brief Push 'elem' to the heap, creating it
 	 * Time complexity: O(log(this->size()) + creation)
+	 * Amortized time complexity: O(1 + creation)
 	 * @tparam Args List of types to the object constructor
 	 * @param args Parameters to the object constructor
 	 */
@@ -414,6 +656,17 @@ public:
 		this->p_emplace(std::forward<Args>(args)...);
 	}
 
+	/**
+	 * @brief Push all the elements of the range to the heap, copying them
+	 * Time complexity: O(n + log(this->size()))
+	 * @param first Iterator to the first element
+	 * @param last Iterator past the last element
+	 */
+	template<class Iterator>
+	void push_range(Iterator first, Iterator last) {
+		this->p_push_range(first, last);
+	}
+
 	/**
 	 * @brief Pop element from the heap
 	 * Time complexity: O(log(this->size))
@@ -424,14 +677,46 @@ public:
 	}
 
 	/**
-	 * @brief Merge two FibonacciHeaps. The other heap ys left on a default state.
-	 * Time complexity: O(1)
+	 * @brief Merge two BinomialHeaps. The other heap ys left on a default state.
+	 * Time complexity: O(log(this->size()) + log(other.size()))
+	 *  - O(other.size() * log(this->size())) if the node allocators are not equal
 	 * @param other 
 	 */
 	void merge(BinomialHeap& other) {
 		this->p_merge(other);
 	}
 
+	/**
+	 * @brief Merge all the heaps of the range into this one, with a single pass of
+	 * links. The other heaps are left on a default state. This heap must not be on
+	 * the range.
+	 * Time complexity: O(log(this->size()) + sum(log(other.size())))
+	 *  - O(other.size()) for each heap whose node allocator is not equal
+	 * @param first Iterator to the first heap
+	 * @param last Iterator past the last heap
+	 */
+	template<class Iterator>
+	void meld_all(Iterator first, Iterator last) {
+		this->p_meld_all(first, last);
+	}
+
+	/**
+	 * @brief Merge all the heaps of the range into this one, merging disjoint pairs
+	 * in parallel on each level of a tree reduction. The other heaps are left on a
+	 * default state. This heap must not be on the range, and the allocators and the
+	 * comparators must be usable from different threads.
+	 * Time complexity: O(sum(log(other.size())) / threads + log(count) * log(this->size()))
+	 * @param first Random access iterator to the first heap
+	 * @param last Random access iterator past the last heap
+	 * @param threads Maximum number of threads, defaults to the hardware concurrency
+	 */
+	template<class RandomIterator>
+	void meld_all_parallel(RandomIterator first, RandomIterator last,
+		std::size_t threads = std::thread::hardware_concurrency())
+	{
+		this->p_meld_all_parallel(first, last, threads);
+	}
+
 	/**
 	 * @brief Consult top element of the heap
 	 * Time complexity: O(1)
@@ -465,4 +750,4 @@ public:
 template<typename T, class C, class A>
 void swap(BinomialHeap<T, C, A>& lhs, BinomialHeap<T, C, A>& rhs) {
 	lhs.swap(rhs);
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,749 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief CompactFibonacciHeap <br>
+ * Same algorithm as FibonacciHeap, with a smaller node layout for big heaps of small keys:
+ * - Nodes live in a contiguous pool and are linked by 32-bit indices instead of pointers.
+ * - The mark and the degree are packed in one byte (the degree is always lower than 128,
+ *   the maximum degree of a heap with 2^32 elements is about 46).
+ *
+ * A node of a 4 or 8 byte key takes 24 or 32 bytes, instead of 48 or 56 bytes. <br>
+ * The handles returned by push / emplace are indices into the pool. They stay valid until
+ * the element is popped, even when the pool grows. <br>
+ * Element priority can be defined using the Comparator <br>
+ * Element allocations are made using the Allocator <br>
+ * @tparam T Elements' type this heap will store
+ * @tparam Comparator Comparator between keys
+ * @tparam Allocator Keys' allocator
+ */
+template <typename T, class Comparator = std::greater<T>, class Allocator = std::allocator<T>>
+class CompactFibonacciHeap
+{
+public:
+	using handle_type = std::uint32_t;
+
+protected:
+	/**
+	 * @brief Uses the first swap found by the ADL algorithm. <br>
+	 * This should find the user-defined swap before the generic std::swap, that makes
+	 * three moves
+	 * @tparam U Type
+	 * @param left Left object
+	 * @param right Right object
+	 */
+	template<typename U>
+	void p_adl_swap(U& left, U& right) {
+		using std::swap;
+		swap(left, right); // ADL swap
+	}
+
+	using index_type = std::uint32_t;
+
+	static const index_type NIL = std::numeric_limits<index_type>::max();
+
+	static const std::uint8_t MARK = 0x80; // Mark bit of 'degree_mark'
+	static const std::uint8_t DEGREE = 0x7F; // Degree bits of 'degree_mark'
+	static const std::uint8_t FREE = 0xFF; // 'degree_mark' of an unused slot of the pool
+	static const std::size_t MAX_DEGREE = 128;
+
+	/**
+	 * @brief Node of the heap. Free slots of the pool are chained through 'right'.
+	 */
+	struct Node {
+		T key;
+
+		index_type father;
+		index_type left;
+		index_type right;
+		index_type child;
+
+		std::uint8_t degree_mark;
+	};
+
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+
+	using alloc_key_traits = std::allocator_traits<Allocator>;
+	using alloc_node_traits = std::allocator_traits<NodeAllocator>;
+
+	NodeAllocator alloc_node;
+
+	Comparator comparator;
+	Allocator alloc_key;
+
+	Node* nodes;
+	index_type capacity;
+	index_type free_head;
+
+	index_type min;
+	std::size_t _size;
+
+	Node& p_node(index_type i) {
+		return this->nodes[i];
+	}
+
+	Node const& p_node(index_type i) const {
+		return this->nodes[i];
+	}
+
+	std::size_t p_degree(index_type i) const {
+		return p_node(i).degree_mark & DEGREE;
+	}
+
+	bool p_marked(index_type i) const {
+		return (p_node(i).degree_mark & MARK) != 0;
+	}
+
+	void p_set_mark(index_type i, bool mark) {
+		if (mark) p_node(i).degree_mark |= MARK;
+		else p_node(i).degree_mark &= DEGREE;
+	}
+
+	static index_type p_shift(index_type i, index_type offset) {
+		return i == NIL ? NIL : i + offset;
+	}
+
+	/**
+	 * @brief Moves a node to another slot, shifting all its links by 'offset'
+	 * @param from Origin slot, its key is destroyed
+	 * @param from_alloc Allocator of the origin key
+	 * @param to Destination slot, its key is constructed
+	 * @param offset Offset to add to the links
+	 */
+	void p_relocate(Node& from, Allocator& from_alloc, Node& to, index_type offset) {
+		if (from.degree_mark != FREE) {
+			alloc_key_traits::construct(alloc_key, &to.key, std::move(from.key));
+			alloc_key_traits::destroy(from_alloc, &from.key);
+		}
+		to.father = p_shift(from.father, offset);
+		to.left = p_shift(from.left, offset);
+		to.right = p_shift(from.right, offset);
+		to.child = p_shift(from.child, offset);
+		to.degree_mark = from.degree_mark;
+	}
+
+	/**
+	 * @brief Moves the pool to a new array, twice as big. Indices do not change. <br>
+	 * Time complexity: O(this->capacity)
+	 */
+	void p_grow() {
+		std::size_t new_capacity = this->capacity == 0 ? 16 : 2 * (std::size_t)this->capacity;
+		if (new_capacity > NIL) {
+			if (this->capacity == NIL) throw std::length_error("CompactFibonacciHeap is full");
+			new_capacity = NIL; // NIL itself is never a valid index
+		}
+
+		Node* new_nodes = alloc_node_traits::allocate(alloc_node, new_capacity);
+		for (index_type i = 0; i < this->capacity; ++i) {
+			p_relocate(this->nodes[i], alloc_key, new_nodes[i], 0);
+		}
+
+		// The pool only grows when there are no free slots
+		for (std::size_t i = this->capacity; i < new_capacity; ++i) {
+			new_nodes[i].degree_mark = FREE;
+			new_nodes[i].father = new_nodes[i].left = new_nodes[i].child = NIL;
+			new_nodes[i].right = i + 1 < new_capacity ? (index_type)(i + 1) : NIL;
+		}
+		this->free_head = this->capacity;
+
+		if (this->nodes != nullptr) {
+			alloc_node_traits::deallocate(alloc_node, this->nodes, this->capacity);
+		}
+		this->nodes = new_nodes;
+		this->capacity = (index_type)new_capacity;
+	}
+
+	/**
+	 * @brief Create an empy node constructing the element on it. <br>
+	 * The node is linked to itself, this makes easier future operations. <br>
+	 * Time complexity: O(object_creation), amortized
+	 * @tparam Args List of type params of the object constructor
+	 * @param args List of params of the object Constructor
+	 * @return index_type Created node
+	 */
+	template<class... Args>
+	index_type p_create(Args&&... args) {
+		if (this->free_head == NIL) p_grow();
+
+		index_type i = this->free_head;
+		Node& node = p_node(i);
+		this->free_head = node.right;
+
+		alloc_key_traits::construct(alloc_key, &node.key, std::forward<Args>(args)...);
+		node.degree_mark = 0;
+		node.father = node.child = NIL;
+		node.left = node.right = i;
+
+		return i;
+	}
+
+	/**
+	 * @brief Returns the slot of a node to the pool. The key must be destroyed.
+	 * @param i Node to free
+	 */
+	void p_free(index_type i) {
+		p_node(i).degree_mark = FREE;
+		p_node(i).right = this->free_head;
+		this->free_head = i;
+	}
+
+	void p_default() {
+		this->nodes = nullptr;
+		this->capacity = 0;
+		this->free_head = NIL;
+		this->min = NIL;
+		this->_size = 0;
+	}
+
+	void p_new(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_default();
+		this->comparator = c;
+		this->alloc_key = alloc;
+		this->alloc_node = NodeAllocator(alloc);
+	}
+
+	/**
+	 * @brief Destroys every key and deallocates the pool. <br>
+	 * Time complexity: O(1) if T is trivially destructible, O(this->capacity) otherwise
+	 */
+	void p_delete() {
+		if (!std::is_trivially_destructible<T>::value) {
+			for (index_type i = 0; i < this->capacity; ++i) {
+				if (this->nodes[i].degree_mark != FREE) {
+					alloc_key_traits::destroy(alloc_key, &this->nodes[i].key);
+				}
+			}
+		}
+		if (this->nodes != nullptr) {
+			alloc_node_traits::deallocate(alloc_node, this->nodes, this->capacity);
+		}
+		this->p_default();
+	}
+
+	/**
+	 * @brief Copies the whole pool, so the handles of 'other' are also valid on the copy. <br>
+	 * Time complexity: O(other.capacity)
+	 */
+	void p_copy(CompactFibonacciHeap const& other) {
+		this->comparator = other.comparator;
+		this->alloc_key = other.alloc_key;
+		this->alloc_node = alloc_node_traits::select_on_container_copy_construction(other.alloc_node);
+		this->p_default();
+
+		if (other.capacity == 0) return;
+
+		this->nodes = alloc_node_traits::allocate(alloc_node, other.capacity);
+		this->capacity = other.capacity;
+		for (index_type i = 0; i < other.capacity; ++i) {
+			Node const& from = other.nodes[i];
+			Node& to = this->nodes[i];
+			if (from.degree_mark != FREE) {
+				alloc_key_traits::construct(alloc_key, &to.key, from.key);
+			}
+			to.father = from.father;
+			to.left = from.left;
+			to.right = from.right;
+			to.child = from.child;
+			to.degree_mark = from.degree_mark;
+		}
+
+		this->free_head = other.free_head;
+		this->min = other.min;
+		this->_size = other._size;
+	}
+
+	void p_move(CompactFibonacciHeap& other) {
+		this->comparator = std::move(other.comparator);
+		this->alloc_key = std::move(other.alloc_key);
+		this->alloc_node = std::move(other.alloc_node);
+
+		this->nodes = other.nodes;
+		this->capacity = other.capacity;
+		this->free_head = other.free_head;
+		this->min = other.min;
+		this->_size = other._size;
+
+		other.p_default();
+	}
+
+	void p_swap(CompactFibonacciHeap& other) {
+		p_adl_swap(this->comparator, other.comparator);
+		p_adl_swap(this->alloc_key, other.alloc_key);
+		p_adl_swap(this->alloc_node, other.alloc_node);
+		p_adl_swap(this->nodes, other.nodes);
+		p_adl_swap(this->capacity, other.capacity);
+		p_adl_swap(this->free_head, other.free_head);
+		p_adl_swap(this->min, other.min);
+		p_adl_swap(this->_size, other._size);
+	}
+
+	/**
+	 * @brief Insert the node to the left of origin
+	 * @param toInsert Node to insert
+	 * @param origin Its new sibling
+	 */
+	void p_insertToLeft(index_type toInsert, index_type origin) {
+		index_type aux = p_node(origin).left;
+
+		p_node(origin).left = toInsert;
+		p_node(toInsert).right = origin;
+
+		p_node(toInsert).left = aux;
+		p_node(aux).right = toInsert;
+	}
+
+	/**
+	 * @brief Unlink a node from the list belongs <br>
+	 * The node is linked to itself
+	 * @param i The node to unlink
+	 */
+	void p_delFromList(index_type i) {
+		Node& node = p_node(i);
+		p_node(node.left).right = node.right;
+		p_node(node.right).left = node.left;
+
+		node.father = NIL;
+		node.left = node.right = i;
+	}
+
+	/**
+	 * @brief Converts 'y' to child of 'x'
+	 * @param x New father
+	 * @param y New child
+	 */
+	void p_link(index_type x, index_type y) {
+		p_node(y).father = x;
+		p_set_mark(y, false);
+
+		++p_node(x).degree_mark;
+
+		if (p_node(x).child == NIL) {
+			p_node(x).child = y;
+			p_node(y).left = p_node(y).right = y;
+		}
+		else {
+			p_insertToLeft(y, p_node(x).child);
+		}
+	}
+
+	/**
+	 * @brief Consolidate the heap
+	 * Time complexity: O(this->size)
+	 * Amortized time complexity: O(log(this->size))
+	 */
+	void p_consolidate() {
+		index_type a[MAX_DEGREE];
+		for (std::size_t d = 0; d < MAX_DEGREE; ++d) a[d] = NIL;
+
+		index_type next = this->min;
+		p_node(p_node(next).left).right = NIL;
+		while (next != NIL) {
+			index_type x = next;
+			next = p_node(next).right;
+
+			std::size_t d = p_degree(x);
+			p_node(x).left = p_node(x).right = x;
+			while (a[d] != NIL) {
+				index_type y = a[d];
+				if (comparator(p_node(y).key, p_node(x).key)) {
+					p_adl_swap(x, y);
+				}
+				p_link(x, y);
+
+				a[d] = NIL;
+				++d;
+			}
+			a[d] = x;
+		}
+
+		this->min = NIL;
+		for (std::size_t d = 0; d < MAX_DEGREE; ++d) {
+			if (a[d] == NIL) continue;
+
+			if (this->min == NIL) {
+				this->min = a[d];
+			}
+			else {
+				p_insertToLeft(a[d], this->min);
+				if (comparator(p_node(a[d]).key, p_node(this->min).key)) {
+					this->min = a[d];
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Unlinks x from y and moves it to the root list
+	 * @param x Child to unlink
+	 * @param y Father
+	 */
+	void p_cut(index_type x, index_type y) {
+		--p_node(y).degree_mark;
+
+		if (p_node(y).child == x) {
+			p_node(y).child = p_degree(y) == 0 ? NIL : p_node(x).left;
+		}
+
+		p_delFromList(x);
+		p_insertToLeft(x, this->min);
+		p_set_mark(x, false);
+	}
+
+	/**
+	 * @brief Cascade cut, going up while the nodes are marked
+	 * @param y Node to cut
+	 */
+	void p_cascadingCut(index_type y) {
+		while (p_marked(y)) {
+			index_type z = p_node(y).father;
+			p_cut(y, z);
+			y = z;
+		}
+		if (p_node(y).father != NIL) {
+			p_set_mark(y, true);
+		}
+	}
+
+	template<class... Args>
+	index_type p_emplace(Args&&... args) {
+		index_type i = p_create(std::forward<Args>(args)...);
+
+		if (this->min == NIL) {
+			this->min = i;
+		}
+		else {
+			p_insertToLeft(i, this->min);
+			if (comparator(p_node(i).key, p_node(this->min).key)) {
+				this->min = i;
+			}
+		}
+		++this->_size;
+
+		return i;
+	}
+
+	/**
+	 * @brief Moves all the nodes of 'other' to this pool and concatenates the root lists.
+	 * Time complexity: O(other.capacity)
+	 * @param other The other heap, it is left on a default state
+	 */
+	void p_union(CompactFibonacciHeap& other) {
+		if (other.min == NIL) return;
+
+		index_type offset = this->capacity;
+		std::size_t total = (std::size_t)this->capacity + other.capacity;
+		if (total >= NIL) throw std::length_error("CompactFibonacciHeap is full");
+
+		Node* new_nodes = alloc_node_traits::allocate(alloc_node, total);
+		for (index_type i = 0; i < this->capacity; ++i) {
+			p_relocate(this->nodes[i], alloc_key, new_nodes[i], 0);
+		}
+		for (index_type i = 0; i < other.capacity; ++i) {
+			p_relocate(other.nodes[i], other.alloc_key, new_nodes[offset + i], offset);
+		}
+
+		// The free slots of other go after the free slots of this heap
+		index_type other_free = p_shift(other.free_head, offset);
+		if (this->free_head == NIL) {
+			this->free_head = other_free;
+		}
+		else {
+			index_type last = this->free_head;
+			while (new_nodes[last].right != NIL) last = new_nodes[last].right;
+			new_nodes[last].right = other_free;
+		}
+
+		if (this->nodes != nullptr) {
+			alloc_node_traits::deallocate(alloc_node, this->nodes, this->capacity);
+		}
+		this->nodes = new_nodes;
+		this->capacity = (index_type)total;
+
+		index_type other_min = other.min + offset;
+		std::size_t other_size = other._size;
+		alloc_node_traits::deallocate(other.alloc_node, other.nodes, other.capacity); // keys already moved
+		other.p_default();
+
+		if (this->min == NIL) {
+			this->min = other_min;
+		}
+		else {
+			// Concatenate the two circular lists
+			index_type thisLast = p_node(this->min).left;
+			index_type otherLast = p_node(other_min).left;
+
+			p_node(thisLast).right = other_min;
+			p_node(other_min).left = thisLast;
+			p_node(otherLast).right = this->min;
+			p_node(this->min).left = otherLast;
+
+			if (comparator(p_node(other_min).key, p_node(this->min).key)) {
+				this->min = other_min;
+			}
+		}
+		this->_size += other_size;
+	}
+
+	/**
+	 * @brief Gives more priority to a key
+	 * Time complexity: O(log(this->size))
+	 * Amortized time complexity: O(1)
+	 * @param x Node to change
+	 * @param newKey New key
+	 */
+	void p_decreaseKey(index_type x, T const& newKey) {
+		if (comparator(p_node(x).key, newKey)) {
+			throw std::invalid_argument("New key has less priority than current key");
+		}
+
+		p_node(x).key = newKey;
+		index_type y = p_node(x).father;
+
+		if (y != NIL && comparator(p_node(x).key, p_node(y).key)) {
+			p_cut(x, y);
+			p_cascadingCut(y);
+		}
+
+		if (comparator(p_node(x).key, p_node(this->min).key)) {
+			this->min = x;
+		}
+	}
+
+	/**
+	 * @brief Deletes the greatest element on the heap
+	 * Time complexity: O(this->size)
+	 * Amortized time complexity: O(log(this->size))
+	 * @return T element
+	 */
+	T p_pop() {
+		index_type z = this->min;
+
+		index_type it = p_node(z).child;
+		for (std::size_t i = p_degree(z); i > 0; --i) {
+			index_type aux = it;
+			it = p_node(it).left;
+
+			p_insertToLeft(aux, z);
+			p_node(aux).father = NIL;
+			p_set_mark(aux, false);
+		}
+		p_node(z).child = NIL;
+
+		--this->_size;
+		if (p_node(z).left == z) {
+			this->min = NIL;
+		}
+		else {
+			this->min = p_node(z).right;
+			p_delFromList(z);
+			p_consolidate();
+		}
+
+		T key = std::move(p_node(z).key);
+		alloc_key_traits::destroy(alloc_key, &p_node(z).key);
+		p_free(z);
+		return key;
+	}
+
+public:
+	/**
+	 * @brief Construct a new Compact Fibonacci Heap object
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	CompactFibonacciHeap(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_new(c, alloc);
+	}
+
+	/**
+	 * @brief Construct a new Compact Fibonacci Heap object by copy
+	 * Time complexity: O(other.size())
+	 * @param other The other heap
+	 */
+	CompactFibonacciHeap(CompactFibonacciHeap const& other) {
+		this->p_copy(other);
+	}
+
+	/**
+	 * @brief Construct a new Compact Fibonacci Heap object by move
+	 * Time complexity: O(1)
+	 * @param other The other heap
+	 */
+	CompactFibonacciHeap(CompactFibonacciHeap&& other) noexcept {
+		this->p_move(other);
+	}
+
+	/**
+	 * @brief Destroy the Compact Fibonacci Heap object
+	 * Time complexity: O(1) if T is trivially destructible, O(this->size()) otherwise
+	 */
+	~CompactFibonacciHeap() {
+		this->p_delete();
+	}
+
+	/**
+	 * @brief Copy assignment operator
+	 * Time complexity: O(other.size() + this->size())
+	 * @param other The other heap to copy
+	 * @return CompactFibonacciHeap& Reference to *this
+	 */
+	CompactFibonacciHeap& operator=(CompactFibonacciHeap const& other) {
+		if (this != &other) {
+			this->p_delete();
+			this->p_copy(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Move assignment operator
+	 * Time complexity: O(this->size())
+	 * @param other The other heap to move
+	 * @return CompactFibonacciHeap& Reference to *this
+	 */
+	CompactFibonacciHeap& operator=(CompactFibonacciHeap&& other) noexcept {
+		if (this != &other) {
+			this->p_delete();
+			this->p_move(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Swap the two heaps
+	 * Time complexity: O(1)
+	 * @param other The other heap to swap with
+	 */
+	void swap(CompactFibonacciHeap& other) noexcept {
+		this->p_swap(other);
+	}
+
+	/**
+	 * @brief Push 'elem' to the heap, copying it
+	 * Time complexity: O(O(elem copy)), amortized
+	 * @param elem The elem to be pushed
+	 * @return handle_type Handle that can be used to decreaseKey
+	 */
+	handle_type push(T const& elem) {
+		return this->p_emplace(elem);
+	}
+
+	/**
+	 * @brief Push 'elem' to the heap, moving it
+	 * Time complexity: O(O(elem move)), amortized
+	 * @param elem lvalue reference to the elem to be pushed
+	 * @return handle_type Handle that can be used to decreaseKey
+	 */
+	handle_type push(T&& elem) {
+		return this->p_emplace(std::move(elem));
+	}
+
+	/**
+	 * @brief Construct element directly on the heap
+	 * Time complexity: O(O(elem creation)), amortized
+	 * @tparam Args Template parameter list, type parameters of the object constructor
+	 * @param args Parameters list of the object constructor
+	 * @return handle_type Handle that can be used to decreaseKey
+	 */
+	template<class... Args>
+	handle_type emplace(Args&&... args) {
+		return this->p_emplace(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Consult top element of the heap
+	 * Time complexity: O(1)
+	 * @return T const& Reference to the top element
+	 */
+	T const& top() const {
+		if (empty()) throw std::domain_error("Empty heap");
+		return p_node(this->min).key;
+	}
+
+	/**
+	 * @brief Pop element from the heap
+	 * Time complexity: O(this->size)
+	 * Amortized time complexity: O(log(this->size))
+	 * @return T Element popped
+	 */
+	T pop() {
+		if (empty()) throw std::domain_error("Empty heap");
+		return this->p_pop();
+	}
+
+	/**
+	 * @brief Merge two heaps. The other heap is left on a default state and its
+	 * handles are no longer valid.
+	 * Time complexity: O(this->capacity + other.capacity)
+	 * @param other The other heap
+	 */
+	void merge(CompactFibonacciHeap& other) {
+		this->p_union(other);
+	}
+
+	/**
+	 * @brief Gives more priority to a key (decrease-key on a min-heap).
+	 * Time complexity: O(log(this->size))
+	 * Amortized time complexity: O(1)
+	 * @param node Handle returned by push / emplace
+	 * @param newKey New key
+	 */
+	void decreaseKey(handle_type node, T const& newKey) {
+		this->p_decreaseKey(node, newKey);
+	}
+
+	/**
+	 * @brief Number of elements
+	 * Time complexity: O(1)
+	 * @return std::size_t Number of elements
+	 */
+	std::size_t size() const {
+		return this->_size;
+	}
+
+	/**
+	 * @brief If heap empty
+	 * Time complexity: O(1)
+	 * @return If heap empty
+	 */
+	bool empty() const {
+		return this->min == NIL;
+	}
+};
+
+template <typename T, class C, class A>
+const typename CompactFibonacciHeap<T, C, A>::index_type CompactFibonacciHeap<T, C, A>::NIL;
+
+template <typename T, class C, class A>
+const std::uint8_t CompactFibonacciHeap<T, C, A>::MARK;
+
+template <typename T, class C, class A>
+const std::uint8_t CompactFibonacciHeap<T, C, A>::DEGREE;
+
+template <typename T, class C, class A>
+const std::uint8_t CompactFibonacciHeap<T, C, A>::FREE;
+
+template <typename T, class C, class A>
+const std::size_t CompactFibonacciHeap<T, C, A>::MAX_DEGREE;
+
+/**
+ * @brief Swaps the two heaps
+ * Time complexity: O(1)
+ * This implementation is intended to be found by the ADL algorithm
+ * @tparam T Same as class documentation
+ * @tparam Comparator Same as class documentation
+ * @tparam Allocator Same as class documentation
+ * @param lhs Left heap
+ * @param rhs Right heap
+ */
+template<typename T, class C, class A>
+void swap(CompactFibonacciHeap<T, C, A>& lhs, CompactFibonacciHeap<T, C, A>& rhs) noexcept {
+	lhs.swap(rhs);
+}
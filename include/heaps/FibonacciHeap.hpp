@@ -1,17 +1,26 @@
 #pragma once
 
 #include <unordered_map>
+#include <algorithm>
 #include <stdexcept>
+#include <thread>
 #include <ostream>
 #include <string>
 #include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../allocators/PoolTraits.hpp"
 
 // FibonacciHeap
 // Una implementación de los montículos de Fibonacci
 // Manuel Velasco Suárez
 // Estructura de datos necesaria para la práctica de MARP
 // T: Tipo de la clave
-template <typename T, class Comparator = std::greater<T>, class Allocator = std::allocator<T>>
+// Eager: si es true, las raices del mismo grado se enlazan en cuanto aparecen (ver EagerFibonacciHeap)
+template <typename T, class Comparator = std::greater<T>, class Allocator = std::allocator<T>, bool Eager = false>
 class FibonacciHeap
 {
 protected:
@@ -44,7 +53,7 @@ protected:
 		Node* child;
 	};
 	
-	using NodeAllocator = std::allocator<Node>;
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
 
 	using alloc_key_traits = std::allocator_traits<Allocator>;
 	using alloc_node_traits = std::allocator_traits<NodeAllocator>;
@@ -57,6 +66,9 @@ protected:
 	Node* min;
 	std::size_t _size;
 
+	// Eager mode only: the root of each degree, there is at most one
+	std::vector<Node*> _roots;
+
 	/**
 	 * @brief Create an empy node constructing the element on it. <br>
 	 * The node is linked to itself, this makes easier future operations. <br>
@@ -79,86 +91,127 @@ protected:
 	}
 
 	/**
-	 * @brief Deallocates a node, its childs and its siblings.
+	 * @brief Deallocates a node, its childs and its siblings. <br>
+	 * It does not recurse: the circular list is broken and, every time a node with
+	 * childs is found, its child list is spliced in front of it. <br>
+	 * Time complexity: O(number of nodes)
 	 * @param node Node to deallocate
 	 */
 	void p_delete(Node* node){
-		if(node != nullptr){
-			Node* siblingLeft = node->siblingLeft;
-			siblingLeft->siblingRight = nullptr;
-
-			p_delete(node->child);
-			p_delete(node->siblingRight);
-
-			alloc_key_traits::destroy(alloc_key, &node->key);
-			alloc_node_traits::deallocate(alloc_node, node, 1);
+		if (node == nullptr) return;
+
+		node->siblingLeft->siblingRight = nullptr;
+		while (node != nullptr) {
+			if (node->child != nullptr) {
+				Node* first = node->child;
+				node->child = nullptr;
+				first->siblingLeft->siblingRight = node; // The last child goes before node
+				node = first;
+			}
+			else {
+				Node* next = node->siblingRight;
+				alloc_key_traits::destroy(alloc_key, &node->key);
+				alloc_node_traits::deallocate(alloc_node, node, 1);
+				node = next;
+			}
 		}
 	}
 
+	/**
+	 * @brief Duplicates a node (only its key and its fields, not its links)
+	 * @param node Node to duplicate
+	 * @param father Its new father
+	 * @return Node* New node, linked to itself
+	 */
+	Node* p_duplicate(Node* node, Node* father) {
+		Node* new_node = p_create(node->key); //copy key
+		new_node->mark = node->mark;
+		new_node->degree = node->degree;
+		new_node->father = father;
+		return new_node;
+	}
+
 	/**
 	 * @brief Duplicates the node and its childs, NOT ITS SIBLINGS <br>
+	 * It uses an explicit stack instead of recursion, and the order of every child
+	 * list is preserved.
+	 * Time complexity: O(number of nodes)
 	 * @param node Node to duplicate
-	 * @param father Its new father (it shouldnt be here...)
+	 * @param father Its new father
 	 * @return Node* New node
 	 */
 	Node* p_copy(Node* node, Node* father) {
 		if (node == nullptr) return nullptr;
 
-		Node* new_node = p_create(node->key); //copy key
-		new_node->mark = node->mark;
-		new_node->degree = node->degree;
-		new_node->father = father;
+		Node* new_node = p_duplicate(node, father);
+		std::vector<std::pair<Node*, Node*>> pending; // (original, duplicate)
+		pending.push_back(std::make_pair(node, new_node));
 
-		if(new_node->child == nullptr) new_node->child = nullptr; 
-		else { // Si tiene hijos
-			Node* firstChild = node->child; // Esto servira para saber cuando acabar el bucle
-			new_node->child = p_copy(firstChild, new_node); //Se duplica el primero y servira como "raiz"
+		while (!pending.empty()) {
+			Node* orig = pending.back().first;
+			Node* dupl = pending.back().second;
+			pending.pop_back();
 
-			Node* it = firstChild->siblingLeft; //Se visita el hermano izquierdo
-			while (it != firstChild) { //Si no hemos llegado al primero
-				Node* dupl = p_copy(it, new_node); //entonces se duplica
-				p_insertToLeft(dupl, new_node->child); //se inserta a la izquierda de la "raiz"
+			Node* firstChild = orig->child;
+			if (firstChild == nullptr) continue;
 
-				it = it->siblingLeft; // y se visita de nuevo al hermano izquierdo
-			}
+			Node* it = firstChild;
+			do {
+				Node* child = p_duplicate(it, dupl);
+				if (dupl->child == nullptr) dupl->child = child;
+				else p_insertToLeft(child, dupl->child); // at the end of the circular list
+
+				pending.push_back(std::make_pair(it, child));
+				it = it->siblingRight;
+			} while (it != firstChild);
 		}
 
-		// No se conserva el orden inicial, pero no es algo que nos importe
 		return new_node;
 	}
 
 	void p_default() {
 		this->min = nullptr;
 		this->_size = 0;
+		this->_roots.clear();
 	}
 
 	void p_new(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
 		this->p_default();
 		this->comparator = c;
 		this->alloc_key = alloc;
+		this->alloc_node = NodeAllocator(alloc);
 	}
 
 	void p_delete() {
-		this->p_delete(this->min);
+		if (std::is_trivially_destructible<T>::value && pool_traits<NodeAllocator>::can_release) {
+			// Nothing to destroy, all the nodes are freed with the pool
+			pool_traits<NodeAllocator>::release(alloc_node);
+		}
+		else {
+			this->p_delete(this->min);
+		}
 	}
 
 	void p_copy(FibonacciHeap const& other) noexcept {
 		this->comparator = other.comparator;
 		this->alloc_key = other.alloc_key;
+		this->alloc_node = alloc_node_traits::select_on_container_copy_construction(other.alloc_node);
 
 		if (other.min == nullptr) {
-			this->min = nullptr;
-			this->_size = 0;
+			this->p_default();
 		}
 		else {
+			this->_roots.assign(other._roots.size(), nullptr);
 			this->min = p_copy(other.min, nullptr);
+			if (Eager) this->_roots[this->min->degree] = this->min;
 
-			Node* it = other.min->siblingLeft;
+			Node* it = other.min->siblingRight;
 			while (it != other.min) {
 				Node* dupl = p_copy(it, nullptr);
 				p_insertToLeft(dupl, this->min);
+				if (Eager) this->_roots[dupl->degree] = dupl;
 
-				it = it->siblingLeft;
+				it = it->siblingRight;
 			}
 
 			this->_size = other._size;
@@ -172,6 +225,7 @@ protected:
 
 		this->min = other.min;
 		this->_size = other._size;
+		this->_roots = std::move(other._roots);
 
 		other.p_default();
 	}
@@ -234,6 +288,75 @@ protected:
 		}
 	}
 
+	/**
+	 * @brief Eager mode: inserts a root on the degree table, linking it with the root
+	 * of the same degree as many times as needed. The root list keeps at most one
+	 * root of each degree, so it never has more than O(log(this->size)) roots. <br>
+	 * If this->min loses a link, the winner (with an equal key) becomes this->min.
+	 * Time complexity: O(log(this->size))
+	 * Amortized time complexity: O(1)
+	 * @param x Root to insert, it must be on the root list
+	 */
+	void p_carry(Node* x) {
+		while (true) {
+			if (x->degree >= this->_roots.size()) {
+				this->_roots.resize(x->degree + 1, nullptr);
+			}
+
+			Node* y = this->_roots[x->degree];
+			if (y == nullptr) break;
+			this->_roots[x->degree] = nullptr;
+
+			if (comparator(y->key, x->key)) {
+				p_adl_swap(x, y); // x always wins
+			}
+			if (y == this->min) {
+				this->min = x;
+			}
+
+			p_delFromList(y);
+			p_link(x, y);
+		}
+		this->_roots[x->degree] = x;
+	}
+
+	/**
+	 * @brief Eager mode: moves every node of the circular list 'list' to the root
+	 * list, inserting them on the degree table
+	 * Time complexity: O(length(list) + log(this->size))
+	 * @param list Any node of the list
+	 */
+	void p_carry_list(Node* list) {
+		if (list == nullptr) return;
+
+		list->siblingLeft->siblingRight = nullptr;
+		while (list != nullptr) {
+			Node* x = list;
+			list = list->siblingRight;
+
+			x->father = nullptr;
+			x->mark = false;
+			x->siblingLeft = x->siblingRight = x;
+			if (this->min == nullptr) this->min = x;
+			else p_insertToLeft(x, this->min);
+
+			p_carry(x);
+		}
+	}
+
+	/**
+	 * @brief Eager mode: finds the new greatest root on the degree table
+	 * Time complexity: O(log(this->size))
+	 */
+	void p_update_min() {
+		this->min = nullptr;
+		for (Node* root : this->_roots) {
+			if (root != nullptr && (this->min == nullptr || comparator(root->key, this->min->key))) {
+				this->min = root;
+			}
+		}
+	}
+
 	/**
 	 * @brief Consolidate the heap
 	 * Time complexity: O(this->size)
@@ -320,6 +443,15 @@ protected:
 		p_delFromList(x); //Se elimina como hijo
 		p_insertToLeft(x, this->min); //Se inserta al lado del minimo, en la rootList
 		x->mark = false;
+
+		if (Eager) {
+			if (y->father == nullptr) {
+				// y is a root that has lost a child, it changes of slot on the degree table
+				this->_roots[y->degree + 1] = nullptr;
+				p_carry(y);
+			}
+			p_carry(x);
+		}
 	}
 
 	/**
@@ -370,9 +502,56 @@ protected:
 			++_size;
 		}
 
+		if (Eager) p_carry(newNode);
+
 		return newNode;
 	}
 
+	/**
+	 * @brief Inserts all the elements of the range. The new nodes are linked on a
+	 * degree table as they are created, so they arrive to the root list as
+	 * O(log(n)) binomial trees and the next pop does not consolidate n roots. <br>
+	 * The minimum is updated once per new tree.
+	 * Time complexity: O(n)
+	 */
+	template<class Iterator>
+	void p_push_range(Iterator first, Iterator last) {
+		if (Eager) {
+			for (; first != last; ++first) p_emplace(*first);
+			return;
+		}
+
+		Node* table[std::numeric_limits<std::size_t>::digits] = {};
+		for (; first != last; ++first) {
+			Node* x = p_create(*first);
+			while (table[x->degree] != nullptr) {
+				Node* y = table[x->degree];
+				table[x->degree] = nullptr;
+
+				if (comparator(y->key, x->key)) {
+					p_adl_swap(x, y); // x always wins
+				}
+				p_link(x, y);
+			}
+			table[x->degree] = x;
+			++this->_size;
+		}
+
+		for (Node* root : table) {
+			if (root == nullptr) continue;
+
+			if (this->min == nullptr) {
+				this->min = root;
+			}
+			else {
+				p_insertToLeft(root, this->min);
+				if (comparator(root->key, this->min->key)) {
+					this->min = root;
+				}
+			}
+		}
+	}
+
 	/**
 	 * @brief Merge two heaps. The other heap is left on a default state.
 	 * @param other The other heap to merge.
@@ -380,6 +559,36 @@ protected:
 	void p_union(FibonacciHeap& other) {
 		if (other.min == nullptr) return;
 
+		if (!(this->alloc_node == other.alloc_node)) {
+			// The nodes can not change of allocator, so the elements are moved one by one
+			while (other.min != nullptr) {
+				this->p_emplace(other.p_pop());
+			}
+			return;
+		}
+
+		if (Eager) {
+			// Every root of the other heap is inserted on the degree table
+			Node* otherMin = other.min;
+			this->_size += other._size;
+			other.p_default();
+
+			// otherMin may lose a link against a root with an equal key, so the
+			// minimum is searched again on the degree table
+			p_carry_list(otherMin);
+			p_update_min();
+			return;
+		}
+
+		if (this->min == nullptr) {
+			// Nothing to concatenate, this heap takes the root list of the other
+			this->min = other.min;
+			this->_size = other._size;
+			other.min = nullptr;
+			other._size = 0;
+			return;
+		}
+
 		/************ Concatenate ************/
 		this->_size += other._size;
 
@@ -408,6 +617,89 @@ protected:
 		other._size = 0;
 	}
 
+	/**
+	 * @brief Merge all the heaps of the range. Every root list is concatenated to
+	 * this one and the minimum is updated only once, at the end. <br>
+	 * Heaps that use a different node allocator give their elements one by one.
+	 */
+	template<class Iterator>
+	void p_meld_all(Iterator first, Iterator last) {
+		Node* best = this->min;
+		for (; first != last; ++first) {
+			FibonacciHeap& other = *first;
+			if (other.min == nullptr) continue;
+
+			if (Eager || !(this->alloc_node == other.alloc_node)) {
+				this->min = best;
+				this->p_union(other);
+				best = this->min;
+				continue;
+			}
+
+			if (best == nullptr) {
+				this->min = best = other.min;
+			}
+			else {
+				// Splice the other ring between this->min->siblingLeft and this->min
+				Node* otherFirst = other.min;
+				Node* otherLast = otherFirst->siblingLeft;
+				Node* preMin = this->min->siblingLeft;
+
+				preMin->siblingRight = otherFirst;
+				otherFirst->siblingLeft = preMin;
+				otherLast->siblingRight = this->min;
+				this->min->siblingLeft = otherLast;
+
+				if (comparator(other.min->key, best->key)) {
+					best = other.min;
+				}
+			}
+
+			this->_size += other._size;
+			other.min = nullptr;
+			other._size = 0;
+		}
+		this->min = best;
+	}
+
+	/**
+	 * @brief Merge all the heaps of the range with a tree reduction. On each level,
+	 * the merges of disjoint pairs are made by different threads.
+	 */
+	template<class RandomIterator>
+	void p_meld_all_parallel(RandomIterator first, RandomIterator last, std::size_t threads) {
+		std::vector<FibonacciHeap*> heaps;
+		heaps.reserve(1 + (last - first));
+		heaps.push_back(this);
+		for (; first != last; ++first) {
+			heaps.push_back(&*first);
+		}
+
+		if (threads == 0) threads = 1;
+		for (std::size_t step = 1; step < heaps.size(); step *= 2) {
+			// Pairs (i, i + step), with i multiple of 2 * step
+			std::size_t pairs = (heaps.size() - step + 2 * step - 1) / (2 * step);
+			std::size_t workers = std::min(threads, pairs);
+
+			auto reduce = [&heaps, step, workers](std::size_t worker) {
+				for (std::size_t p = worker; p * 2 * step + step < heaps.size(); p += workers) {
+					std::size_t i = p * 2 * step;
+					heaps[i]->p_union(*heaps[i + step]);
+				}
+			};
+
+			std::vector<std::thread> pool;
+			pool.reserve(workers - 1);
+			for (std::size_t w = 1; w < workers; ++w) {
+				pool.emplace_back(reduce, w);
+			}
+			reduce(0);
+			for (std::thread& t : pool) {
+				t.join();
+			}
+		}
+	}
+
 	/**
 	 * @brief Decrements a key.
 	 * Time complexity: O(log(this->size))
@@ -442,6 +734,8 @@ protected:
 	 * @return T element
 	 */
 	T p_pop() {
+		if (Eager) return p_pop_eager();
+
 		Node* z = this->min;
 		if (z != nullptr) {
 			std::size_t i = 0;
@@ -473,10 +767,39 @@ protected:
 		}
 
 		T key = std::move(z->key);
+		alloc_key_traits::destroy(alloc_key, &z->key);
 		alloc_node_traits::deallocate(alloc_node, z, 1); // Se elimina
 		return key; //Se devuelve la clave
 	}
 
+	/**
+	 * @brief Eager mode: deletes the greatest element on the heap. The children of
+	 * the root are inserted on the degree table, there is no consolidation pass.
+	 * Time complexity: O(log(this->size))
+	 * @return T element
+	 */
+	T p_pop_eager() {
+		Node* z = this->min;
+		this->_roots[z->degree] = nullptr;
+
+		if (z == z->siblingRight) {
+			this->min = nullptr;
+		}
+		else {
+			this->min = z->siblingRight; // Any root, p_update_min finds the greatest
+			p_delFromList(z);
+		}
+		--this->_size;
+
+		p_carry_list(z->child);
+		p_update_min();
+
+		T key = std::move(z->key);
+		alloc_key_traits::destroy(alloc_key, &z->key);
+		alloc_node_traits::deallocate(alloc_node, z, 1);
+		return key;
+	}
+
 public:
 	/**
 	 * @brief Construct a new Fibonacci Heap object
@@ -486,6 +809,20 @@ public:
 	FibonacciHeap(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
 		this->p_new(c, alloc);
 	}
+
+	/**
+	 * @brief Construct a new Fibonacci Heap object with the elements of the range
+	 * Time complexity: O(n)
+	 * @param first Iterator to the first element
+	 * @param last Iterator past the last element
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	template<class Iterator>
+	FibonacciHeap(Iterator first, Iterator last, Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_new(c, alloc);
+		this->p_push_range(first, last);
+	}
 	
 	/**
 	 * @brief Construct a new Fibonacci Heap object by copy
@@ -549,9 +886,11 @@ public:
 	inline void swap(FibonacciHeap& other) noexcept {
 		p_adl_swap(this->comparator, other.comparator);
 		p_adl_swap(this->alloc_key, other.alloc_key);
+		p_adl_swap(this->alloc_node, other.alloc_node);
 
 		p_adl_swap(_size, other._size);
 		p_adl_swap(min, other.min);
+		p_adl_swap(_roots, other._roots);
 	}
 
 	/**
@@ -584,6 +923,18 @@ public:
 		return this->p_emplace(std::forward<Args>(args)...);
 	}
 
+	/**
+	 * @brief Push all the elements of the range to the heap, copying them. They are
+	 * inserted already linked as binomial trees.
+	 * Time complexity: O(n)
+	 * @param first Iterator to the first element
+	 * @param last Iterator past the last element
+	 */
+	template<class Iterator>
+	void push_range(Iterator first, Iterator last) {
+		this->p_push_range(first, last);
+	}
+
 	/**
 	 * @brief Consult top element of the heap
 	 * Time complexity: O(1)
@@ -597,6 +948,7 @@ public:
 	/**
 	 * @brief Pop element from the heap
 	 * Time complexity: O(this->size)
+	 *  - O(log(this->size)) if Eager
 	 * Amortized time complexity: O(log(this->size))
 	 * @return T Element popped
 	 */
@@ -608,12 +960,45 @@ public:
 	/**
 	 * @brief Merge two FibonacciHeaps. The other heap ys left on a default state.
 	 * Time complexity: O(1)
+	 *  - O(log(this->size()) + log(other.size())) if Eager
+	 *  - O(other.size() * log(this->size())) if the node allocators are not equal
 	 * @param other 
 	 */
 	void merge(FibonacciHeap& other) {
 		this->p_union(other);
 	}
 
+	/**
+	 * @brief Merge all the heaps of the range into this one, concatenating all the
+	 * root lists in one pass. The other heaps are left on a default state. This heap
+	 * must not be on the range.
+	 * Time complexity: O(number of heaps)
+	 *  - O(other.size() * log(this->size())) for each heap whose node allocator is not equal
+	 * @param first Iterator to the first heap
+	 * @param last Iterator past the last heap
+	 */
+	template<class Iterator>
+	void meld_all(Iterator first, Iterator last) {
+		this->p_meld_all(first, last);
+	}
+
+	/**
+	 * @brief Merge all the heaps of the range into this one, merging disjoint pairs
+	 * in parallel on each level of a tree reduction. Only worth it when the node
+	 * allocators are not equal, otherwise each merge is O(1) and meld_all is faster.
+	 * The other heaps are left on a default state. This heap must not be on the range,
+	 * and the allocators and the comparators must be usable from different threads.
+	 * @param first Random access iterator to the first heap
+	 * @param last Random access iterator past the last heap
+	 * @param threads Maximum number of threads, defaults to the hardware concurrency
+	 */
+	template<class RandomIterator>
+	void meld_all_parallel(RandomIterator first, RandomIterator last,
+		std::size_t threads = std::thread::hardware_concurrency())
+	{
+		this->p_meld_all_parallel(first, last, threads);
+	}
+
 	/**
 	 * @brief Decrements a key.
 	 * Time complexity: O(log(this->size))
@@ -654,7 +1039,18 @@ public:
  * @param lhs Left heap
  * @param rhs Right heap
  */
-template<typename T, class C, class A>
-void swap(FibonacciHeap<T, C, A>& left, FibonacciHeap<T, C, A>& right) noexcept {
+template<typename T, class C, class A, bool E>
+void swap(FibonacciHeap<T, C, A, E>& left, FibonacciHeap<T, C, A, E>& right) noexcept {
 	left.swap(right);
 }
+
+/**
+ * @brief FibonacciHeap that links the roots of equal degree as soon as they appear
+ * (on push, pop, merge and the cuts of decreaseKey), instead of waiting for the pop
+ * consolidation. <br>
+ * The root list is never longer than O(log(size)), so no operation has an O(size)
+ * worst case, at the price of O(log(size)) pushes in the worst case (O(1) amortized). <br>
+ * top() is still O(1).
+ */
+template <typename T, class Comparator = std::greater<T>, class Allocator = std::allocator<T>>
+using EagerFibonacciHeap = FibonacciHeap<T, Comparator, Allocator, true>;
@@ -0,0 +1,550 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief PairingHeap <br>
+ * Self-adjusting heap with O(1) push, merge and decreaseKey, and O(log(n)) amortized pop.
+ * Each node only stores its key, its leftmost child, its right sibling and a back pointer
+ * (left sibling, or father for the leftmost child), so it is smaller than a FibonacciHeap
+ * node and pop does not need a consolidation table. <br>
+ * Element priority can be defined using the Comparator <br>
+ * Element allocations are made using the Allocator <br>
+ * @see https://en.wikipedia.org/wiki/Pairing_heap
+ * @tparam T Elements' type this heap will store
+ * @tparam Comparator Comparator between keys
+ * @tparam Allocator Keys' allocator
+ */
+template <typename T, class Comparator = std::greater<T>, class Allocator = std::allocator<T>>
+class PairingHeap
+{
+protected:
+	/**
+	 * @brief Uses the first swap found by the ADL algorithm. <br>
+	 * This should find the user-defined swap before the generic std::swap, that makes
+	 * three moves
+	 * @tparam U Type
+	 * @param left Left object
+	 * @param right Right object
+	 */
+	template<typename U>
+	void p_adl_swap(U& left, U& right) {
+		using std::swap;
+		swap(left, right); // ADL swap
+	}
+
+	/**
+	 * @brief This struct contains all what is needed to represent a node in this
+	 * PairingHeap. 'prev' points to the left sibling, or to the father if the node
+	 * is the leftmost child. Roots have a null 'prev'.
+	 */
+	struct Node {
+		T key;
+
+		Node* child;
+		Node* sibling;
+		Node* prev;
+	};
+
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+
+	using alloc_key_traits = std::allocator_traits<Allocator>;
+	using alloc_node_traits = std::allocator_traits<NodeAllocator>;
+
+	NodeAllocator alloc_node;
+
+	Comparator comparator;
+	Allocator alloc_key;
+
+	Node* _root;
+	std::size_t _size;
+
+	/**
+	 * @brief Create a detached node constructing the element on it. <br>
+	 * Time complexity: O(object_creation)
+	 * @tparam Args List of type params of the object constructor
+	 * @param args List of params of the object Constructor
+	 * @return Node* Created node
+	 */
+	template<class... Args>
+	Node* p_create(Args&&... args) {
+		Node* node = alloc_node_traits::allocate(alloc_node, 1);
+		alloc_key_traits::construct(alloc_key, &node->key, std::forward<Args>(args)...);
+
+		node->child = nullptr;
+		node->sibling = nullptr;
+		node->prev = nullptr;
+
+		return node;
+	}
+
+	/**
+	 * @brief Destroys the key and deallocates the node
+	 * @param node Node to destroy
+	 */
+	void p_destroy(Node* node) {
+		alloc_key_traits::destroy(alloc_key, &node->key);
+		alloc_node_traits::deallocate(alloc_node, node, 1);
+	}
+
+	/**
+	 * @brief Deallocates a node, its childs and its right siblings. <br>
+	 * It does not recurse: every time a node with childs is found, its first child is
+	 * moved in front of it, so the pending list always stays linked through 'sibling'. <br>
+	 * Time complexity: O(number of nodes)
+	 * @param node First node of the list to deallocate
+	 */
+	void p_delete(Node* node) {
+		while (node != nullptr) {
+			if (node->child != nullptr) {
+				Node* first = node->child;
+				node->child = first->sibling;
+				first->sibling = node;
+				node = first;
+			}
+			else {
+				Node* next = node->sibling;
+				p_destroy(node);
+				node = next;
+			}
+		}
+	}
+
+	/**
+	 * @brief Duplicates a tree (the node and its childs, NOT ITS SIBLINGS). <br>
+	 * The order of every child list is preserved. It uses an explicit stack instead of
+	 * recursion, so deep trees do not overflow the call stack. <br>
+	 * Time complexity: O(number of nodes)
+	 * @param root Root of the tree to duplicate
+	 * @return Node* Root of the new tree
+	 */
+	Node* p_copy(Node* root) {
+		if (root == nullptr) return nullptr;
+
+		Node* new_root = p_create(root->key);
+		std::vector<std::pair<Node*, Node*>> pending; // (original, duplicate)
+		pending.push_back(std::make_pair(root, new_root));
+
+		while (!pending.empty()) {
+			Node* orig = pending.back().first;
+			Node* dupl = pending.back().second;
+			pending.pop_back();
+
+			Node* last = nullptr;
+			for (Node* it = orig->child; it != nullptr; it = it->sibling) {
+				Node* child = p_create(it->key);
+				if (last == nullptr) {
+					dupl->child = child;
+					child->prev = dupl;
+				}
+				else {
+					last->sibling = child;
+					child->prev = last;
+				}
+				last = child;
+				pending.push_back(std::make_pair(it, child));
+			}
+		}
+
+		return new_root;
+	}
+
+	void p_default() {
+		this->_root = nullptr;
+		this->_size = 0;
+	}
+
+	void p_new(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_default();
+		this->comparator = c;
+		this->alloc_key = alloc;
+		this->alloc_node = NodeAllocator(alloc);
+	}
+
+	void p_delete() {
+		this->p_delete(this->_root);
+		this->p_default();
+	}
+
+	void p_copy(PairingHeap const& other) {
+		this->comparator = other.comparator;
+		this->alloc_key = other.alloc_key;
+		this->alloc_node = alloc_node_traits::select_on_container_copy_construction(other.alloc_node);
+
+		this->_root = p_copy(other._root);
+		this->_size = other._size;
+	}
+
+	void p_move(PairingHeap& other) {
+		this->comparator = std::move(other.comparator);
+		this->alloc_key = std::move(other.alloc_key);
+		this->alloc_node = std::move(other.alloc_node);
+
+		this->_root = other._root;
+		this->_size = other._size;
+
+		other.p_default();
+	}
+
+	void p_swap(PairingHeap& other) {
+		p_adl_swap(this->comparator, other.comparator);
+		p_adl_swap(this->alloc_key, other.alloc_key);
+		p_adl_swap(this->alloc_node, other.alloc_node);
+		p_adl_swap(this->_root, other._root);
+		p_adl_swap(this->_size, other._size);
+	}
+
+	/**
+	 * @brief Links two roots. The one with less priority becomes the leftmost
+	 * child of the other one. <br>
+	 * Both nodes must be detached (no siblings, no prev). <br>
+	 * Time complexity: O(1)
+	 * @param a First root
+	 * @param b Second root
+	 * @return Node* The new root
+	 */
+	Node* p_link(Node* a, Node* b) {
+		if (comparator(b->key, a->key)) {
+			p_adl_swap(a, b);
+		}
+
+		b->sibling = a->child;
+		if (a->child != nullptr) {
+			a->child->prev = b;
+		}
+		b->prev = a;
+		a->child = b;
+
+		return a;
+	}
+
+	/**
+	 * @brief Two-pass pairing of a sibling list. <br>
+	 * The first pass links the trees by pairs from left to right, the second one links
+	 * the results from right to left. Both passes are iterative. <br>
+	 * Time complexity: O(length of the list)
+	 * @param first First node of the list
+	 * @return Node* Root of the resulting tree
+	 */
+	Node* p_combine_siblings(Node* first) {
+		if (first == nullptr) return nullptr;
+
+		// First pass: the results are chained in reverse order through 'sibling'
+		Node* pairs = nullptr;
+		while (first != nullptr) {
+			Node* a = first;
+			Node* b = a->sibling;
+			a->sibling = nullptr;
+			a->prev = nullptr;
+
+			if (b == nullptr) {
+				first = nullptr;
+			}
+			else {
+				first = b->sibling;
+				b->sibling = nullptr;
+				b->prev = nullptr;
+				a = p_link(a, b);
+			}
+
+			a->sibling = pairs;
+			pairs = a;
+		}
+
+		// Second pass: right to left
+		Node* result = pairs;
+		pairs = pairs->sibling;
+		result->sibling = nullptr;
+		while (pairs != nullptr) {
+			Node* next = pairs->sibling;
+			pairs->sibling = nullptr;
+			result = p_link(result, pairs);
+			pairs = next;
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief Unlinks 'node' (and its subtree) from its father. 'node' must not be the root.
+	 * @param node Node to cut
+	 */
+	void p_cut(Node* node) {
+		if (node->prev->child == node) {
+			node->prev->child = node->sibling;
+		}
+		else {
+			node->prev->sibling = node->sibling;
+		}
+
+		if (node->sibling != nullptr) {
+			node->sibling->prev = node->prev;
+		}
+
+		node->sibling = nullptr;
+		node->prev = nullptr;
+	}
+
+	/**
+	 * @brief Inserts a new element on the heap, constructing it. <br>
+	 * Returns the node associated to the new element. Its a valid node that can be used
+	 * to call 'decreaseKey'. <br>
+	 * Time complexity: O(1)
+	 * @tparam Args List of type params of the object constructor
+	 * @param args List of params of the object Constructor
+	 * @return Node* Created node
+	 */
+	template<class... Args>
+	Node* p_emplace(Args&&... args) {
+		Node* node = p_create(std::forward<Args>(args)...);
+
+		if (this->_root == nullptr) this->_root = node;
+		else this->_root = p_link(this->_root, node);
+
+		++this->_size;
+		return node;
+	}
+
+	/**
+	 * @brief Merge two heaps. The other heap is left on a default state.
+	 * @param other The other heap to merge.
+	 */
+	void p_merge(PairingHeap& other) {
+		if (other._root == nullptr) return;
+
+		if (!(this->alloc_node == other.alloc_node)) {
+			// The nodes can not change of allocator, so the elements are moved one by one
+			while (other._root != nullptr) {
+				this->p_emplace(other.p_pop());
+			}
+			return;
+		}
+
+		if (this->_root == nullptr) this->_root = other._root;
+		else this->_root = p_link(this->_root, other._root);
+
+		this->_size += other._size;
+		other.p_default();
+	}
+
+	/**
+	 * @brief Gives more priority to a key.
+	 * Time complexity: O(1)
+	 * @param x Node to change
+	 * @param newKey New key, it can not have less priority than the current one
+	 */
+	void p_decreaseKey(Node* x, T const& newKey) {
+		if (comparator(x->key, newKey)) {
+			throw std::invalid_argument("New key has less priority than current key");
+		}
+
+		x->key = newKey;
+		if (x != this->_root) {
+			p_cut(x);
+			this->_root = p_link(this->_root, x);
+		}
+	}
+
+	/**
+	 * @brief Deletes the greatest element on the heap
+	 * Time complexity: O(this->size)
+	 * Amortized time complexity: O(log(this->size))
+	 * @return T element
+	 */
+	T p_pop() {
+		Node* root = this->_root;
+
+		T key = std::move(root->key);
+		this->_root = p_combine_siblings(root->child);
+		p_destroy(root);
+		--this->_size;
+
+		return key;
+	}
+
+public:
+	/**
+	 * @brief Construct a new Pairing Heap object
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	PairingHeap(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_new(c, alloc);
+	}
+
+	/**
+	 * @brief Construct a new Pairing Heap object by copy
+	 * Time complexity: O(other.size())
+	 * @param other The other heap
+	 */
+	PairingHeap(PairingHeap const& other) {
+		this->p_copy(other);
+	}
+
+	/**
+	 * @brief Construct a new Pairing Heap object by move
+	 * Time complexity: O(1)
+	 * @param other The other heap
+	 */
+	PairingHeap(PairingHeap&& other) noexcept {
+		this->p_move(other);
+	}
+
+	/**
+	 * @brief Destroy the Pairing Heap object
+	 * Time complexity: O(this->size())
+	 */
+	~PairingHeap() {
+		this->p_delete();
+	}
+
+	/**
+	 * @brief Copy assignment operator
+	 * Time complexity: O(other.size() + this->size())
+	 *  - Because delete operator costs O(n)
+	 * @param other The other heap to copy
+	 * @return PairingHeap& Reference to *this
+	 */
+	PairingHeap& operator=(PairingHeap const& other) {
+		if (this != &other) {
+			this->p_delete();
+			this->p_copy(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Move assignment operator
+	 * Time complexity: O(this->size())
+	 *  - Because delete operator costs O(n)
+	 * @param other The other heap to move
+	 * @return PairingHeap& Reference to *this
+	 */
+	PairingHeap& operator=(PairingHeap&& other) noexcept {
+		if (this != &other) {
+			this->p_delete();
+			this->p_move(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Swap the two heaps
+	 * Time complexity: O(1)
+	 * @param other The other heap to swap with
+	 */
+	void swap(PairingHeap& other) {
+		this->p_swap(other);
+	}
+
+	/**
+	 * @brief Push 'elem' to the heap, copying it
+	 * Time complexity: O(O(elem copy))
+	 * @param elem The elem to be pushed
+	 * @return void* Pointer that can be used to decreaseKey
+	 */
+	void* push(T const& elem) {
+		return this->p_emplace(elem);
+	}
+
+	/**
+	 * @brief Push 'elem' to the heap, moving it
+	 * Time complexity: O(O(elem move))
+	 * @param elem lvalue reference to the elem to be pushed
+	 * @return void* Pointer that can be used to decreaseKey
+	 */
+	void* push(T&& elem) {
+		return this->p_emplace(std::move(elem));
+	}
+
+	/**
+	 * @brief Construct element directly on the heap
+	 * Time complexity: O(O(elem creation))
+	 * @tparam Args Template parameter list, type parameters of the object constructor
+	 * @param args Parameters list of the object constructor
+	 * @return void* Pointer that can be used to decreaseKey
+	 */
+	template<class... Args>
+	void* emplace(Args&&... args) {
+		return this->p_emplace(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Consult top element of the heap
+	 * Time complexity: O(1)
+	 * @return T const& Reference to the top element
+	 */
+	T const& top() const {
+		if (empty()) throw std::domain_error("Empty heap");
+		return this->_root->key;
+	}
+
+	/**
+	 * @brief Pop element from the heap
+	 * Time complexity: O(this->size)
+	 * Amortized time complexity: O(log(this->size))
+	 * @return T Element popped
+	 */
+	T pop() {
+		if (empty()) throw std::domain_error("Empty heap");
+		return this->p_pop();
+	}
+
+	/**
+	 * @brief Merge two PairingHeaps. The other heap is left on a default state.
+	 * Time complexity: O(1)
+	 *  - O(other.size() * log(other.size())) if the node allocators are not equal
+	 * @param other The other heap
+	 */
+	void merge(PairingHeap& other) {
+		this->p_merge(other);
+	}
+
+	/**
+	 * @brief Gives more priority to a key (decrease-key on a min-heap).
+	 * Time complexity: O(1)
+	 * Amortized time complexity: O(log(this->size)) (it makes the next pop more expensive)
+	 * @param node Node pointer returned by push / emplace
+	 * @param newKey New key
+	 */
+	void decreaseKey(void* node, T const& newKey) {
+		this->p_decreaseKey((Node*)node, newKey);
+	}
+
+	/**
+	 * @brief Number of elements
+	 * Time complexity: O(1)
+	 * @return std::size_t Number of elements
+	 */
+	std::size_t size() const {
+		return this->_size;
+	}
+
+	/**
+	 * @brief If heap empty
+	 * Time complexity: O(1)
+	 * @return If heap empty
+	 */
+	bool empty() const {
+		return this->_root == nullptr;
+	}
+};
+
+/**
+ * @brief Swaps the two heaps
+ * Time complexity: O(1)
+ * This implementation is intended to be found by the ADL algorithm
+ * @tparam T Same as class documentation
+ * @tparam Comparator Same as class documentation
+ * @tparam Allocator Same as class documentation
+ * @param lhs Left heap
+ * @param rhs Right heap
+ */
+template<typename T, class C, class A>
+void swap(PairingHeap<T, C, A>& lhs, PairingHeap<T, C, A>& rhs) {
+	lhs.swap(rhs);
+}
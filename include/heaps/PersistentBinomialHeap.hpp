@@ -0,0 +1,364 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @brief PersistentBinomialHeap <br>
+ * Binomial heap whose nodes are immutable and shared between versions. Copying a heap
+ * is O(1) (it is a fork: both heaps share all their nodes) and push, pop and merge only
+ * allocate O(log(n)) new nodes, leaving the other versions untouched. <br>
+ * Nodes are reference counted (std::shared_ptr), so they are freed when the last version
+ * that uses them is destroyed. Different versions can be used from different threads. <br>
+ * Links copy the key of the winner, so T must be copy constructible. <br>
+ * Element priority can be defined using the Comparator <br>
+ * Element allocations are made using the Allocator, through std::allocate_shared. Its
+ * copies must be able to deallocate the memory allocated by each other. <br>
+ * @see https://en.wikipedia.org/wiki/Binomial_heap
+ * @see Chris Okasaki, Purely Functional Data Structures, 3.2
+ * @tparam T Elements' type this heap will store
+ * @tparam Comparator Comparator between keys
+ * @tparam Allocator Keys' allocator
+ */
+template <typename T, class Comparator = std::greater<T>, class Allocator = std::allocator<T>>
+class PersistentBinomialHeap
+{
+protected:
+	/**
+	 * @brief Uses the first swap found by the ADL algorithm. <br>
+	 * This should find the user-defined swap before the generic std::swap, that makes
+	 * three moves
+	 * @tparam U Type
+	 * @param left Left object
+	 * @param right Right object
+	 */
+	template<typename U>
+	void p_adl_swap(U& left, U& right) {
+		using std::swap;
+		swap(left, right); // ADL swap
+	}
+
+	struct Tree;
+	struct Cell;
+
+	using TreePtr = std::shared_ptr<const Tree>;
+	using ListPtr = std::shared_ptr<const Cell>;
+
+	/**
+	 * @brief Binomial tree. Its children are on decreasing degree order.
+	 */
+	struct Tree {
+		T key;
+		int degree;
+		ListPtr children;
+
+		template<class... Args>
+		Tree(int degree, ListPtr const& children, Args&&... args) :
+			key(std::forward<Args>(args)...), degree(degree), children(children) {}
+	};
+
+	/**
+	 * @brief Cell of an immutable list of trees
+	 */
+	struct Cell {
+		TreePtr tree;
+		ListPtr next;
+
+		Cell(TreePtr const& tree, ListPtr const& next) : tree(tree), next(next) {}
+	};
+
+	Comparator comparator;
+	Allocator alloc;
+
+	ListPtr _roots; // On increasing degree order
+	TreePtr _greater;
+	std::size_t _size;
+
+	void p_default() {
+		this->_roots = nullptr;
+		this->_greater = nullptr;
+		this->_size = 0;
+	}
+
+	void p_new(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_default();
+		this->comparator = c;
+		this->alloc = alloc;
+	}
+
+	void p_copy(PersistentBinomialHeap const& other) {
+		this->comparator = other.comparator;
+		this->alloc = other.alloc;
+		this->_roots = other._roots;
+		this->_greater = other._greater;
+		this->_size = other._size;
+	}
+
+	void p_move(PersistentBinomialHeap& other) {
+		this->comparator = std::move(other.comparator);
+		this->alloc = std::move(other.alloc);
+		this->_roots = std::move(other._roots);
+		this->_greater = std::move(other._greater);
+		this->_size = other._size;
+
+		other.p_default();
+	}
+
+	ListPtr p_cons(TreePtr const& tree, ListPtr const& next) {
+		return std::allocate_shared<Cell>(alloc, tree, next);
+	}
+
+	/**
+	 * @brief Links two trees of the same degree. The result is a new tree with the
+	 * key of the winner, and the loser as its first child.
+	 * Time complexity: O(1)
+	 */
+	TreePtr p_link(TreePtr const& a, TreePtr const& b) {
+		if (comparator(b->key, a->key)) {
+			return std::allocate_shared<Tree>(alloc, b->degree + 1, p_cons(a, b->children), b->key);
+		}
+		else {
+			return std::allocate_shared<Tree>(alloc, a->degree + 1, p_cons(b, a->children), a->key);
+		}
+	}
+
+	/**
+	 * @brief Inserts a tree on a root list. The degree of the tree can not be greater
+	 * than the degree of the first root.
+	 * Time complexity: O(log(this->size))
+	 * @return ListPtr New root list, that shares its tail with 'list'
+	 */
+	ListPtr p_insert_tree(TreePtr tree, ListPtr list) {
+		while (list != nullptr && list->tree->degree == tree->degree) {
+			tree = p_link(tree, list->tree);
+			list = list->next;
+		}
+		return p_cons(tree, list);
+	}
+
+	/**
+	 * @brief Merges two root lists
+	 * Time complexity: O(length(a) + length(b))
+	 * @return ListPtr New root list
+	 */
+	ListPtr p_merge(ListPtr const& a, ListPtr const& b) {
+		if (a == nullptr) return b;
+		if (b == nullptr) return a;
+
+		if (a->tree->degree < b->tree->degree) {
+			return p_cons(a->tree, p_merge(a->next, b));
+		}
+		else if (b->tree->degree < a->tree->degree) {
+			return p_cons(b->tree, p_merge(a, b->next));
+		}
+		else {
+			return p_insert_tree(p_link(a->tree, b->tree), p_merge(a->next, b->next));
+		}
+	}
+
+	/**
+	 * @brief Copies the list without 'tree'. Only the cells before it are new.
+	 * Time complexity: O(length(list))
+	 */
+	ListPtr p_remove(ListPtr const& list, Tree const* tree) {
+		if (list->tree.get() == tree) return list->next;
+		return p_cons(list->tree, p_remove(list->next, tree));
+	}
+
+	void p_update_greater() {
+		this->_greater = nullptr;
+		for (Cell const* it = this->_roots.get(); it != nullptr; it = it->next.get()) {
+			if (this->_greater == nullptr || comparator(it->tree->key, this->_greater->key)) {
+				this->_greater = it->tree;
+			}
+		}
+	}
+
+	template<class... Args>
+	void p_emplace(Args&&... args) {
+		TreePtr tree = std::allocate_shared<Tree>(alloc, 0, ListPtr(), std::forward<Args>(args)...);
+
+		this->_roots = p_insert_tree(tree, this->_roots);
+		this->p_update_greater();
+		++this->_size;
+	}
+
+	T p_pop() {
+		TreePtr greater = this->_greater;
+
+		// The children become a root list, on increasing degree order
+		ListPtr children;
+		for (Cell const* it = greater->children.get(); it != nullptr; it = it->next.get()) {
+			children = p_cons(it->tree, children);
+		}
+
+		this->_roots = p_merge(p_remove(this->_roots, greater.get()), children);
+		this->p_update_greater();
+		--this->_size;
+
+		return greater->key;
+	}
+
+public:
+	/**
+	 * @brief Construct a new Persistent Binomial Heap object
+	 * Time complexity: O(1)
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	PersistentBinomialHeap(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_new(c, alloc);
+	}
+
+	/**
+	 * @brief Construct a new Persistent Binomial Heap object by copy. Both heaps share
+	 * all their nodes, and any later change on one of them is not seen by the other.
+	 * Time complexity: O(1)
+	 * @param other The other heap
+	 */
+	PersistentBinomialHeap(PersistentBinomialHeap const& other) {
+		this->p_copy(other);
+	}
+
+	/**
+	 * @brief Construct a new Persistent Binomial Heap object by move
+	 * Time complexity: O(1)
+	 * @param other The other heap
+	 */
+	PersistentBinomialHeap(PersistentBinomialHeap&& other) noexcept {
+		this->p_move(other);
+	}
+
+	/**
+	 * @brief Copy assignment operator
+	 * Time complexity: O(1)
+	 *  - Plus the nodes that are only used by this heap, that are freed
+	 * @param other The other heap to copy
+	 * @return PersistentBinomialHeap& Reference to *this
+	 */
+	PersistentBinomialHeap& operator=(PersistentBinomialHeap const& other) {
+		if (this != &other) {
+			this->p_copy(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Move assignment operator
+	 * Time complexity: O(1)
+	 *  - Plus the nodes that are only used by this heap, that are freed
+	 * @param other The other heap to move
+	 * @return PersistentBinomialHeap& Reference to *this
+	 */
+	PersistentBinomialHeap& operator=(PersistentBinomialHeap&& other) noexcept {
+		if (this != &other) {
+			this->p_move(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Swap the two heaps
+	 * Time complexity: O(1)
+	 * @param other The other heap to swap with
+	 */
+	void swap(PersistentBinomialHeap& other) {
+		p_adl_swap(this->comparator, other.comparator);
+		p_adl_swap(this->alloc, other.alloc);
+		p_adl_swap(this->_roots, other._roots);
+		p_adl_swap(this->_greater, other._greater);
+		p_adl_swap(this->_size, other._size);
+	}
+
+	/**
+	 * @brief Push element to the heap, copying it
+	 * Time complexity: O(log(this->size()) + copy)
+	 * @param elem Element to push
+	 */
+	void push(T const& elem) {
+		this->p_emplace(elem);
+	}
+
+	/**
+	 * @brief Push element to the heap, moving it
+	 * Time complexity: O(log(this->size()) + move)
+	 * @param elem Element to push
+	 */
+	void push(T&& elem) {
+		this->p_emplace(std::move(elem));
+	}
+
+	/**
+	 * @brief Construct element directly on the heap
+	 * Time complexity: O(log(this->size()) + creation)
+	 * @tparam Args Template parameter list, type parameters of the object constructor
+	 * @param args Parameters list of the object constructor
+	 */
+	template<class... Args>
+	void emplace(Args&&... args) {
+		this->p_emplace(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Pop element from the heap. The element is copied, because other versions
+	 * can still use it.
+	 * Time complexity: O(log(this->size()) + copy)
+	 * @return T Element popped
+	 */
+	T pop() {
+		if (empty()) throw std::domain_error("Empty heap");
+		return this->p_pop();
+	}
+
+	/**
+	 * @brief Merge two heaps. The other heap is left on a default state, copy it
+	 * before (O(1)) to keep it.
+	 * Time complexity: O(log(this->size()) + log(other.size()))
+	 * @param other The other heap
+	 */
+	void merge(PersistentBinomialHeap& other) {
+		this->_roots = p_merge(this->_roots, other._roots);
+		this->_size += other._size;
+		this->p_update_greater();
+
+		other.p_default();
+	}
+
+	/**
+	 * @brief Consult top element of the heap
+	 * Time complexity: O(1)
+	 * @return T const& Reference to the top element
+	 */
+	T const& top() const {
+		if (empty()) throw std::domain_error("Empty heap");
+		return this->_greater->key;
+	}
+
+	/**
+	 * @brief If heap empty
+	 * Time complexity: O(1)
+	 */
+	bool empty() const {
+		return this->_roots == nullptr;
+	}
+
+	/**
+	 * @brief Number of elements
+	 * Time complexity: O(1)
+	 */
+	std::size_t size() const {
+		return this->_size;
+	}
+};
+
+/**
+ * @brief Time complexity: O(1)
+ * ADL finds this swap
+ */
+template<typename T, class C, class A>
+void swap(PersistentBinomialHeap<T, C, A>& lhs, PersistentBinomialHeap<T, C, A>& rhs) {
+	lhs.swap(rhs);
+}
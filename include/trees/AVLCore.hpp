@@ -0,0 +1,424 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+/**
+ * @brief Node algorithms of the AVL trees (AVLTree, AugmentedAVLTree), that only differ
+ * on what their nodes keep besides the height: searches, rotations, rebalancing,
+ * inserts, sorted builds and the iterator. <br>
+ * Node has a Key e, two children Node* left and Node* right, and an int height. Tree
+ * declares this class as a friend, and has:
+ * - Node* root and Comparator comparator.
+ * - void p_update(Node*): recomputes the height (and the data of the tree) of a node
+ *   from its children.
+ * - Node* p_create(Args&&...) and void p_destroy(Node*).
+ * - void p_retrace(Node** path[], int depth, int delta): rebalances the path after an
+ *   insert (delta = +1) or an erase (delta = -1).
+ *
+ * @tparam Key Keys' type
+ * @tparam Node Nodes' type
+ * @tparam Tree The tree
+ */
+template<class Key, class Node, class Tree>
+class avl_core {
+public:
+	/**
+	 * @brief Upper bound of the height of the tree, AVL trees of 2^64 nodes are not
+	 * higher than 1.44 * 64
+	 */
+	static const int MAX_HEIGHT = 96;
+
+	static int height(Node const* node) {
+		if (node == nullptr) return 0;
+		else return node->height;
+	}
+
+	/**
+	 * @brief Rotations only relink nodes, keys are never copied nor moved
+	 */
+	static Node* rotateRight(Tree& tree, Node* node) {
+		Node* l = node->left;
+		node->left = l->right;
+		l->right = node;
+
+		tree.p_update(node);
+		tree.p_update(l);
+		return l;
+	}
+
+	static Node* rotateLeft(Tree& tree, Node* node) {
+		Node* r = node->right;
+		node->right = r->left;
+		r->left = node;
+
+		tree.p_update(node);
+		tree.p_update(r);
+		return r;
+	}
+
+	/**
+	 * @brief Restores the AVL property on node, whose subtrees are AVL trees whose
+	 * heights differ at most by 2. The node is updated even if it does not rotate
+	 * @return Node* New root of the subtree
+	 */
+	static Node* equil(Tree& tree, Node* node) {
+		tree.p_update(node);
+
+		if (height(node->left) == height(node->right) + 2) {
+			if (height(node->left->left) < height(node->left->right)) {
+				//Rotacion LR
+				node->left = rotateLeft(tree, node->left);
+			}
+			//Rotacion LL
+			return rotateRight(tree, node);
+		}
+		else if (height(node->left) + 2 == height(node->right)) {
+			if (height(node->right->right) < height(node->right->left)) {
+				//Rotacion RL
+				node->right = rotateRight(tree, node->right);
+			}
+			//Rotacion RR
+			return rotateLeft(tree, node);
+		}
+		else return node;
+	}
+
+	/**
+	 * @brief Searches the key, saving on path the links (pointers to the pointer of the
+	 * parent, or to root) of the nodes above it. It goes down to a leaf with one
+	 * comparison per level, remembering the last node not less than key, and checks at
+	 * the end if that node is key
+	 * @return Node** Link where the key is, or where it would be inserted
+	 */
+	static Node** find_link(Tree& tree, Key const& key, Node** path[], int& depth) {
+		Node** link = &tree.root;
+		Node** candidate = nullptr;
+		int candidate_depth = 0;
+		while (*link != nullptr) {
+			Node* node = *link;
+			path[depth++] = link;
+			if (tree.comparator(node->e, key)) {
+				link = &node->right;
+			}
+			else {
+				candidate = link;
+				candidate_depth = depth - 1;
+				link = &node->left;
+			}
+		}
+
+		if (candidate != nullptr && !tree.comparator(key, (*candidate)->e)) {
+			depth = candidate_depth;
+			return candidate;
+		}
+		return link;
+	}
+
+	/**
+	 * @brief Unlinks the node of link, found by find_link, without destroying it. If it
+	 * has two children its successor node takes its place (and its height), instead of
+	 * copying its key, and path is extended to the old link of the successor
+	 * @return Node* The successor, or nullptr if node had no right child
+	 */
+	static Node* unlink(Node** link, Node** path[], int& depth) {
+		Node* node = *link;
+		if (node->right == nullptr) {
+			*link = node->left;
+			return nullptr;
+		}
+
+		int top = depth;
+		path[depth++] = link;
+
+		Node** min_link = &node->right;
+		while ((*min_link)->left != nullptr) {
+			path[depth++] = min_link;
+			min_link = &(*min_link)->left;
+		}
+
+		Node* min = *min_link;
+		*min_link = min->right;
+		min->left = node->left;
+		min->right = node->right;
+		min->height = node->height;
+		*link = min;
+
+		// The link below node was inside of it
+		if (depth > top + 1) path[top + 1] = &min->right;
+		return min;
+	}
+
+	/**
+	 * @brief Inserts the key, constructing the node only if it is not on the tree
+	 * @tparam K Key const& or Key&&
+	 */
+	template<class K>
+	static void insert(Tree& tree, K&& key) {
+		Node** path[MAX_HEIGHT];
+		int depth = 0;
+
+		Node** link = find_link(tree, key, path, depth);
+		if (*link != nullptr) return;
+
+		*link = tree.p_create(std::forward<K>(key));
+		tree.p_retrace(path, depth, +1);
+	}
+
+	/**
+	 * @brief Links an already created node. If its key is on the tree, it is destroyed
+	 */
+	static void insert_node(Tree& tree, Node* new_node) {
+		Node** path[MAX_HEIGHT];
+		int depth = 0;
+
+		Node** link = find_link(tree, new_node->e, path, depth);
+		if (*link != nullptr) {
+			tree.p_destroy(new_node);
+			return;
+		}
+
+		*link = new_node;
+		tree.p_retrace(path, depth, +1);
+	}
+
+	/**
+	 * @brief Builds a perfectly balanced tree with the next n keys of a sorted sequence.
+	 * Nodes are created on key order, so they are allocated one after the other
+	 * @param it Iterator to the first key, it is left after the last one
+	 */
+	template<class ForwardIt>
+	static Node* build(Tree& tree, ForwardIt& it, std::size_t n) {
+		if (n == 0) return nullptr;
+
+		Node* left = build(tree, it, n / 2);
+		Node* node = tree.p_create(*it);
+		++it;
+		node->left = left;
+		node->right = build(tree, it, n - 1 - n / 2);
+		tree.p_update(node);
+
+		return node;
+	}
+
+	/**
+	 * @brief Node with the key, or nullptr. One comparison per level, and one more to
+	 * check the last node not less than key
+	 * @tparam K Key, or any type comparable with it if the Comparator is transparent
+	 */
+	template<class K>
+	static Node* find(Tree const& tree, Node* node, K const& key) {
+		Node* candidate = nullptr;
+		while (node != nullptr) {
+			if (tree.comparator(node->e, key)) {
+				node = node->right;
+			}
+			else {
+				candidate = node;
+				node = node->left;
+			}
+		}
+
+		if (candidate != nullptr && !tree.comparator(key, candidate->e)) return candidate;
+		return nullptr;
+	}
+
+	/**
+	 * @brief Bidirectional iterator over the keys, on increasing order. It keeps the
+	 * path from the root to the current node on a fixed-size stack, so the nodes do not
+	 * need parent pointers and it never allocates. <br>
+	 * Any insert or erase invalidates all the iterators.
+	 */
+	class iterator {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = Key;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Key const*;
+		using reference = Key const&;
+
+	private:
+		friend class avl_core;
+		friend Tree;
+
+		Node* root;
+		Node* path[MAX_HEIGHT];
+		int depth; // path[depth - 1] is the current node, end() has depth 0
+
+		iterator(Node* root) : root(root), depth(0) {}
+
+		void p_push_leftmost(Node* node) {
+			while (node != nullptr) {
+				path[depth++] = node;
+				node = node->left;
+			}
+		}
+
+		void p_push_rightmost(Node* node) {
+			while (node != nullptr) {
+				path[depth++] = node;
+				node = node->right;
+			}
+		}
+
+		Node* p_current() const {
+			return depth == 0 ? nullptr : path[depth - 1];
+		}
+
+	public:
+		iterator() : root(nullptr), depth(0) {}
+
+		iterator(iterator const& other) : root(other.root), depth(other.depth) {
+			std::copy(other.path, other.path + other.depth, path);
+		}
+
+		iterator& operator=(iterator const& other) {
+			root = other.root;
+			depth = other.depth;
+			std::copy(other.path, other.path + other.depth, path);
+			return *this;
+		}
+
+		reference operator*() const {
+			return path[depth - 1]->e;
+		}
+
+		pointer operator->() const {
+			return &path[depth - 1]->e;
+		}
+
+		/**
+		 * @brief Next key
+		 * Time complexity: O(log(n))
+		 * Amortized time complexity: O(1)
+		 */
+		iterator& operator++() {
+			Node* node = path[depth - 1];
+			if (node->right != nullptr) {
+				p_push_leftmost(node->right);
+			}
+			else {
+				// Go up while coming from a right child
+				--depth;
+				while (depth > 0 && path[depth - 1]->right == node) {
+					node = path[depth - 1];
+					--depth;
+				}
+			}
+			return *this;
+		}
+
+		iterator operator++(int) {
+			iterator old(*this);
+			++(*this);
+			return old;
+		}
+
+		/**
+		 * @brief Previous key. Decrementing end() gives the greatest key
+		 * Time complexity: O(log(n))
+		 * Amortized time complexity: O(1)
+		 */
+		iterator& operator--() {
+			if (depth == 0) {
+				p_push_rightmost(root);
+				return *this;
+			}
+
+			Node* node = path[depth - 1];
+			if (node->left != nullptr) {
+				p_push_rightmost(node->left);
+			}
+			else {
+				// Go up while coming from a left child
+				--depth;
+				while (depth > 0 && path[depth - 1]->left == node) {
+					node = path[depth - 1];
+					--depth;
+				}
+			}
+			return *this;
+		}
+
+		iterator operator--(int) {
+			iterator old(*this);
+			--(*this);
+			return old;
+		}
+
+		bool operator==(iterator const& other) const {
+			return p_current() == other.p_current();
+		}
+
+		bool operator!=(iterator const& other) const {
+			return p_current() != other.p_current();
+		}
+	};
+
+	/**
+	 * @brief Iterator to the smallest key
+	 */
+	static iterator begin(Node* root) {
+		iterator it(root);
+		it.p_push_leftmost(root);
+		return it;
+	}
+
+	/**
+	 * @brief Iterator to the first key not less than key
+	 */
+	template<class K>
+	static iterator lower_bound(Tree const& tree, K const& key) {
+		iterator it(tree.root);
+		int found = 0; // The path to the result is a prefix of the search path
+		Node* node = tree.root;
+		while (node != nullptr) {
+			it.path[it.depth++] = node;
+			if (tree.comparator(node->e, key)) {
+				node = node->right;
+			}
+			else {
+				found = it.depth;
+				node = node->left;
+			}
+		}
+
+		it.depth = found;
+		return it;
+	}
+
+	/**
+	 * @brief Iterator to the first key greater than key
+	 */
+	template<class K>
+	static iterator upper_bound(Tree const& tree, K const& key) {
+		iterator it(tree.root);
+		int found = 0; // The path to the result is a prefix of the search path
+		Node* node = tree.root;
+		while (node != nullptr) {
+			it.path[it.depth++] = node;
+			if (tree.comparator(key, node->e)) {
+				found = it.depth;
+				node = node->left;
+			}
+			else {
+				node = node->right;
+			}
+		}
+
+		it.depth = found;
+		return it;
+	}
+
+	/**
+	 * @brief Iterator to key, or end(). The lower bound, if it is not greater than key
+	 */
+	template<class K>
+	static iterator find_iterator(Tree const& tree, K const& key) {
+		iterator it = lower_bound(tree, key);
+		if (it.depth != 0 && tree.comparator(key, *it)) it.depth = 0;
+		return it;
+	}
+};
@@ -1,8 +1,50 @@
 #pragma once
 
-template <typename Key>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "AVLCore.hpp"
+#include "SortedRange.hpp"
+
+/**
+ * @brief AVLTree <br>
+ * Ordered set implemented as an AVL tree <br>
+ * Every node stores the size of its subtree, so the tree also answers order statistics
+ * (select, rank, count_range) in O(log(n)) <br>
+ * Keys are ordered by the Comparator. Searches make one comparison per level and check
+ * the equality once at the end. If the Comparator has an is_transparent member type, the
+ * lookups (contains, count, find, lower_bound, upper_bound) accept any type comparable
+ * with Key, without constructing a temporary key <br>
+ * Node allocations are made using the Allocator (rebound to the node type) <br>
+ * @see https://en.wikipedia.org/wiki/AVL_tree
+ * @tparam Key Elements' type this tree will store
+ * @tparam Comparator Strict weak ordering between keys
+ * @tparam Allocator Keys' allocator
+ */
+template <typename Key, class Comparator = std::less<Key>, class Allocator = std::allocator<Key>>
 class AVLTree {
 protected:
+	/**
+	 * @brief Uses the first swap found by the ADL algorithm. <br>
+	 * This should find the user-defined swap before the generic std::swap, that makes
+	 * three moves
+	 * @tparam U Type
+	 * @param left Left object
+	 * @param right Right object
+	 */
+	template<typename U>
+	void p_adl_swap(U& left, U& right) {
+		using std::swap;
+		swap(left, right); // ADL swap
+	}
+
 	struct Node {
 		Key e;
 		Node* left;
@@ -12,192 +54,973 @@ protected:
 		int height;
 	};
 
+	using core = avl_core<Key, Node, AVLTree>;
+	friend class avl_core<Key, Node, AVLTree>;
+
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+
+	using alloc_key_traits = std::allocator_traits<Allocator>;
+	using alloc_node_traits = std::allocator_traits<NodeAllocator>;
+
+	NodeAllocator alloc_node;
+	Allocator alloc_key;
+	Comparator comparator;
+
 	Node* root;
 
+	void p_destroy(Node* node) {
+		alloc_key_traits::destroy(alloc_key, &node->e);
+		alloc_node_traits::deallocate(alloc_node, node, 1);
+	}
+
 	void p_del(Node* node) {
 		if (node != nullptr) {
 			p_del(node->left);
 			p_del(node->right);
-			delete node;
+			p_destroy(node);
 		}
 	}
 
-	bool p_empty(Node* node) const {
+	Node* p_copy(Node const* node) {
+		if (node == nullptr) return nullptr;
+
+		Node* new_node = alloc_node_traits::allocate(alloc_node, 1);
+		alloc_key_traits::construct(alloc_key, &new_node->e, node->e);
+		new_node->left = p_copy(node->left);
+		new_node->right = p_copy(node->right);
+		new_node->cardinal = node->cardinal;
+		new_node->height = node->height;
+
+		return new_node;
+	}
+
+	void p_default() {
+		this->root = nullptr;
+	}
+
+	void p_new(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_default();
+		this->comparator = c;
+		this->alloc_key = alloc;
+		this->alloc_node = NodeAllocator(alloc);
+	}
+
+	void p_delete() {
+		this->p_del(this->root);
+		this->p_default();
+	}
+
+	void p_copy(AVLTree const& other) {
+		this->comparator = other.comparator;
+		this->alloc_key = other.alloc_key;
+		this->alloc_node = alloc_node_traits::select_on_container_copy_construction(other.alloc_node);
+		this->root = p_copy(other.root);
+	}
+
+	void p_move(AVLTree& other) {
+		this->comparator = std::move(other.comparator);
+		this->alloc_key = std::move(other.alloc_key);
+		this->alloc_node = std::move(other.alloc_node);
+		this->root = other.root;
+
+		other.p_default();
+	}
+
+	void p_swap(AVLTree& other) {
+		p_adl_swap(this->comparator, other.comparator);
+		p_adl_swap(this->alloc_key, other.alloc_key);
+		p_adl_swap(this->alloc_node, other.alloc_node);
+		p_adl_swap(this->root, other.root);
+	}
+
+	bool p_empty(Node const* node) const {
 		return node == nullptr;
 	}
 
-	int p_height(Node* node) {
+	int p_height(Node* node) const {
 		if (p_empty(node)) return 0;
 		else return node->height;
 	}
 
-	int p_cardinal(Node* node) {
+	int p_cardinal(Node* node) const {
 		if (p_empty(node)) return 0;
 		else return node->cardinal;
 	}
 
-	Node* p_create_recycle(Node* left, Key const& elem, Node* right, Node* recycle) {
-		recycle->left = left;
-		recycle->e = elem;
-		recycle->right = right;
-		recycle->height = std::max(p_height(left), p_height(right)) + 1;
-		recycle->cardinal = 1 + p_cardinal(left) + p_cardinal(right);
+	/**
+	 * @brief Recomputes the height and the cardinal of node from its children
+	 */
+	void p_update(Node* node) {
+		node->height = std::max(p_height(node->left), p_height(node->right)) + 1;
+		node->cardinal = 1 + p_cardinal(node->left) + p_cardinal(node->right);
+	}
+
+	template<class... Args>
+	Node* p_create(Args&&... args) {
+		Node* node = alloc_node_traits::allocate(alloc_node, 1);
+		alloc_key_traits::construct(alloc_key, &node->e, std::forward<Args>(args)...);
+
+		node->left = nullptr;
+		node->right = nullptr;
+		node->height = 1;
+		node->cardinal = 1;
 
-		return recycle;
+		return node;
 	}
 
-	Node* p_create(Node* left, Key const& elem, Node* right) {
-		Node* node = new Node;
-		return p_create_recycle(left, elem, right, node);
+	/** @see avl_core::equil */
+	Node* p_equil(Node* node) {
+		return core::equil(*this, node);
 	}
 
-	Node* p_equilLeft(Node* l, Key const& y, Node* r, Node* recycle) {
-		Node* ll = l->left;
-		Node* lr = l->right;
-		Key x = l->e;
-		if (p_height(ll) >= p_height(lr)) {
-			//Rotacion LL
-			Node* newlr = p_create_recycle(lr, y, r, l);
-			return p_create_recycle(ll, x, newlr, recycle);
+	/**
+	 * @brief Walks the path up after an insert or an erase, rebalancing until the height
+	 * of a subtree does not change. Above it only the cardinals change.
+	 * @param delta +1 after an insert, -1 after an erase
+	 */
+	void p_retrace(Node** path[], int depth, int delta) {
+		int i = depth - 1;
+		while (i >= 0) {
+			Node* node = *path[i];
+			int height = node->height;
+			node = *path[i] = p_equil(node);
+			--i;
+
+			if (node->height == height) break;
 		}
-		else {
-			//Rotacion LR
-			Node* lrl = lr->left;
-			Node* lrr = lr->right;
-			Key z = l->right->e;
 
-			Node* newll = p_create_recycle(ll, x, lrl, lr);
-			Node* newlr = p_create_recycle(lrr, y, r, l);
-			return p_create_recycle(newll, z, newlr, recycle);
+		for (; i >= 0; --i) {
+			(*path[i])->cardinal += delta;
 		}
 	}
 
-	Node* p_equilRight(Node* l, Key const& y, Node* r, Node* recycle) {
-		Node* rl = r->left;
-		Node* rr = r->right;
-		Key x = r->e;
+	void p_erase(Key const& elem) {
+		Node** path[core::MAX_HEIGHT];
+		int depth = 0;
+
+		Node** link = core::find_link(*this, elem, path, depth);
+		Node* node = *link;
+		if (p_empty(node)) return;
+
+		Node* successor = core::unlink(link, path, depth);
+		if (successor != nullptr) successor->cardinal = node->cardinal;
+
+		p_destroy(node);
+		p_retrace(path, depth, -1);
+	}
+
+	template<class ForwardIt>
+	void p_assign_sorted(ForwardIt first, ForwardIt last) {
+		this->p_delete();
+		this->root = core::build(*this, first, std::distance(first, last));
+	}
+
+	friend class sorted_range<Key, Comparator>;
+
+	/** @see sorted_range::assign */
+	template<class ForwardIt>
+	void p_assign(ForwardIt first, ForwardIt last) {
+		sorted_range<Key, Comparator>::assign(*this, first, last, this->comparator);
+	}
+
+	/**
+	 * @brief Subtrees with less nodes than this are never processed on a new thread
+	 */
+	static const int MIN_PARALLEL = 4096;
 
-		if (p_height(rr) >= p_height(rl)) {
-			//Rotacion RR
-			Node* newrl = p_create_recycle(l, y, rl, recycle);
-			return p_create_recycle(newrl, x, rr, r);
+	Node* p_joinRight(Node* left, Node* node, Node* right) {
+		if (p_height(left->right) <= p_height(right) + 1) {
+			node->left = left->right;
+			node->right = right;
+			p_update(node);
+			left->right = node;
 		}
 		else {
-			Node* rll = rl->left;
-			Node* rlr = rl->right;
-			Key z = rl->e;
-
-			Node* newrr = p_create_recycle(rlr, x, rr, rl);
-			Node* newrl = p_create_recycle(l, y, rll, recycle);
-			return p_create_recycle(newrl, z, newrr, r);
+			left->right = p_joinRight(left->right, node, right);
 		}
+
+		return p_equil(left);
 	}
 
-	Node* p_equil(Node* l, Key const& key, Node* r, Node* recycle) {
-		if (p_height(l) == p_height(r) + 2) {
-			return p_equilLeft(l, key, r, recycle);
-		}
-		else if (p_height(l) + 2 == p_height(r)) {
-			return p_equilRight(l, key, r, recycle);
+	Node* p_joinLeft(Node* left, Node* node, Node* right) {
+		if (p_height(right->left) <= p_height(left) + 1) {
+			node->left = left;
+			node->right = right->left;
+			p_update(node);
+			right->left = node;
 		}
 		else {
-			return p_create_recycle(l, key, r, recycle);
+			right->left = p_joinLeft(left, node, right->left);
 		}
+
+		return p_equil(right);
 	}
 
-	void p_eraseMin(Node* node, Key& elem, Node*& t) {
-		if (p_empty(node->left)) {
-			elem = node->e;
-			t = node->right;
-			delete node;
+	/**
+	 * @brief Joins two trees and a node, all the keys of left are less than the key of
+	 * node, and the keys of right are greater
+	 * Time complexity: O(|height(left) - height(right)| + 1)
+	 * @return Node* Root of the new tree
+	 */
+	Node* p_join(Node* left, Node* node, Node* right) {
+		if (p_height(left) > p_height(right) + 1) {
+			return p_joinRight(left, node, right);
+		}
+		else if (p_height(right) > p_height(left) + 1) {
+			return p_joinLeft(left, node, right);
 		}
 		else {
-			Node* result_left;
-			p_eraseMin(node->left, elem, result_left);
-			
-			t = p_equil(result_left, node->e, node->right, node);
+			node->left = left;
+			node->right = right;
+			p_update(node);
+			return node;
+		}
+	}
+
+	/**
+	 * @brief Unlinks the maximum node of a non empty subtree, without deallocating it
+	 * @return Node* New root of the subtree
+	 */
+	Node* p_splitLast(Node* node, Node*& last) {
+		if (p_empty(node->right)) {
+			last = node;
+			return node->left;
 		}
+
+		node->right = p_splitLast(node->right, last);
+		return p_equil(node);
 	}
 
-	Node* p_erase(Node* node, Key const& elem) {
-		if (p_empty(node)) return node;
-		
-		if (elem < node->e) {
-			Node* newl = p_erase(node->left, elem);
-			return p_equil(newl, node->e, node->right, node);
+	/**
+	 * @brief Joins two trees, all the keys of left are less than the keys of right
+	 */
+	Node* p_join2(Node* left, Node* right) {
+		if (p_empty(left)) return right;
+
+		Node* last;
+		left = p_splitLast(left, last);
+		return p_join(left, last, right);
+	}
+
+	/**
+	 * @brief Splits the tree on the keys less than key and the keys greater than key
+	 * Time complexity: O(height(node))
+	 * @return Node* Node with the key, unlinked, or nullptr if it is not on the tree
+	 */
+	Node* p_split(Node* node, Key const& key, Node*& left, Node*& right) {
+		if (p_empty(node)) {
+			left = right = nullptr;
+			return nullptr;
+		}
+
+		Node* l = node->left;
+		Node* r = node->right;
+		if (comparator(key, node->e)) {
+			Node* found = p_split(l, key, left, l);
+			right = p_join(l, node, r);
+			return found;
 		}
-		else if (elem > node->e) {
-			Node* newr = p_erase(node->right, elem);
-			return p_equil(node->left, node->e, newr, node);
+		else if (comparator(node->e, key)) {
+			Node* found = p_split(r, key, r, right);
+			left = p_join(l, node, r);
+			return found;
 		}
 		else {
-			//Soy yo
-			if (p_empty(node->right)) {
-				Node* aux = node->left;
-				delete node;
-				return aux;
-			}
-			else {
-				Key& min = node->e;
-				Node* result_right;
-				p_eraseMin(node->right, min, result_right);
+			left = l;
+			right = r;
+			return node;
+		}
+	}
 
-				return p_equil(node->left, min, result_right, node);
-			}
+	/**
+	 * @brief Computes left() and right(). If forks > 0 and the subtree is big enough,
+	 * left() runs on a new thread
+	 */
+	template<class FL, class FR>
+	void p_fork_join(int forks, int size, FL left, FR right) {
+		if (forks > 0 && size >= MIN_PARALLEL) {
+			std::thread thread(left);
+			right();
+			thread.join();
+		}
+		else {
+			left();
+			right();
 		}
 	}
 
-	Node* p_insert(Node* node, Key const& elem) {
-		if (p_empty(node)) return p_create(nullptr, elem, nullptr);
+	/**
+	 * @brief Union of the tree 'node' (whose nodes are reused) and the tree 'other' (whose
+	 * keys are copied)
+	 */
+	Node* p_union(Node* node, Node const* other, int forks) {
+		if (p_empty(other)) return node;
+		if (p_empty(node)) return p_copy(other);
+
+		Node* left;
+		Node* right;
+		Node* found = p_split(node, other->e, left, right);
+		p_fork_join(forks, p_cardinal(node) + other->cardinal,
+			[&]() { left = p_union(left, other->left, forks - 1); },
+			[&]() { right = p_union(right, other->right, forks - 1); });
+
+		if (found == nullptr) found = p_create(other->e);
+		return p_join(left, found, right);
+	}
 
-		if (elem < node->e) {
-			Node* aux = p_insert(node->left, elem);
-			return p_equil(aux, node->e, node->right, node);
+	/**
+	 * @brief Intersection of the tree 'node' (whose nodes are reused or destroyed) and
+	 * the tree 'other'
+	 */
+	Node* p_intersect(Node* node, Node const* other, int forks) {
+		if (p_empty(node)) return nullptr;
+		if (p_empty(other)) {
+			p_del(node);
+			return nullptr;
 		}
-		else if (elem == node->e) return node;
-		else {
-			Node* aux = p_insert(node->right, elem);
-			return p_equil(node->left, node->e, aux, node);
+
+		Node* left;
+		Node* right;
+		Node* found = p_split(node, other->e, left, right);
+		p_fork_join(forks, p_cardinal(node) + other->cardinal,
+			[&]() { left = p_intersect(left, other->left, forks - 1); },
+			[&]() { right = p_intersect(right, other->right, forks - 1); });
+
+		if (found != nullptr) return p_join(left, found, right);
+		else return p_join2(left, right);
+	}
+
+	/**
+	 * @brief Keys of the tree 'node' (whose nodes are reused or destroyed) that are not
+	 * on the tree 'other'
+	 */
+	Node* p_difference(Node* node, Node const* other, int forks) {
+		if (p_empty(node)) return nullptr;
+		if (p_empty(other)) return node;
+
+		Node* left;
+		Node* right;
+		Node* found = p_split(node, other->e, left, right);
+		p_fork_join(forks, p_cardinal(node) + other->cardinal,
+			[&]() { left = p_difference(left, other->left, forks - 1); },
+			[&]() { right = p_difference(right, other->right, forks - 1); });
+
+		if (found != nullptr) p_destroy(found);
+		return p_join2(left, right);
+	}
+
+	/**
+	 * @brief Number of nested forks needed to use the threads
+	 */
+	static int p_forks(std::size_t threads) {
+		int forks = 0;
+		while (((std::size_t)1 << forks) < threads) ++forks;
+		return forks;
+	}
+
+	/**
+	 * @brief Creates a copy of the tree whose keys are moved
+	 */
+	Node* p_copy_move(Node* node) {
+		if (node == nullptr) return nullptr;
+
+		Node* new_node = p_create(std::move(node->e));
+		new_node->left = p_copy_move(node->left);
+		new_node->right = p_copy_move(node->right);
+		new_node->cardinal = node->cardinal;
+		new_node->height = node->height;
+
+		return new_node;
+	}
+
+	/**
+	 * @brief Makes the nodes of the tree 'node', owned by 'from', usable by this tree.
+	 * If the allocators are not equal the keys are moved to new nodes
+	 */
+	Node* p_transfer(Node* node, AVLTree& from) {
+		if (this->alloc_node == from.alloc_node) return node;
+
+		Node* copy = p_copy_move(node);
+		from.p_del(node);
+		return copy;
+	}
+
+	/** @see avl_core::find */
+	template<class K>
+	Node* p_find(Node* node, K const& key) const {
+		return core::find(*this, node, key);
+	}
+
+	/**
+	 * @brief k-th smallest element, k < size
+	 */
+	Key const& p_select(Node* node, std::size_t k) const {
+		while (true) {
+			std::size_t left = p_cardinal(node->left);
+			if (k < left) {
+				node = node->left;
+			}
+			else if (k > left) {
+				k -= left + 1;
+				node = node->right;
+			}
+			else return node->e;
 		}
 	}
 
-	bool p_contains(Node* node, Key const& key) const {
+	/**
+	 * @brief Number of elements less than key
+	 */
+	std::size_t p_rank(Node* node, Key const& key) const {
+		std::size_t rank = 0;
 		while (!p_empty(node)) {
-			if (key < node->e) {
+			if (comparator(node->e, key)) {
+				rank += p_cardinal(node->left) + 1;
+				node = node->right;
+			}
+			else {
 				node = node->left;
 			}
-			else if (key > node->e) {
-				node = node->right;
+		}
+
+		return rank;
+	}
+
+	/**
+	 * @brief Number of lookups that a batch walks in lockstep
+	 */
+	static const int BATCH_GROUP = 16;
+
+	static void p_prefetch(Node const* node) {
+#if defined(__GNUC__)
+		__builtin_prefetch(node);
+#else
+		(void)node;
+#endif
+	}
+
+	/**
+	 * @brief Looks up the keys of [first, last) in groups of BATCH_GROUP, one level of
+	 * every lookup of the group at a time, and prefetches the next node of each one, so
+	 * the cache misses of the group overlap instead of waiting one after the other.
+	 * Like p_find, every lookup goes down to a leaf and checks the equality at the end.
+	 * Writes result(node) for every key, node is nullptr if the key is not on the tree
+	 */
+	template<class ForwardIt, class OutputIt, class Result>
+	OutputIt p_batch(ForwardIt first, ForwardIt last, OutputIt out, Result result) const {
+		using K = typename std::iterator_traits<ForwardIt>::value_type;
+		K const* keys[BATCH_GROUP];
+		Node* nodes[BATCH_GROUP];
+		Node* found[BATCH_GROUP]; // Last node not less than the key
+
+		while (first != last) {
+			int n = 0;
+			for (; n < BATCH_GROUP && first != last; ++n, ++first) {
+				keys[n] = &*first;
+				nodes[n] = root;
+				found[n] = nullptr;
+			}
+
+			bool active = true;
+			while (active) {
+				active = false;
+				for (int i = 0; i < n; ++i) {
+					Node* node = nodes[i];
+					if (node == nullptr) continue;
+
+					if (comparator(node->e, *keys[i])) {
+						node = node->right;
+					}
+					else {
+						found[i] = node;
+						node = node->left;
+					}
+
+					nodes[i] = node;
+					if (node != nullptr) {
+						p_prefetch(node);
+						active = true;
+					}
+				}
+			}
+
+			for (int i = 0; i < n; ++i) {
+				if (found[i] != nullptr && comparator(*keys[i], found[i]->e)) found[i] = nullptr;
+				*out++ = result(found[i]);
 			}
-			else return true;
 		}
 
-		return false;
+		return out;
 	}
 
 public:
 
-	AVLTree() {
-		root = nullptr;
+	/** @see avl_core::iterator */
+	using iterator = typename core::iterator;
+	using const_iterator = iterator;
+
+	/**
+	 * @brief Construct a new AVLTree object
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	AVLTree(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_new(c, alloc);
+	}
+
+	/**
+	 * @brief Construct a new AVLTree object with the keys of [first, last). Repeated
+	 * keys are inserted once
+	 * Time complexity: O(n) if the range is sorted, O(n * log(n)) otherwise
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	template<class ForwardIt>
+	AVLTree(ForwardIt first, ForwardIt last, Comparator const& c = Comparator(),
+		Allocator const& alloc = Allocator())
+	{
+		this->p_new(c, alloc);
+		this->p_assign(first, last);
 	}
 
+	/**
+	 * @brief Construct a new AVLTree object by copy
+	 * Time complexity: O(other.size())
+	 * @param other The other tree to copy
+	 */
+	AVLTree(AVLTree const& other) {
+		this->p_copy(other);
+	}
+
+	/**
+	 * @brief Construct a new AVLTree object by move
+	 * Time complexity: O(1)
+	 * @param other The other tree to move
+	 */
+	AVLTree(AVLTree&& other) noexcept {
+		this->p_move(other);
+	}
+
+	/**
+	 * @brief Destroy the AVLTree object
+	 * Time complexity: O(this->size())
+	 */
 	~AVLTree() {
-		p_del(root);
+		this->p_delete();
 	}
 
+	/**
+	 * @brief Copy assignment operator
+	 * Time complexity: O(other.size() + this->size())
+	 * @param other The other tree to copy
+	 * @return AVLTree& Reference to *this
+	 */
+	AVLTree& operator=(AVLTree const& other) {
+		if (this != &other) {
+			this->p_delete();
+			this->p_copy(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Move assignment operator
+	 * Time complexity: O(this->size())
+	 * @param other The other tree to move
+	 * @return AVLTree& Reference to *this
+	 */
+	AVLTree& operator=(AVLTree&& other) noexcept {
+		if (this != &other) {
+			this->p_delete();
+			this->p_move(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Swap the two trees
+	 * Time complexity: O(1)
+	 * @param other The other tree
+	 */
+	void swap(AVLTree& other) {
+		this->p_swap(other);
+	}
+
+	/**
+	 * @brief Inserts a copy of key, if it is not on the tree
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
 	void insert(Key const& key) {
-		root = p_insert(root, key);
+		core::insert(*this, key);
 	}
 
+	/**
+	 * @brief Inserts key moving it, if it is not on the tree
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	void insert(Key&& key) {
+		core::insert(*this, std::move(key));
+	}
+
+	/**
+	 * @brief Constructs a key on the tree. It is destroyed if it was already on the tree
+	 * Time complexity: O(log(this->size()) + creation)
+	 * @tparam Args Template parameter list, type parameters of the key constructor
+	 * @param args Parameters list of the key constructor
+	 */
+	template<class... Args>
+	void emplace(Args&&... args) {
+		core::insert_node(*this, p_create(std::forward<Args>(args)...));
+	}
+
+	/**
+	 * @brief Erases key, if it is on the tree
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
 	void erase(Key const& key) {
-		root = p_erase(root, key);
+		this->p_erase(key);
+	}
+
+	/**
+	 * @brief Replaces the keys of the tree with the keys of [first, last). Repeated keys
+	 * are inserted once
+	 * Time complexity: O(this->size() + n) if the range is sorted,
+	 * O(this->size() + n * log(n)) otherwise
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 */
+	template<class ForwardIt>
+	void assign(ForwardIt first, ForwardIt last) {
+		this->p_assign(first, last);
+	}
+
+	/**
+	 * @brief Replaces the keys of the tree with the keys of [first, last), that must be
+	 * on strictly increasing order. The new tree is perfectly balanced and its nodes are
+	 * allocated on key order
+	 * Time complexity: O(this->size() + n)
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 */
+	template<class ForwardIt>
+	void assign_sorted(ForwardIt first, ForwardIt last) {
+		this->p_assign_sorted(first, last);
+	}
+
+	/**
+	 * @brief Moves the keys greater than or equal to key to a new tree, this tree keeps
+	 * the keys less than key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 * @return AVLTree Tree with the keys greater than or equal to key
+	 */
+	AVLTree split(Key const& key) {
+		Node* left;
+		Node* right;
+		Node* found = p_split(this->root, key, left, right);
+		if (found != nullptr) right = p_join(nullptr, found, right);
+		this->root = left;
+
+		AVLTree result(this->comparator, this->alloc_key);
+		result.root = result.p_transfer(right, *this);
+		return result;
+	}
+
+	/**
+	 * @brief Appends key and the keys of right. All the keys of this tree must be less than
+	 * key, and the keys of right greater than key. The other tree is left empty
+	 * Time complexity: O(|log(this->size()) - log(right.size())| + 1)
+	 * @param key The key
+	 * @param right The other tree
+	 */
+	void join(Key const& key, AVLTree& right) {
+		Node* other = this->p_transfer(right.root, right);
+		right.p_default();
+		this->root = p_join(this->root, p_create(key), other);
+	}
+
+	/**
+	 * @brief Appends the keys of right. All the keys of this tree must be less than the keys
+	 * of right. The other tree is left empty
+	 * Time complexity: O(log(this->size()) + log(right.size()))
+	 * @param right The other tree
+	 */
+	void join(AVLTree& right) {
+		Node* other = this->p_transfer(right.root, right);
+		right.p_default();
+		this->root = p_join2(this->root, other);
+	}
+
+	/**
+	 * @brief Inserts a copy of the keys of other that are not on this tree
+	 * Time complexity: O(m * log(n / m + 1)), m = min(this->size(), other.size()),
+	 * n = max(this->size(), other.size())
+	 * @param other The other tree
+	 */
+	void union_with(AVLTree const& other) {
+		this->root = p_union(this->root, other.root, 0);
+	}
+
+	/**
+	 * @brief Erases the keys that are not on other
+	 * Time complexity: O(m * log(n / m + 1)), m = min(this->size(), other.size()),
+	 * n = max(this->size(), other.size())
+	 * @param other The other tree
+	 */
+	void intersect_with(AVLTree const& other) {
+		this->root = p_intersect(this->root, other.root, 0);
+	}
+
+	/**
+	 * @brief Erases the keys that are on other
+	 * Time complexity: O(m * log(n / m + 1)), m = min(this->size(), other.size()),
+	 * n = max(this->size(), other.size())
+	 * @param other The other tree
+	 */
+	void difference_with(AVLTree const& other) {
+		this->root = p_difference(this->root, other.root, 0);
+	}
+
+	/**
+	 * @brief Same as union_with, but both halves of the trees are processed on parallel
+	 * (fork-join). The Allocator must be thread-safe
+	 * @param other The other tree
+	 * @param threads Number of threads to use
+	 */
+	void union_with_parallel(AVLTree const& other,
+		std::size_t threads = std::thread::hardware_concurrency())
+	{
+		this->root = p_union(this->root, other.root, p_forks(threads));
+	}
+
+	/**
+	 * @brief Same as intersect_with, but both halves of the trees are processed on
+	 * parallel (fork-join). The Allocator must be thread-safe
+	 * @param other The other tree
+	 * @param threads Number of threads to use
+	 */
+	void intersect_with_parallel(AVLTree const& other,
+		std::size_t threads = std::thread::hardware_concurrency())
+	{
+		this->root = p_intersect(this->root, other.root, p_forks(threads));
+	}
+
+	/**
+	 * @brief Same as difference_with, but both halves of the trees are processed on
+	 * parallel (fork-join). The Allocator must be thread-safe
+	 * @param other The other tree
+	 * @param threads Number of threads to use
+	 */
+	void difference_with_parallel(AVLTree const& other,
+		std::size_t threads = std::thread::hardware_concurrency())
+	{
+		this->root = p_difference(this->root, other.root, p_forks(threads));
 	}
 
 	bool contains(Key const& key) const {
-		return p_contains(root, key);
+		return p_find(root, key) != nullptr;
+	}
+
+	/**
+	 * @brief contains for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	bool contains(K const& key) const {
+		return p_find(root, key) != nullptr;
 	}
 
 	bool count(Key const& key) const {
-		return p_contains(root, key) ? 1 : 0;
+		return p_find(root, key) != nullptr ? 1 : 0;
+	}
+
+	/**
+	 * @brief count for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	bool count(K const& key) const {
+		return p_find(root, key) != nullptr ? 1 : 0;
+	}
+
+	/**
+	 * @brief Writes contains(key) for every key of [first, last), on the same order. The
+	 * lookups are interleaved (see BATCH_GROUP), so it is faster than calling contains
+	 * once per key when the tree does not fit on the cache
+	 * Time complexity: O(k * log(this->size())), k is the number of keys
+	 * @param first First key
+	 * @param last Past the last key
+	 * @param out Output iterator of bool
+	 * @return OutputIt Past the last written value
+	 */
+	template<class ForwardIt, class OutputIt>
+	OutputIt contains_batch(ForwardIt first, ForwardIt last, OutputIt out) const {
+		return p_batch(first, last, out, [](Node const* node) { return node != nullptr; });
+	}
+
+	/**
+	 * @brief Writes, for every key of [first, last) and on the same order, a pointer to the
+	 * key on the tree, or nullptr if it is not on it. The lookups are interleaved (see
+	 * BATCH_GROUP). The pointers are invalidated like the iterators
+	 * Time complexity: O(k * log(this->size())), k is the number of keys
+	 * @param first First key
+	 * @param last Past the last key
+	 * @param out Output iterator of Key const*
+	 * @return OutputIt Past the last written value
+	 */
+	template<class ForwardIt, class OutputIt>
+	OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) const {
+		return p_batch(first, last, out, [](Node const* node) -> Key const* {
+			return node == nullptr ? nullptr : &node->e;
+		});
+	}
+
+	/**
+	 * @brief Iterator to the smallest key
+	 * Time complexity: O(log(this->size()))
+	 */
+	iterator begin() const {
+		return core::begin(root);
+	}
+
+	/**
+	 * @brief Iterator past the greatest key
+	 * Time complexity: O(1)
+	 */
+	iterator end() const {
+		return iterator(root);
+	}
+
+	/**
+	 * @brief Iterator to key, or end() if it is not on the tree
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator find(Key const& key) const {
+		return core::find_iterator(*this, key);
 	}
-};
\ No newline at end of file
+
+	/**
+	 * @brief find for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	iterator find(K const& key) const {
+		return core::find_iterator(*this, key);
+	}
+
+	/**
+	 * @brief Iterator to the first key not less than key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator lower_bound(Key const& key) const {
+		return core::lower_bound(*this, key);
+	}
+
+	/**
+	 * @brief lower_bound for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	iterator lower_bound(K const& key) const {
+		return core::lower_bound(*this, key);
+	}
+
+	/**
+	 * @brief Iterator to the first key greater than key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator upper_bound(Key const& key) const {
+		return core::upper_bound(*this, key);
+	}
+
+	/**
+	 * @brief upper_bound for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	iterator upper_bound(K const& key) const {
+		return core::upper_bound(*this, key);
+	}
+
+	/**
+	 * @brief Calls f with every key on the half-open range [lo, hi), on increasing order.
+	 * It does not allocate.
+	 * Time complexity: O(log(this->size()) + k), k is the number of keys on the range
+	 * @tparam F Callable with a Key const&
+	 * @param lo Lower bound, included
+	 * @param hi Upper bound, excluded
+	 * @param f Function to call
+	 */
+	template<class F>
+	void for_each_in_range(Key const& lo, Key const& hi, F f) const {
+		for (iterator it = lower_bound(lo); it.depth != 0 && comparator(*it, hi); ++it) {
+			f(*it);
+		}
+	}
+
+	/**
+	 * @brief Number of elements
+	 * Time complexity: O(1)
+	 */
+	std::size_t size() const {
+		return p_cardinal(root);
+	}
+
+	/**
+	 * @brief If the tree is empty
+	 * Time complexity: O(1)
+	 */
+	bool empty() const {
+		return p_empty(root);
+	}
+
+	/**
+	 * @brief The k-th smallest element, counting from 0
+	 * Time complexity: O(log(this->size()))
+	 * @param k Position of the element on the sorted sequence
+	 * @return Key const& Reference to the element
+	 */
+	Key const& select(std::size_t k) const {
+		if (k >= size()) throw std::out_of_range("select: k >= size()");
+		return p_select(root, k);
+	}
+
+	/**
+	 * @brief Number of elements less than key. If key is on the tree, it is its
+	 * position on the sorted sequence
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	std::size_t rank(Key const& key) const {
+		return p_rank(root, key);
+	}
+
+	/**
+	 * @brief Number of elements on the half-open range [lo, hi)
+	 * Time complexity: O(log(this->size()))
+	 * @param lo Lower bound, included
+	 * @param hi Upper bound, excluded
+	 */
+	std::size_t count_range(Key const& lo, Key const& hi) const {
+		if (!comparator(lo, hi)) return 0;
+		return p_rank(root, hi) - p_rank(root, lo);
+	}
+};
+
+/**
+ * @brief Swaps the two trees
+ * Time complexity: O(1)
+ * This implementation is intended to be found by the ADL algorithm
+ */
+template<typename Key, class C, class A>
+void swap(AVLTree<Key, C, A>& lhs, AVLTree<Key, C, A>& rhs) {
+	lhs.swap(rhs);
+}
\ No newline at end of file
@@ -0,0 +1,569 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "AVLCore.hpp"
+#include "SortedRange.hpp"
+
+/**
+ * @brief AugmentedAVLTree <br>
+ * Ordered set implemented as an AVL tree where every node also stores a summary of its
+ * subtree, defined by the Augmentation policy. The summaries are kept up to date through
+ * inserts, erases and rotations, so the summary of any range of keys is computed in
+ * O(log(n)), and derived structures (like IntervalTree) can prune subtrees by their
+ * summary. <br>
+ * The Augmentation is a monoid over the keys:
+ * - value_type: type of the summaries.
+ * - value_type identity() const: summary of an empty range.
+ * - value_type measure(Key const&) const: summary of a single key.
+ * - value_type combine(value_type const&, value_type const&) const: summary of two
+ *   consecutive ranges, it must be associative (but not necessarily commutative).
+ *
+ * The searches, rotations and the iterator are the ones of AVLTree (avl_core), only the
+ * node update differs. <br>
+ * Node allocations are made using the Allocator (rebound to the node type) <br>
+ * @see https://en.wikipedia.org/wiki/AVL_tree
+ * @see https://en.wikipedia.org/wiki/Augmented_map
+ * @tparam Key Elements' type this tree will store
+ * @tparam Augmentation Monoid that summarizes the keys of a subtree
+ * @tparam Comparator Strict weak ordering between keys
+ * @tparam Allocator Keys' allocator
+ */
+template <typename Key, class Augmentation, class Comparator = std::less<Key>,
+	class Allocator = std::allocator<Key>>
+class AugmentedAVLTree {
+public:
+	using summary_type = typename Augmentation::value_type;
+
+protected:
+	/**
+	 * @brief Uses the first swap found by the ADL algorithm. <br>
+	 * This should find the user-defined swap before the generic std::swap, that makes
+	 * three moves
+	 * @tparam U Type
+	 * @param left Left object
+	 * @param right Right object
+	 */
+	template<typename U>
+	void p_adl_swap(U& left, U& right) {
+		using std::swap;
+		swap(left, right); // ADL swap
+	}
+
+	struct Node {
+		Key e;
+		Node* left;
+		Node* right;
+
+		summary_type summary; // Of the whole subtree
+		int height;
+	};
+
+	using core = avl_core<Key, Node, AugmentedAVLTree>;
+	friend class avl_core<Key, Node, AugmentedAVLTree>;
+
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+
+	using alloc_key_traits = std::allocator_traits<Allocator>;
+	using alloc_node_traits = std::allocator_traits<NodeAllocator>;
+
+	NodeAllocator alloc_node;
+	Allocator alloc_key;
+	Comparator comparator;
+	Augmentation augmentation;
+
+	Node* root;
+	std::size_t _size;
+
+	void p_destroy(Node* node) {
+		alloc_key_traits::destroy(alloc_key, &node->e);
+		node->summary.~summary_type();
+		alloc_node_traits::deallocate(alloc_node, node, 1);
+		--this->_size;
+	}
+
+	void p_del(Node* node) {
+		if (node != nullptr) {
+			p_del(node->left);
+			p_del(node->right);
+			p_destroy(node);
+		}
+	}
+
+	template<class... Args>
+	Node* p_create(Args&&... args) {
+		Node* node = alloc_node_traits::allocate(alloc_node, 1);
+		alloc_key_traits::construct(alloc_key, &node->e, std::forward<Args>(args)...);
+		new (&node->summary) summary_type(augmentation.measure(node->e));
+
+		node->left = nullptr;
+		node->right = nullptr;
+		node->height = 1;
+		++this->_size;
+
+		return node;
+	}
+
+	Node* p_copy(Node const* node) {
+		if (node == nullptr) return nullptr;
+
+		Node* new_node = p_create(node->e);
+		new_node->left = p_copy(node->left);
+		new_node->right = p_copy(node->right);
+		new_node->summary = node->summary;
+		new_node->height = node->height;
+
+		return new_node;
+	}
+
+	void p_default() {
+		this->root = nullptr;
+		this->_size = 0;
+	}
+
+	void p_new(Augmentation const& a = Augmentation(), Comparator const& c = Comparator(),
+		Allocator const& alloc = Allocator())
+	{
+		this->p_default();
+		this->augmentation = a;
+		this->comparator = c;
+		this->alloc_key = alloc;
+		this->alloc_node = NodeAllocator(alloc);
+	}
+
+	void p_delete() {
+		this->p_del(this->root);
+		this->p_default();
+	}
+
+	void p_copy(AugmentedAVLTree const& other) {
+		this->p_default();
+		this->augmentation = other.augmentation;
+		this->comparator = other.comparator;
+		this->alloc_key = other.alloc_key;
+		this->alloc_node = alloc_node_traits::select_on_container_copy_construction(other.alloc_node);
+		this->root = p_copy(other.root);
+	}
+
+	void p_move(AugmentedAVLTree& other) {
+		this->augmentation = std::move(other.augmentation);
+		this->comparator = std::move(other.comparator);
+		this->alloc_key = std::move(other.alloc_key);
+		this->alloc_node = std::move(other.alloc_node);
+		this->root = other.root;
+		this->_size = other._size;
+
+		other.p_default();
+	}
+
+	void p_swap(AugmentedAVLTree& other) {
+		p_adl_swap(this->augmentation, other.augmentation);
+		p_adl_swap(this->comparator, other.comparator);
+		p_adl_swap(this->alloc_key, other.alloc_key);
+		p_adl_swap(this->alloc_node, other.alloc_node);
+		p_adl_swap(this->root, other.root);
+		p_adl_swap(this->_size, other._size);
+	}
+
+	/**
+	 * @brief Summary of the subtree, the identity if it is empty
+	 */
+	summary_type p_summary(Node const* node) const {
+		if (node == nullptr) return augmentation.identity();
+		else return node->summary;
+	}
+
+	/**
+	 * @brief Recomputes the height and the summary of node from its children
+	 */
+	void p_update(Node* node) {
+		node->height = std::max(core::height(node->left), core::height(node->right)) + 1;
+
+		summary_type summary = augmentation.measure(node->e);
+		if (node->left != nullptr) summary = augmentation.combine(node->left->summary, summary);
+		if (node->right != nullptr) summary = augmentation.combine(summary, node->right->summary);
+		node->summary = std::move(summary);
+	}
+
+	/**
+	 * @brief Walks the path up after an insert or an erase, rebalancing. Unlike AVLTree it
+	 * always goes up to the root, because the summaries of all the ancestors change, so
+	 * the size delta is not needed
+	 */
+	void p_retrace(Node** path[], int depth, int) {
+		for (int i = depth - 1; i >= 0; --i) {
+			*path[i] = core::equil(*this, *path[i]);
+		}
+	}
+
+	void p_erase(Key const& elem) {
+		Node** path[core::MAX_HEIGHT];
+		int depth = 0;
+
+		Node** link = core::find_link(*this, elem, path, depth);
+		Node* node = *link;
+		if (node == nullptr) return;
+
+		core::unlink(link, path, depth);
+		p_destroy(node);
+		p_retrace(path, depth, -1);
+	}
+
+	/** @see avl_core::insert */
+	template<class K>
+	void p_insert(K&& elem) {
+		core::insert(*this, std::forward<K>(elem));
+	}
+
+	template<class ForwardIt>
+	void p_assign_sorted(ForwardIt first, ForwardIt last) {
+		this->p_delete();
+		this->root = core::build(*this, first, std::distance(first, last));
+	}
+
+	friend class sorted_range<Key, Comparator>;
+
+	/** @see sorted_range::assign */
+	template<class ForwardIt>
+	void p_assign(ForwardIt first, ForwardIt last) {
+		sorted_range<Key, Comparator>::assign(*this, first, last, this->comparator);
+	}
+
+	/** @see avl_core::find */
+	Node* p_find(Key const& key) const {
+		return core::find(*this, this->root, key);
+	}
+
+	/**
+	 * @brief Summary of the keys of the subtree not less than lo
+	 */
+	summary_type p_summary_from(Node const* node, Key const& lo) const {
+		summary_type summary = augmentation.identity();
+		while (node != nullptr) {
+			if (comparator(node->e, lo)) {
+				node = node->right;
+			}
+			else {
+				// node and its right subtree go before the keys found until now
+				summary = augmentation.combine(p_summary(node->right), summary);
+				summary = augmentation.combine(augmentation.measure(node->e), summary);
+				node = node->left;
+			}
+		}
+		return summary;
+	}
+
+	/**
+	 * @brief Summary of the keys of the subtree less than hi
+	 */
+	summary_type p_summary_until(Node const* node, Key const& hi) const {
+		summary_type summary = augmentation.identity();
+		while (node != nullptr) {
+			if (comparator(node->e, hi)) {
+				// The left subtree and node go after the keys found until now
+				summary = augmentation.combine(summary, p_summary(node->left));
+				summary = augmentation.combine(summary, augmentation.measure(node->e));
+				node = node->right;
+			}
+			else {
+				node = node->left;
+			}
+		}
+		return summary;
+	}
+
+public:
+
+	/** @see avl_core::iterator */
+	using iterator = typename core::iterator;
+	using const_iterator = iterator;
+
+	/**
+	 * @brief Construct a new AugmentedAVLTree object
+	 * @param a Augmentation to use
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	AugmentedAVLTree(Augmentation const& a = Augmentation(), Comparator const& c = Comparator(),
+		Allocator const& alloc = Allocator())
+	{
+		this->p_new(a, c, alloc);
+	}
+
+	/**
+	 * @brief Construct a new AugmentedAVLTree object with the keys of [first, last).
+	 * Repeated keys are inserted once
+	 * Time complexity: O(n) if the range is sorted, O(n * log(n)) otherwise
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 * @param a Augmentation to use
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	template<class ForwardIt>
+	AugmentedAVLTree(ForwardIt first, ForwardIt last, Augmentation const& a = Augmentation(),
+		Comparator const& c = Comparator(), Allocator const& alloc = Allocator())
+	{
+		this->p_new(a, c, alloc);
+		this->p_assign(first, last);
+	}
+
+	/**
+	 * @brief Construct a new AugmentedAVLTree object by copy
+	 * Time complexity: O(other.size())
+	 * @param other The other tree to copy
+	 */
+	AugmentedAVLTree(AugmentedAVLTree const& other) {
+		this->p_copy(other);
+	}
+
+	/**
+	 * @brief Construct a new AugmentedAVLTree object by move
+	 * Time complexity: O(1)
+	 * @param other The other tree to move
+	 */
+	AugmentedAVLTree(AugmentedAVLTree&& other) noexcept {
+		this->p_move(other);
+	}
+
+	/**
+	 * @brief Destroy the AugmentedAVLTree object
+	 * Time complexity: O(this->size())
+	 */
+	~AugmentedAVLTree() {
+		this->p_delete();
+	}
+
+	/**
+	 * @brief Copy assignment operator
+	 * Time complexity: O(other.size() + this->size())
+	 * @param other The other tree to copy
+	 * @return AugmentedAVLTree& Reference to *this
+	 */
+	AugmentedAVLTree& operator=(AugmentedAVLTree const& other) {
+		if (this != &other) {
+			this->p_delete();
+			this->p_copy(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Move assignment operator
+	 * Time complexity: O(this->size())
+	 * @param other The other tree to move
+	 * @return AugmentedAVLTree& Reference to *this
+	 */
+	AugmentedAVLTree& operator=(AugmentedAVLTree&& other) noexcept {
+		if (this != &other) {
+			this->p_delete();
+			this->p_move(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Swap the two trees
+	 * Time complexity: O(1)
+	 * @param other The other tree
+	 */
+	void swap(AugmentedAVLTree& other) {
+		this->p_swap(other);
+	}
+
+	/**
+	 * @brief Inserts a copy of key, if it is not on the tree
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	void insert(Key const& key) {
+		this->p_insert(key);
+	}
+
+	/**
+	 * @brief Inserts key moving it, if it is not on the tree
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	void insert(Key&& key) {
+		this->p_insert(std::move(key));
+	}
+
+	/**
+	 * @brief Constructs a key on the tree. It is destroyed if it was already on the tree
+	 * Time complexity: O(log(this->size()) + creation)
+	 * @tparam Args Template parameter list, type parameters of the key constructor
+	 * @param args Parameters list of the key constructor
+	 */
+	template<class... Args>
+	void emplace(Args&&... args) {
+		core::insert_node(*this, p_create(std::forward<Args>(args)...));
+	}
+
+	/**
+	 * @brief Erases key, if it is on the tree
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	void erase(Key const& key) {
+		this->p_erase(key);
+	}
+
+	/**
+	 * @brief Replaces the keys of the tree with the keys of [first, last). Repeated keys
+	 * are inserted once
+	 * Time complexity: O(this->size() + n) if the range is sorted,
+	 * O(this->size() + n * log(n)) otherwise
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 */
+	template<class ForwardIt>
+	void assign(ForwardIt first, ForwardIt last) {
+		this->p_assign(first, last);
+	}
+
+	/**
+	 * @brief Replaces the keys of the tree with the keys of [first, last), that must be
+	 * on strictly increasing order
+	 * Time complexity: O(this->size() + n)
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 */
+	template<class ForwardIt>
+	void assign_sorted(ForwardIt first, ForwardIt last) {
+		this->p_assign_sorted(first, last);
+	}
+
+	bool contains(Key const& key) const {
+		return p_find(key) != nullptr;
+	}
+
+	bool count(Key const& key) const {
+		return p_find(key) != nullptr ? 1 : 0;
+	}
+
+	/**
+	 * @brief Iterator to the smallest key
+	 * Time complexity: O(log(this->size()))
+	 */
+	iterator begin() const {
+		return core::begin(root);
+	}
+
+	/**
+	 * @brief Iterator past the greatest key
+	 * Time complexity: O(1)
+	 */
+	iterator end() const {
+		return iterator(root);
+	}
+
+	/**
+	 * @brief Iterator to the first key not less than key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator lower_bound(Key const& key) const {
+		return core::lower_bound(*this, key);
+	}
+
+	/**
+	 * @brief Iterator to the first key greater than key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator upper_bound(Key const& key) const {
+		return core::upper_bound(*this, key);
+	}
+
+	/**
+	 * @brief Iterator to key, or end() if it is not on the tree
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator find(Key const& key) const {
+		return core::find_iterator(*this, key);
+	}
+
+	/**
+	 * @brief Calls f with every key on the half-open range [lo, hi), on increasing order.
+	 * It does not allocate.
+	 * Time complexity: O(log(this->size()) + k), k is the number of keys on the range
+	 * @tparam F Callable with a Key const&
+	 * @param lo Lower bound, included
+	 * @param hi Upper bound, excluded
+	 * @param f Function to call
+	 */
+	template<class F>
+	void for_each_in_range(Key const& lo, Key const& hi, F f) const {
+		for (iterator it = lower_bound(lo); it.depth != 0 && comparator(*it, hi); ++it) {
+			f(*it);
+		}
+	}
+
+	/**
+	 * @brief Summary of all the keys, the identity if the tree is empty
+	 * Time complexity: O(1)
+	 */
+	summary_type summary() const {
+		return p_summary(root);
+	}
+
+	/**
+	 * @brief Summary of the keys on the half-open range [lo, hi)
+	 * Time complexity: O(log(this->size()))
+	 * @param lo Lower bound, included
+	 * @param hi Upper bound, excluded
+	 */
+	summary_type summary(Key const& lo, Key const& hi) const {
+		Node const* node = root;
+		while (node != nullptr) {
+			if (comparator(node->e, lo)) {
+				node = node->right;
+			}
+			else if (!comparator(node->e, hi)) {
+				node = node->left;
+			}
+			else {
+				// The range splits here, on a suffix of the left subtree and a prefix of the right one
+				summary_type summary = augmentation.combine(p_summary_from(node->left, lo),
+					augmentation.measure(node->e));
+				return augmentation.combine(summary, p_summary_until(node->right, hi));
+			}
+		}
+		return augmentation.identity();
+	}
+
+	/**
+	 * @brief Number of elements
+	 * Time complexity: O(1)
+	 */
+	std::size_t size() const {
+		return this->_size;
+	}
+
+	/**
+	 * @brief If the tree is empty
+	 * Time complexity: O(1)
+	 */
+	bool empty() const {
+		return root == nullptr;
+	}
+};
+
+/**
+ * @brief Swaps the two trees
+ * Time complexity: O(1)
+ * This implementation is intended to be found by the ADL algorithm
+ */
+template<typename Key, class Aug, class C, class A>
+void swap(AugmentedAVLTree<Key, Aug, C, A>& lhs, AugmentedAVLTree<Key, Aug, C, A>& rhs) {
+	lhs.swap(rhs);
+}
@@ -0,0 +1,1132 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "SortedRange.hpp"
+
+/**
+ * @brief BPlusTree <br>
+ * Ordered set implemented as a B+ tree. Every node stores an array of keys, so a search
+ * only visits a few wide nodes (a few cache lines each) instead of one node per
+ * comparison. All the keys are on the leaves, which are linked in key order, so
+ * iteration and range scans read the keys sequentially. <br>
+ * Inner nodes store copies of some keys (separators), so Key must be copy constructible. <br>
+ * Keys are ordered by the Comparator. If the Comparator has an is_transparent member type,
+ * the lookups (contains, count, find, lower_bound, upper_bound) accept any type comparable
+ * with Key, without constructing a temporary key <br>
+ * Node allocations are made using the Allocator (rebound to the node types) <br>
+ * @see https://en.wikipedia.org/wiki/B%2B_tree
+ * @tparam Key Elements' type this tree will store
+ * @tparam Comparator Strict weak ordering between keys
+ * @tparam Allocator Keys' allocator
+ * @tparam NodeBytes Approximate size of a node, it sets the number of keys per node (at
+ * least 4)
+ */
+template <typename Key, class Comparator = std::less<Key>, class Allocator = std::allocator<Key>,
+	std::size_t NodeBytes = 512>
+class BPlusTree {
+protected:
+	/**
+	 * @brief Uses the first swap found by the ADL algorithm. <br>
+	 * This should find the user-defined swap before the generic std::swap, that makes
+	 * three moves
+	 * @tparam U Type
+	 * @param left Left object
+	 * @param right Right object
+	 */
+	template<typename U>
+	void p_adl_swap(U& left, U& right) {
+		using std::swap;
+		swap(left, right); // ADL swap
+	}
+
+	struct Node {
+		int size; // Number of keys
+		bool is_leaf;
+	};
+
+	using Slot = typename std::aligned_storage<sizeof(Key), alignof(Key)>::type;
+
+	static const int LEAF_CAPACITY =
+		NodeBytes >= sizeof(Node) + 2 * sizeof(void*) + 4 * sizeof(Key) ?
+		(NodeBytes - sizeof(Node) - 2 * sizeof(void*)) / sizeof(Key) : 4;
+
+	static const int INNER_CAPACITY =
+		NodeBytes >= sizeof(Node) + sizeof(void*) + 4 * (sizeof(Key) + sizeof(void*)) ?
+		(NodeBytes - sizeof(Node) - sizeof(void*)) / (sizeof(Key) + sizeof(void*)) : 4;
+
+	/**
+	 * @brief Minimum number of keys of the nodes, except the root
+	 */
+	static const int LEAF_MIN = LEAF_CAPACITY / 2;
+	static const int INNER_MIN = INNER_CAPACITY / 2;
+
+	/**
+	 * @brief Upper bound of the height of the tree, every inner node but the root has at
+	 * least 3 children
+	 */
+	static const int MAX_DEPTH = 64;
+
+	struct Leaf : Node {
+		Leaf* prev;
+		Leaf* next;
+		Slot keys[LEAF_CAPACITY];
+	};
+
+	struct Inner : Node {
+		Slot keys[INNER_CAPACITY]; // keys[i] separates children[i] and children[i + 1]
+		Node* children[INNER_CAPACITY + 1];
+	};
+
+	using LeafAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Leaf>;
+	using InnerAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Inner>;
+
+	using alloc_key_traits = std::allocator_traits<Allocator>;
+	using alloc_leaf_traits = std::allocator_traits<LeafAllocator>;
+	using alloc_inner_traits = std::allocator_traits<InnerAllocator>;
+
+	Comparator comparator;
+	LeafAllocator alloc_leaf;
+	InnerAllocator alloc_inner;
+	Allocator alloc_key;
+
+	Node* root;
+	Leaf* _first_leaf;
+	Leaf* _last_leaf;
+	std::size_t _size;
+
+	template<class N>
+	static Key* p_keys(N* node) {
+		return reinterpret_cast<Key*>(node->keys);
+	}
+
+	Leaf* p_new_leaf() {
+		Leaf* leaf = alloc_leaf_traits::allocate(alloc_leaf, 1);
+		leaf->size = 0;
+		leaf->is_leaf = true;
+		leaf->prev = nullptr;
+		leaf->next = nullptr;
+		return leaf;
+	}
+
+	Inner* p_new_inner() {
+		Inner* inner = alloc_inner_traits::allocate(alloc_inner, 1);
+		inner->size = 0;
+		inner->is_leaf = false;
+		return inner;
+	}
+
+	void p_destroy_keys(Key* keys, int size) {
+		for (int i = 0; i < size; ++i) {
+			alloc_key_traits::destroy(alloc_key, keys + i);
+		}
+	}
+
+	void p_free_leaf(Leaf* leaf) {
+		p_destroy_keys(p_keys(leaf), leaf->size);
+		alloc_leaf_traits::deallocate(alloc_leaf, leaf, 1);
+	}
+
+	void p_free_inner(Inner* inner) {
+		p_destroy_keys(p_keys(inner), inner->size);
+		alloc_inner_traits::deallocate(alloc_inner, inner, 1);
+	}
+
+	void p_del(Node* node) {
+		if (node == nullptr) return;
+
+		if (node->is_leaf) {
+			p_free_leaf(static_cast<Leaf*>(node));
+		}
+		else {
+			Inner* inner = static_cast<Inner*>(node);
+			for (int i = 0; i <= inner->size; ++i) {
+				p_del(inner->children[i]);
+			}
+			p_free_inner(inner);
+		}
+	}
+
+	/**
+	 * @brief Copies the subtree, linking its leaves after prev
+	 */
+	Node* p_copy(Node* node, Leaf*& prev) {
+		if (node->is_leaf) {
+			Leaf* leaf = static_cast<Leaf*>(node);
+			Leaf* new_leaf = p_new_leaf();
+			for (int i = 0; i < leaf->size; ++i) {
+				alloc_key_traits::construct(alloc_key, p_keys(new_leaf) + i, p_keys(leaf)[i]);
+			}
+			new_leaf->size = leaf->size;
+
+			new_leaf->prev = prev;
+			if (prev != nullptr) prev->next = new_leaf;
+			else this->_first_leaf = new_leaf;
+			prev = new_leaf;
+
+			return new_leaf;
+		}
+		else {
+			Inner* inner = static_cast<Inner*>(node);
+			Inner* new_inner = p_new_inner();
+			for (int i = 0; i < inner->size; ++i) {
+				alloc_key_traits::construct(alloc_key, p_keys(new_inner) + i, p_keys(inner)[i]);
+			}
+			new_inner->size = inner->size;
+			for (int i = 0; i <= inner->size; ++i) {
+				new_inner->children[i] = p_copy(inner->children[i], prev);
+			}
+
+			return new_inner;
+		}
+	}
+
+	void p_default() {
+		this->root = nullptr;
+		this->_first_leaf = nullptr;
+		this->_last_leaf = nullptr;
+		this->_size = 0;
+	}
+
+	void p_new(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_default();
+		this->comparator = c;
+		this->alloc_key = alloc;
+		this->alloc_leaf = LeafAllocator(alloc);
+		this->alloc_inner = InnerAllocator(alloc);
+	}
+
+	void p_delete() {
+		this->p_del(this->root);
+		this->p_default();
+	}
+
+	void p_copy(BPlusTree const& other) {
+		this->comparator = other.comparator;
+		this->alloc_key = other.alloc_key;
+		this->alloc_leaf = alloc_leaf_traits::select_on_container_copy_construction(other.alloc_leaf);
+		this->alloc_inner = alloc_inner_traits::select_on_container_copy_construction(other.alloc_inner);
+		this->p_default();
+
+		if (other.root != nullptr) {
+			Leaf* prev = nullptr;
+			this->root = p_copy(other.root, prev);
+			this->_last_leaf = prev;
+			this->_size = other._size;
+		}
+	}
+
+	void p_move(BPlusTree& other) {
+		this->comparator = std::move(other.comparator);
+		this->alloc_key = std::move(other.alloc_key);
+		this->alloc_leaf = std::move(other.alloc_leaf);
+		this->alloc_inner = std::move(other.alloc_inner);
+		this->root = other.root;
+		this->_first_leaf = other._first_leaf;
+		this->_last_leaf = other._last_leaf;
+		this->_size = other._size;
+
+		other.p_default();
+	}
+
+	void p_swap(BPlusTree& other) {
+		p_adl_swap(this->comparator, other.comparator);
+		p_adl_swap(this->alloc_key, other.alloc_key);
+		p_adl_swap(this->alloc_leaf, other.alloc_leaf);
+		p_adl_swap(this->alloc_inner, other.alloc_inner);
+		p_adl_swap(this->root, other.root);
+		p_adl_swap(this->_first_leaf, other._first_leaf);
+		p_adl_swap(this->_last_leaf, other._last_leaf);
+		p_adl_swap(this->_size, other._size);
+	}
+
+	/**
+	 * @brief Position of the first key not less than key
+	 */
+	template<class K>
+	int p_lower(Key const* keys, int size, K const& key) const {
+		int lo = 0, hi = size;
+		while (lo < hi) {
+			int mid = (lo + hi) / 2;
+			if (comparator(keys[mid], key)) lo = mid + 1;
+			else hi = mid;
+		}
+		return lo;
+	}
+
+	/**
+	 * @brief Position of the first key greater than key
+	 */
+	template<class K>
+	int p_upper(Key const* keys, int size, K const& key) const {
+		int lo = 0, hi = size;
+		while (lo < hi) {
+			int mid = (lo + hi) / 2;
+			if (comparator(key, keys[mid])) hi = mid;
+			else lo = mid + 1;
+		}
+		return lo;
+	}
+
+	/**
+	 * @brief Leaf where key is or would be, the tree must not be empty
+	 */
+	template<class K>
+	Leaf* p_find_leaf(K const& key) const {
+		Node* node = this->root;
+		while (!node->is_leaf) {
+			Inner* inner = static_cast<Inner*>(node);
+			node = inner->children[p_upper(p_keys(inner), inner->size, key)];
+		}
+		return static_cast<Leaf*>(node);
+	}
+
+	/**
+	 * @brief Moves n keys to uninitialized storage of other node
+	 */
+	void p_move_keys(Key* from, int n, Key* to) {
+		for (int i = 0; i < n; ++i) {
+			alloc_key_traits::construct(alloc_key, to + i, std::move(from[i]));
+			alloc_key_traits::destroy(alloc_key, from + i);
+		}
+	}
+
+	/**
+	 * @brief Inserts key on position pos of an array of size keys, with capacity for one
+	 * more
+	 */
+	template<class K>
+	void p_insert_key(Key* keys, int size, int pos, K&& key) {
+		if (pos == size) {
+			alloc_key_traits::construct(alloc_key, keys + size, std::forward<K>(key));
+		}
+		else {
+			alloc_key_traits::construct(alloc_key, keys + size, std::move(keys[size - 1]));
+			std::move_backward(keys + pos, keys + size - 1, keys + size);
+			keys[pos] = std::forward<K>(key);
+		}
+	}
+
+	void p_erase_key(Key* keys, int size, int pos) {
+		std::move(keys + pos + 1, keys + size, keys + pos);
+		alloc_key_traits::destroy(alloc_key, keys + size - 1);
+	}
+
+	static void p_insert_child(Node** children, int size, int pos, Node* child) {
+		std::copy_backward(children + pos, children + size, children + size + 1);
+		children[pos] = child;
+	}
+
+	static void p_erase_child(Node** children, int size, int pos) {
+		std::copy(children + pos + 1, children + size, children + pos);
+	}
+
+	/**
+	 * @brief Inserts the separator and its right child on the parents of a split node,
+	 * splitting them while they are full
+	 * @param path Inner nodes from the root to the split node
+	 * @param index Child followed on every node of path
+	 */
+	void p_insert_up(Inner** path, int* index, int depth, Key separator, Node* child) {
+		while (depth > 0) {
+			--depth;
+			Inner* inner = path[depth];
+			Key* keys = p_keys(inner);
+			int pos = index[depth];
+
+			if (inner->size < INNER_CAPACITY) {
+				p_insert_key(keys, inner->size, pos, std::move(separator));
+				p_insert_child(inner->children, inner->size + 1, pos + 1, child);
+				++inner->size;
+				return;
+			}
+
+			// Both halves keep at least INNER_CAPACITY / 2 keys
+			int half = INNER_CAPACITY / 2;
+			Inner* right = p_new_inner();
+			if (pos == half) {
+				// The new separator goes up, and its child is the first of the new node
+				p_move_keys(keys + half, INNER_CAPACITY - half, p_keys(right));
+				right->children[0] = child;
+				std::copy(inner->children + half + 1, inner->children + INNER_CAPACITY + 1, right->children + 1);
+				inner->size = half;
+				right->size = INNER_CAPACITY - half;
+			}
+			else {
+				// The middle key goes up, the keys after it go to the new node
+				int m = pos < half ? half - 1 : half;
+				Key up(std::move(keys[m]));
+				alloc_key_traits::destroy(alloc_key, keys + m);
+				p_move_keys(keys + m + 1, INNER_CAPACITY - m - 1, p_keys(right));
+				std::copy(inner->children + m + 1, inner->children + INNER_CAPACITY + 1, right->children);
+				inner->size = m;
+				right->size = INNER_CAPACITY - m - 1;
+
+				if (pos <= m) {
+					p_insert_key(keys, inner->size, pos, std::move(separator));
+					p_insert_child(inner->children, inner->size + 1, pos + 1, child);
+					++inner->size;
+				}
+				else {
+					p_insert_key(p_keys(right), right->size, pos - m - 1, std::move(separator));
+					p_insert_child(right->children, right->size + 1, pos - m, child);
+					++right->size;
+				}
+
+				separator = std::move(up);
+			}
+
+			child = right;
+		}
+
+		// The root was split
+		Inner* new_root = p_new_inner();
+		alloc_key_traits::construct(alloc_key, p_keys(new_root), std::move(separator));
+		new_root->children[0] = this->root;
+		new_root->children[1] = child;
+		new_root->size = 1;
+		this->root = new_root;
+	}
+
+	/**
+	 * @brief Inserts the key, if it is not on the tree
+	 * @tparam K Key const& or Key&&
+	 */
+	template<class K>
+	void p_insert(K&& key) {
+		if (this->root == nullptr) {
+			Leaf* leaf = p_new_leaf();
+			alloc_key_traits::construct(alloc_key, p_keys(leaf), std::forward<K>(key));
+			leaf->size = 1;
+			this->root = this->_first_leaf = this->_last_leaf = leaf;
+			this->_size = 1;
+			return;
+		}
+
+		Inner* path[MAX_DEPTH];
+		int index[MAX_DEPTH];
+		int depth = 0;
+
+		Node* node = this->root;
+		while (!node->is_leaf) {
+			Inner* inner = static_cast<Inner*>(node);
+			int i = p_upper(p_keys(inner), inner->size, key);
+			path[depth] = inner;
+			index[depth] = i;
+			++depth;
+			node = inner->children[i];
+		}
+
+		Leaf* leaf = static_cast<Leaf*>(node);
+		Key* keys = p_keys(leaf);
+		int pos = p_lower(keys, leaf->size, key);
+		if (pos < leaf->size && !comparator(key, keys[pos])) return;
+
+		++this->_size;
+		if (leaf->size < LEAF_CAPACITY) {
+			p_insert_key(keys, leaf->size, pos, std::forward<K>(key));
+			++leaf->size;
+			return;
+		}
+
+		// The second half of the keys goes to a new leaf
+		int m = LEAF_CAPACITY / 2;
+		Leaf* right = p_new_leaf();
+		p_move_keys(keys + m, LEAF_CAPACITY - m, p_keys(right));
+		leaf->size = m;
+		right->size = LEAF_CAPACITY - m;
+
+		right->prev = leaf;
+		right->next = leaf->next;
+		if (leaf->next != nullptr) leaf->next->prev = right;
+		else this->_last_leaf = right;
+		leaf->next = right;
+
+		if (pos <= m) {
+			p_insert_key(keys, leaf->size, pos, std::forward<K>(key));
+			++leaf->size;
+		}
+		else {
+			p_insert_key(p_keys(right), right->size, pos - m, std::forward<K>(key));
+			++right->size;
+		}
+
+		p_insert_up(path, index, depth, p_keys(right)[0], right);
+	}
+
+	/**
+	 * @brief Merges the leaf children[k + 1] of parent into children[k]
+	 */
+	void p_merge_leaves(Leaf* left, Leaf* right, Inner* parent, int k) {
+		p_move_keys(p_keys(right), right->size, p_keys(left) + left->size);
+		left->size += right->size;
+		right->size = 0;
+
+		left->next = right->next;
+		if (right->next != nullptr) right->next->prev = left;
+		else this->_last_leaf = left;
+		p_free_leaf(right);
+
+		p_erase_key(p_keys(parent), parent->size, k);
+		p_erase_child(parent->children, parent->size + 1, k + 1);
+		--parent->size;
+	}
+
+	/**
+	 * @brief Merges the inner node children[k + 1] of parent into children[k], the
+	 * separator between them goes down
+	 */
+	void p_merge_inner(Inner* left, Inner* right, Inner* parent, int k) {
+		Key* keys = p_keys(left);
+		alloc_key_traits::construct(alloc_key, keys + left->size, std::move(p_keys(parent)[k]));
+		p_move_keys(p_keys(right), right->size, keys + left->size + 1);
+		std::copy(right->children, right->children + right->size + 1, left->children + left->size + 1);
+		left->size += right->size + 1;
+		right->size = 0;
+		p_free_inner(right);
+
+		p_erase_key(p_keys(parent), parent->size, k);
+		p_erase_child(parent->children, parent->size + 1, k + 1);
+		--parent->size;
+	}
+
+	/**
+	 * @brief Fixes the leaf children[i] of parent, that has less than LEAF_MIN keys. It
+	 * borrows a key from a sibling or it is merged with it
+	 */
+	void p_fix_leaf(Leaf* leaf, Inner* parent, int i) {
+		Key* separators = p_keys(parent);
+
+		if (i > 0) {
+			Leaf* left = static_cast<Leaf*>(parent->children[i - 1]);
+			if (left->size > LEAF_MIN) {
+				Key* left_keys = p_keys(left);
+				p_insert_key(p_keys(leaf), leaf->size, 0, std::move(left_keys[left->size - 1]));
+				++leaf->size;
+				alloc_key_traits::destroy(alloc_key, left_keys + left->size - 1);
+				--left->size;
+				separators[i - 1] = p_keys(leaf)[0];
+			}
+			else {
+				p_merge_leaves(left, leaf, parent, i - 1);
+			}
+		}
+		else {
+			Leaf* right = static_cast<Leaf*>(parent->children[i + 1]);
+			if (right->size > LEAF_MIN) {
+				Key* right_keys = p_keys(right);
+				alloc_key_traits::construct(alloc_key, p_keys(leaf) + leaf->size, std::move(right_keys[0]));
+				++leaf->size;
+				p_erase_key(right_keys, right->size, 0);
+				--right->size;
+				separators[i] = right_keys[0];
+			}
+			else {
+				p_merge_leaves(leaf, right, parent, i);
+			}
+		}
+	}
+
+	/**
+	 * @brief Fixes the inner node children[i] of parent, that has less than INNER_MIN
+	 * keys. It borrows a child from a sibling (rotating the separator through the parent)
+	 * or it is merged with it
+	 */
+	void p_fix_inner(Inner* inner, Inner* parent, int i) {
+		Key* separators = p_keys(parent);
+		Key* keys = p_keys(inner);
+
+		if (i > 0) {
+			Inner* left = static_cast<Inner*>(parent->children[i - 1]);
+			if (left->size > INNER_MIN) {
+				Key* left_keys = p_keys(left);
+				p_insert_key(keys, inner->size, 0, std::move(separators[i - 1]));
+				p_insert_child(inner->children, inner->size + 1, 0, left->children[left->size]);
+				++inner->size;
+				separators[i - 1] = std::move(left_keys[left->size - 1]);
+				alloc_key_traits::destroy(alloc_key, left_keys + left->size - 1);
+				--left->size;
+			}
+			else {
+				p_merge_inner(left, inner, parent, i - 1);
+			}
+		}
+		else {
+			Inner* right = static_cast<Inner*>(parent->children[i + 1]);
+			if (right->size > INNER_MIN) {
+				Key* right_keys = p_keys(right);
+				alloc_key_traits::construct(alloc_key, keys + inner->size, std::move(separators[i]));
+				inner->children[inner->size + 1] = right->children[0];
+				++inner->size;
+				separators[i] = std::move(right_keys[0]);
+				p_erase_key(right_keys, right->size, 0);
+				p_erase_child(right->children, right->size + 1, 0);
+				--right->size;
+			}
+			else {
+				p_merge_inner(inner, right, parent, i);
+			}
+		}
+	}
+
+	void p_erase(Key const& key) {
+		if (this->root == nullptr) return;
+
+		Inner* path[MAX_DEPTH];
+		int index[MAX_DEPTH];
+		int depth = 0;
+
+		Node* node = this->root;
+		while (!node->is_leaf) {
+			Inner* inner = static_cast<Inner*>(node);
+			int i = p_upper(p_keys(inner), inner->size, key);
+			path[depth] = inner;
+			index[depth] = i;
+			++depth;
+			node = inner->children[i];
+		}
+
+		Leaf* leaf = static_cast<Leaf*>(node);
+		Key* keys = p_keys(leaf);
+		int pos = p_lower(keys, leaf->size, key);
+		if (pos == leaf->size || comparator(key, keys[pos])) return;
+
+		p_erase_key(keys, leaf->size, pos);
+		--leaf->size;
+		--this->_size;
+
+		if (depth == 0) {
+			if (leaf->size == 0) {
+				p_free_leaf(leaf);
+				this->p_default();
+			}
+			return;
+		}
+
+		if (leaf->size >= LEAF_MIN) return;
+		p_fix_leaf(leaf, path[depth - 1], index[depth - 1]);
+
+		// Merges remove a key from the parent, that can underflow too
+		for (int d = depth - 1; d > 0 && path[d]->size < INNER_MIN; --d) {
+			p_fix_inner(path[d], path[d - 1], index[d - 1]);
+		}
+
+		Inner* top = static_cast<Inner*>(this->root);
+		if (top->size == 0) {
+			this->root = top->children[0];
+			p_free_inner(top);
+		}
+	}
+
+	/**
+	 * @brief Builds the tree level by level. Leaves are filled up and created on key
+	 * order, so they are allocated one after the other
+	 */
+	template<class ForwardIt>
+	void p_assign_sorted(ForwardIt first, ForwardIt last) {
+		this->p_delete();
+
+		std::size_t n = std::distance(first, last);
+		if (n == 0) return;
+
+		std::size_t leaves = (n + LEAF_CAPACITY - 1) / LEAF_CAPACITY;
+		std::vector<Node*> level;
+		std::vector<Key const*> mins; // First key of every subtree of level
+		level.reserve(leaves);
+		mins.reserve(leaves);
+
+		Leaf* prev = nullptr;
+		for (std::size_t i = 0; i < leaves; ++i) {
+			int count = n / leaves + (i < n % leaves ? 1 : 0);
+			Leaf* leaf = p_new_leaf();
+			for (int j = 0; j < count; ++j, ++first) {
+				alloc_key_traits::construct(alloc_key, p_keys(leaf) + j, *first);
+			}
+			leaf->size = count;
+
+			leaf->prev = prev;
+			if (prev != nullptr) prev->next = leaf;
+			else this->_first_leaf = leaf;
+			prev = leaf;
+
+			level.push_back(leaf);
+			mins.push_back(p_keys(leaf));
+		}
+		this->_last_leaf = prev;
+		this->_size = n;
+
+		while (level.size() > 1) {
+			std::size_t m = level.size();
+			std::size_t groups = (m + INNER_CAPACITY) / (INNER_CAPACITY + 1);
+			std::vector<Node*> up;
+			std::vector<Key const*> up_mins;
+			up.reserve(groups);
+			up_mins.reserve(groups);
+
+			std::size_t next = 0;
+			for (std::size_t g = 0; g < groups; ++g) {
+				int count = m / groups + (g < m % groups ? 1 : 0);
+				Inner* inner = p_new_inner();
+				for (int j = 0; j < count; ++j) {
+					inner->children[j] = level[next + j];
+					if (j > 0) {
+						alloc_key_traits::construct(alloc_key, p_keys(inner) + j - 1, *mins[next + j]);
+					}
+				}
+				inner->size = count - 1;
+
+				up.push_back(inner);
+				up_mins.push_back(mins[next]);
+				next += count;
+			}
+
+			level.swap(up);
+			mins.swap(up_mins);
+		}
+
+		this->root = level[0];
+	}
+
+	friend class sorted_range<Key, Comparator>;
+
+	/** @see sorted_range::assign */
+	template<class ForwardIt>
+	void p_assign(ForwardIt first, ForwardIt last) {
+		sorted_range<Key, Comparator>::assign(*this, first, last, this->comparator);
+	}
+
+	template<class K>
+	bool p_contains(K const& key) const {
+		if (this->root == nullptr) return false;
+
+		Leaf* leaf = p_find_leaf(key);
+		Key const* keys = p_keys(leaf);
+		int pos = p_lower(keys, leaf->size, key);
+		return pos < leaf->size && !comparator(key, keys[pos]);
+	}
+
+public:
+
+	/**
+	 * @brief Bidirectional iterator over the keys, on increasing order. It walks the
+	 * linked leaves, so it is a leaf and a position on it. <br>
+	 * Any insert or erase invalidates all the iterators.
+	 */
+	class iterator {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = Key;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Key const*;
+		using reference = Key const&;
+
+	private:
+		friend class BPlusTree;
+
+		Leaf* leaf; // end() has no leaf
+		int index;
+		Leaf* last; // To go back from end()
+
+		iterator(Leaf* leaf, int index, Leaf* last) : leaf(leaf), index(index), last(last) {}
+
+	public:
+		iterator() : leaf(nullptr), index(0), last(nullptr) {}
+
+		reference operator*() const {
+			return p_keys(leaf)[index];
+		}
+
+		pointer operator->() const {
+			return p_keys(leaf) + index;
+		}
+
+		/**
+		 * @brief Next key
+		 * Time complexity: O(1)
+		 */
+		iterator& operator++() {
+			if (++index == leaf->size) {
+				leaf = leaf->next;
+				index = 0;
+			}
+			return *this;
+		}
+
+		iterator operator++(int) {
+			iterator it(*this);
+			++*this;
+			return it;
+		}
+
+		/**
+		 * @brief Previous key
+		 * Time complexity: O(1)
+		 */
+		iterator& operator--() {
+			if (leaf == nullptr) {
+				leaf = last;
+				index = leaf->size - 1;
+			}
+			else if (index == 0) {
+				leaf = leaf->prev;
+				index = leaf->size - 1;
+			}
+			else --index;
+			return *this;
+		}
+
+		iterator operator--(int) {
+			iterator it(*this);
+			--*this;
+			return it;
+		}
+
+		bool operator==(iterator const& other) const {
+			return leaf == other.leaf && index == other.index;
+		}
+
+		bool operator!=(iterator const& other) const {
+			return !(*this == other);
+		}
+	};
+
+	using const_iterator = iterator;
+
+protected:
+	template<class K>
+	iterator p_lower_bound(K const& key) const {
+		if (this->root == nullptr) return end();
+
+		Leaf* leaf = p_find_leaf(key);
+		int pos = p_lower(p_keys(leaf), leaf->size, key);
+		if (pos == leaf->size) return iterator(leaf->next, 0, this->_last_leaf);
+		return iterator(leaf, pos, this->_last_leaf);
+	}
+
+	template<class K>
+	iterator p_upper_bound(K const& key) const {
+		if (this->root == nullptr) return end();
+
+		Leaf* leaf = p_find_leaf(key);
+		int pos = p_upper(p_keys(leaf), leaf->size, key);
+		if (pos == leaf->size) return iterator(leaf->next, 0, this->_last_leaf);
+		return iterator(leaf, pos, this->_last_leaf);
+	}
+
+	template<class K>
+	iterator p_find_iterator(K const& key) const {
+		iterator it = p_lower_bound(key);
+		if (it != end() && comparator(key, *it)) return end();
+		return it;
+	}
+
+public:
+
+	/**
+	 * @brief Construct a new BPlusTree object
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	BPlusTree(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_new(c, alloc);
+	}
+
+	/**
+	 * @brief Construct a new BPlusTree object with the keys of [first, last). Repeated
+	 * keys are inserted once
+	 * Time complexity: O(n) if the range is sorted, O(n * log(n)) otherwise
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	template<class ForwardIt>
+	BPlusTree(ForwardIt first, ForwardIt last, Comparator const& c = Comparator(),
+		Allocator const& alloc = Allocator())
+	{
+		this->p_new(c, alloc);
+		this->p_assign(first, last);
+	}
+
+	/**
+	 * @brief Construct a new BPlusTree object by copy
+	 * Time complexity: O(other.size())
+	 * @param other The other tree to copy
+	 */
+	BPlusTree(BPlusTree const& other) {
+		this->p_copy(other);
+	}
+
+	/**
+	 * @brief Construct a new BPlusTree object by move
+	 * Time complexity: O(1)
+	 * @param other The other tree to move
+	 */
+	BPlusTree(BPlusTree&& other) noexcept {
+		this->p_move(other);
+	}
+
+	/**
+	 * @brief Destroy the BPlusTree object
+	 * Time complexity: O(this->size())
+	 */
+	~BPlusTree() {
+		this->p_delete();
+	}
+
+	/**
+	 * @brief Copy assignment operator
+	 * Time complexity: O(other.size() + this->size())
+	 * @param other The other tree to copy
+	 * @return BPlusTree& Reference to *this
+	 */
+	BPlusTree& operator=(BPlusTree const& other) {
+		if (this != &other) {
+			this->p_delete();
+			this->p_copy(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Move assignment operator
+	 * Time complexity: O(this->size())
+	 * @param other The other tree to move
+	 * @return BPlusTree& Reference to *this
+	 */
+	BPlusTree& operator=(BPlusTree&& other) noexcept {
+		if (this != &other) {
+			this->p_delete();
+			this->p_move(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Swap the two trees
+	 * Time complexity: O(1)
+	 * @param other The other tree
+	 */
+	void swap(BPlusTree& other) {
+		this->p_swap(other);
+	}
+
+	/**
+	 * @brief Inserts a copy of key, if it is not on the tree
+	 * Time complexity: O(log(this->size()) * NodeBytes / sizeof(Key))
+	 * @param key The key
+	 */
+	void insert(Key const& key) {
+		this->p_insert(key);
+	}
+
+	/**
+	 * @brief Inserts key, moving it, if it is not on the tree
+	 * Time complexity: O(log(this->size()) * NodeBytes / sizeof(Key))
+	 * @param key The key
+	 */
+	void insert(Key&& key) {
+		this->p_insert(std::move(key));
+	}
+
+	/**
+	 * @brief Constructs a key and inserts it, if it is not on the tree
+	 * Time complexity: O(log(this->size()) * NodeBytes / sizeof(Key) + creation)
+	 * @tparam Args Template parameter list, type parameters of the key constructor
+	 * @param args Parameters list of the key constructor
+	 */
+	template<class... Args>
+	void emplace(Args&&... args) {
+		this->p_insert(Key(std::forward<Args>(args)...));
+	}
+
+	/**
+	 * @brief Erases key, if it is on the tree
+	 * Time complexity: O(log(this->size()) * NodeBytes / sizeof(Key))
+	 * @param key The key
+	 */
+	void erase(Key const& key) {
+		this->p_erase(key);
+	}
+
+	/**
+	 * @brief Replaces the keys of the tree with the keys of [first, last). Repeated keys
+	 * are inserted once
+	 * Time complexity: O(this->size() + n) if the range is sorted,
+	 * O(this->size() + n * log(n)) otherwise
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 */
+	template<class ForwardIt>
+	void assign(ForwardIt first, ForwardIt last) {
+		this->p_assign(first, last);
+	}
+
+	/**
+	 * @brief Replaces the keys of the tree with the keys of [first, last), that must be
+	 * on strictly increasing order. The leaves are filled up
+	 * Time complexity: O(this->size() + n)
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 */
+	template<class ForwardIt>
+	void assign_sorted(ForwardIt first, ForwardIt last) {
+		this->p_assign_sorted(first, last);
+	}
+
+	/**
+	 * @brief If key is on the tree
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	bool contains(Key const& key) const {
+		return this->p_contains(key);
+	}
+
+	/**
+	 * @brief contains for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	bool contains(K const& key) const {
+		return this->p_contains(key);
+	}
+
+	bool count(Key const& key) const {
+		return this->p_contains(key) ? 1 : 0;
+	}
+
+	/**
+	 * @brief count for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	bool count(K const& key) const {
+		return this->p_contains(key) ? 1 : 0;
+	}
+
+	/**
+	 * @brief Iterator to the smallest key
+	 * Time complexity: O(1)
+	 */
+	iterator begin() const {
+		return iterator(this->_first_leaf, 0, this->_last_leaf);
+	}
+
+	/**
+	 * @brief Iterator past the greatest key
+	 * Time complexity: O(1)
+	 */
+	iterator end() const {
+		return iterator(nullptr, 0, this->_last_leaf);
+	}
+
+	/**
+	 * @brief Iterator to key, or end() if it is not on the tree
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator find(Key const& key) const {
+		return p_find_iterator(key);
+	}
+
+	/**
+	 * @brief find for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	iterator find(K const& key) const {
+		return p_find_iterator(key);
+	}
+
+	/**
+	 * @brief Iterator to the first key not less than key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator lower_bound(Key const& key) const {
+		return p_lower_bound(key);
+	}
+
+	/**
+	 * @brief lower_bound for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	iterator lower_bound(K const& key) const {
+		return p_lower_bound(key);
+	}
+
+	/**
+	 * @brief Iterator to the first key greater than key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator upper_bound(Key const& key) const {
+		return p_upper_bound(key);
+	}
+
+	/**
+	 * @brief upper_bound for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	iterator upper_bound(K const& key) const {
+		return p_upper_bound(key);
+	}
+
+	/**
+	 * @brief Calls f(key) for every key on [lo, hi), on increasing order. The keys are
+	 * read leaf by leaf
+	 * Time complexity: O(log(this->size()) + k), k is the number of keys on the range
+	 * @param lo First key of the range
+	 * @param hi Key past the range
+	 * @param f Function to call
+	 */
+	template<class F>
+	void for_each_in_range(Key const& lo, Key const& hi, F f) const {
+		if (this->root == nullptr) return;
+
+		Leaf* leaf = p_find_leaf(lo);
+		int pos = p_lower(p_keys(leaf), leaf->size, lo);
+		for (; leaf != nullptr; leaf = leaf->next, pos = 0) {
+			Key const* keys = p_keys(leaf);
+			for (; pos < leaf->size; ++pos) {
+				if (!comparator(keys[pos], hi)) return;
+				f(keys[pos]);
+			}
+		}
+	}
+
+	/**
+	 * @brief Number of keys
+	 * Time complexity: O(1)
+	 */
+	std::size_t size() const {
+		return this->_size;
+	}
+
+	/**
+	 * @brief If the tree is empty
+	 * Time complexity: O(1)
+	 */
+	bool empty() const {
+		return this->_size == 0;
+	}
+};
+
+/**
+ * @brief Time complexity: O(1)
+ * ADL finds this swap
+ */
+template<typename Key, class C, class A, std::size_t N>
+void swap(BPlusTree<Key, C, A, N>& lhs, BPlusTree<Key, C, A, N>& rhs) {
+	lhs.swap(rhs);
+}
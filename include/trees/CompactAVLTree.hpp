@@ -0,0 +1,1138 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "SortedRange.hpp"
+
+/**
+ * @brief CompactAVLTree <br>
+ * Same algorithm as AVLTree, with a smaller node layout for big trees of small keys:
+ * - Nodes live in a contiguous pool and are linked by 32-bit indices instead of pointers.
+ * - The height is stored in one byte (an AVL tree of 2^32 nodes is not higher than 46).
+ * - The size of every subtree is only stored if Cardinals is true, and only then the
+ *   tree has order statistics (select, rank, count_range).
+ *
+ * A node of a 4 or 8 byte key takes 16 or 24 bytes (20 or 24 with Cardinals), instead of
+ * the 32 bytes of AVLTree. The pool grows by doubling, use reserve to avoid the copies
+ * when the size is known. Trees built from a range have their nodes on key order on the
+ * pool. <br>
+ * Keys are ordered by the Comparator, see AVLTree <br>
+ * Pool allocations are made using the Allocator (rebound to the node type) <br>
+ * @see https://en.wikipedia.org/wiki/AVL_tree
+ * @tparam Key Elements' type this tree will store
+ * @tparam Comparator Strict weak ordering between keys
+ * @tparam Allocator Keys' allocator
+ * @tparam Cardinals If the nodes store the size of their subtrees
+ */
+template <typename Key, class Comparator = std::less<Key>, class Allocator = std::allocator<Key>,
+	bool Cardinals = false>
+class CompactAVLTree {
+protected:
+	/**
+	 * @brief Uses the first swap found by the ADL algorithm. <br>
+	 * This should find the user-defined swap before the generic std::swap, that makes
+	 * three moves
+	 * @tparam U Type
+	 * @param left Left object
+	 * @param right Right object
+	 */
+	template<typename U>
+	void p_adl_swap(U& left, U& right) {
+		using std::swap;
+		swap(left, right); // ADL swap
+	}
+
+	using index_type = std::uint32_t;
+
+	static const index_type NIL = std::numeric_limits<index_type>::max();
+
+	static const std::uint8_t FREE = 0; // 'height' of an unused slot of the pool
+
+	/**
+	 * @brief Upper bound of the height of the tree, AVL trees of 2^32 nodes are not
+	 * higher than 1.44 * 32
+	 */
+	static const int MAX_HEIGHT = 48;
+
+	/**
+	 * @brief Node of the tree. Free slots of the pool are chained through 'left'.
+	 */
+	template<bool HasCardinal, class Dummy = void>
+	struct NodeType {
+		Key e;
+		index_type left;
+		index_type right;
+
+		std::uint8_t height;
+
+		index_type get_cardinal() const { return 0; }
+		void set_cardinal(index_type) {}
+	};
+
+	/**
+	 * @brief Node that also stores the size of its subtree
+	 */
+	template<class Dummy>
+	struct NodeType<true, Dummy> {
+		Key e;
+		index_type left;
+		index_type right;
+
+		index_type cardinal;
+		std::uint8_t height;
+
+		index_type get_cardinal() const { return cardinal; }
+		void set_cardinal(index_type value) { cardinal = value; }
+	};
+
+	using Node = NodeType<Cardinals>;
+
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+
+	using alloc_key_traits = std::allocator_traits<Allocator>;
+	using alloc_node_traits = std::allocator_traits<NodeAllocator>;
+
+	NodeAllocator alloc_node;
+	Allocator alloc_key;
+	Comparator comparator;
+
+	Node* nodes;
+	index_type _capacity;
+	index_type free_head;
+
+	index_type root;
+	std::size_t _size;
+
+	Node& p_node(index_type i) {
+		return this->nodes[i];
+	}
+
+	Node const& p_node(index_type i) const {
+		return this->nodes[i];
+	}
+
+	int p_height(index_type i) const {
+		if (i == NIL) return 0;
+		else return p_node(i).height;
+	}
+
+	std::size_t p_cardinal(index_type i) const {
+		if (i == NIL) return 0;
+		else return p_node(i).get_cardinal();
+	}
+
+	/**
+	 * @brief Recomputes the height (and the cardinal) of node from its children
+	 */
+	void p_update(index_type i) {
+		Node& node = p_node(i);
+		node.height = (std::uint8_t)(std::max(p_height(node.left), p_height(node.right)) + 1);
+		if (Cardinals) {
+			node.set_cardinal((index_type)(1 + p_cardinal(node.left) + p_cardinal(node.right)));
+		}
+	}
+
+	/**
+	 * @brief Moves the pool to a new array of new_capacity slots. Indices do not change. <br>
+	 * Time complexity: O(this->_capacity)
+	 */
+	void p_reallocate(std::size_t new_capacity) {
+		Node* new_nodes = alloc_node_traits::allocate(alloc_node, new_capacity);
+		for (index_type i = 0; i < this->_capacity; ++i) {
+			Node& from = this->nodes[i];
+			Node& to = new_nodes[i];
+			if (from.height != FREE) {
+				alloc_key_traits::construct(alloc_key, &to.e, std::move(from.e));
+				alloc_key_traits::destroy(alloc_key, &from.e);
+				to.set_cardinal(from.get_cardinal());
+			}
+			to.left = from.left;
+			to.right = from.right;
+			to.height = from.height;
+		}
+
+		// The new slots go to the front of the free list, on index order
+		for (std::size_t i = this->_capacity; i < new_capacity; ++i) {
+			new_nodes[i].height = FREE;
+			new_nodes[i].right = NIL;
+			new_nodes[i].left = i + 1 < new_capacity ? (index_type)(i + 1) : this->free_head;
+		}
+		if (new_capacity > this->_capacity) this->free_head = this->_capacity;
+
+		if (this->nodes != nullptr) {
+			alloc_node_traits::deallocate(alloc_node, this->nodes, this->_capacity);
+		}
+		this->nodes = new_nodes;
+		this->_capacity = (index_type)new_capacity;
+	}
+
+	/**
+	 * @brief Makes room for n nodes
+	 * Time complexity: O(this->_capacity)
+	 */
+	void p_reserve(std::size_t n) {
+		if (n <= this->_capacity) return;
+		if (n >= NIL) throw std::length_error("CompactAVLTree is full"); // NIL itself is never a valid index
+		p_reallocate(n);
+	}
+
+	/**
+	 * @brief Makes sure that the next p_create does not move the pool, so indices and
+	 * pointers to nodes stay valid until then
+	 * Time complexity: O(this->_capacity) when it grows, O(1) amortized
+	 */
+	void p_ensure_free() {
+		if (this->free_head != NIL) return;
+
+		std::size_t new_capacity = this->_capacity == 0 ? 16 : 2 * (std::size_t)this->_capacity;
+		if (new_capacity >= NIL) new_capacity = NIL - 1;
+		p_reserve(new_capacity);
+		if (this->free_head == NIL) throw std::length_error("CompactAVLTree is full");
+	}
+
+	template<class... Args>
+	index_type p_create(Args&&... args) {
+		p_ensure_free();
+
+		index_type i = this->free_head;
+		Node& node = p_node(i);
+		alloc_key_traits::construct(alloc_key, &node.e, std::forward<Args>(args)...);
+		this->free_head = node.left;
+
+		node.left = NIL;
+		node.right = NIL;
+		node.height = 1;
+		node.set_cardinal(1);
+		++this->_size;
+
+		return i;
+	}
+
+	/**
+	 * @brief Destroys the key of a node and returns its slot to the pool
+	 */
+	void p_destroy(index_type i) {
+		Node& node = p_node(i);
+		alloc_key_traits::destroy(alloc_key, &node.e);
+		node.height = FREE;
+		node.left = this->free_head;
+		this->free_head = i;
+		--this->_size;
+	}
+
+	void p_default() {
+		this->nodes = nullptr;
+		this->_capacity = 0;
+		this->free_head = NIL;
+		this->root = NIL;
+		this->_size = 0;
+	}
+
+	void p_new(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_default();
+		this->comparator = c;
+		this->alloc_key = alloc;
+		this->alloc_node = NodeAllocator(alloc);
+	}
+
+	/**
+	 * @brief Destroys every key and deallocates the pool. <br>
+	 * Time complexity: O(1) if Key is trivially destructible, O(this->_capacity) otherwise
+	 */
+	void p_delete() {
+		if (!std::is_trivially_destructible<Key>::value) {
+			for (index_type i = 0; i < this->_capacity; ++i) {
+				if (this->nodes[i].height != FREE) {
+					alloc_key_traits::destroy(alloc_key, &this->nodes[i].e);
+				}
+			}
+		}
+		if (this->nodes != nullptr) {
+			alloc_node_traits::deallocate(alloc_node, this->nodes, this->_capacity);
+		}
+		this->p_default();
+	}
+
+	/**
+	 * @brief Copies the whole pool, indices do not change <br>
+	 * Time complexity: O(other._capacity)
+	 */
+	void p_copy(CompactAVLTree const& other) {
+		this->comparator = other.comparator;
+		this->alloc_key = other.alloc_key;
+		this->alloc_node = alloc_node_traits::select_on_container_copy_construction(other.alloc_node);
+		this->p_default();
+
+		if (other._capacity == 0) return;
+
+		this->nodes = alloc_node_traits::allocate(alloc_node, other._capacity);
+		this->_capacity = other._capacity;
+		for (index_type i = 0; i < other._capacity; ++i) {
+			Node const& from = other.nodes[i];
+			Node& to = this->nodes[i];
+			if (from.height != FREE) {
+				alloc_key_traits::construct(alloc_key, &to.e, from.e);
+				to.set_cardinal(from.get_cardinal());
+			}
+			to.left = from.left;
+			to.right = from.right;
+			to.height = from.height;
+		}
+
+		this->free_head = other.free_head;
+		this->root = other.root;
+		this->_size = other._size;
+	}
+
+	void p_move(CompactAVLTree& other) {
+		this->comparator = std::move(other.comparator);
+		this->alloc_key = std::move(other.alloc_key);
+		this->alloc_node = std::move(other.alloc_node);
+
+		this->nodes = other.nodes;
+		this->_capacity = other._capacity;
+		this->free_head = other.free_head;
+		this->root = other.root;
+		this->_size = other._size;
+
+		other.p_default();
+	}
+
+	void p_swap(CompactAVLTree& other) {
+		p_adl_swap(this->comparator, other.comparator);
+		p_adl_swap(this->alloc_key, other.alloc_key);
+		p_adl_swap(this->alloc_node, other.alloc_node);
+		p_adl_swap(this->nodes, other.nodes);
+		p_adl_swap(this->_capacity, other._capacity);
+		p_adl_swap(this->free_head, other.free_head);
+		p_adl_swap(this->root, other.root);
+		p_adl_swap(this->_size, other._size);
+	}
+
+	/**
+	 * @brief Rotations only relink nodes, keys are never copied nor moved
+	 */
+	index_type p_rotateRight(index_type i) {
+		index_type l = p_node(i).left;
+		p_node(i).left = p_node(l).right;
+		p_node(l).right = i;
+
+		p_update(i);
+		p_update(l);
+		return l;
+	}
+
+	index_type p_rotateLeft(index_type i) {
+		index_type r = p_node(i).right;
+		p_node(i).right = p_node(r).left;
+		p_node(r).left = i;
+
+		p_update(i);
+		p_update(r);
+		return r;
+	}
+
+	/**
+	 * @brief Restores the AVL property on node, whose subtrees are AVL trees whose
+	 * heights differ at most by 2
+	 * @return index_type New root of the subtree
+	 */
+	index_type p_equil(index_type i) {
+		p_update(i);
+
+		Node& node = p_node(i);
+		if (p_height(node.left) == p_height(node.right) + 2) {
+			if (p_height(p_node(node.left).left) < p_height(p_node(node.left).right)) {
+				node.left = p_rotateLeft(node.left);
+			}
+			return p_rotateRight(i);
+		}
+		else if (p_height(node.left) + 2 == p_height(node.right)) {
+			if (p_height(p_node(node.right).right) < p_height(p_node(node.right).left)) {
+				node.right = p_rotateRight(node.right);
+			}
+			return p_rotateLeft(i);
+		}
+		else return i;
+	}
+
+	/**
+	 * @brief Searches the key, saving on path the links (pointers to the index on the
+	 * parent, or to root) of the nodes above it. One comparison per level, the equality
+	 * is checked at the end. The links are pointers into the pool, so it must not move
+	 * while they are used
+	 * @return index_type* Link where the key is, or where it would be inserted
+	 */
+	index_type* p_find_link(Key const& key, index_type* path[], int& depth) {
+		index_type* link = &this->root;
+		index_type* candidate = nullptr;
+		int candidate_depth = 0;
+		while (*link != NIL) {
+			Node& node = p_node(*link);
+			path[depth++] = link;
+			if (comparator(node.e, key)) {
+				link = &node.right;
+			}
+			else {
+				candidate = link;
+				candidate_depth = depth - 1;
+				link = &node.left;
+			}
+		}
+
+		if (candidate != nullptr && !comparator(key, p_node(*candidate).e)) {
+			depth = candidate_depth;
+			return candidate;
+		}
+		return link;
+	}
+
+	/**
+	 * @brief Walks the path up after an insert or an erase, rebalancing until the height
+	 * of a subtree does not change. Above it only the cardinals change, if there are.
+	 * @param delta +1 after an insert, -1 after an erase
+	 */
+	void p_retrace(index_type* path[], int depth, int delta) {
+		int i = depth - 1;
+		while (i >= 0) {
+			int height = p_node(*path[i]).height;
+			index_type node = *path[i] = p_equil(*path[i]);
+			--i;
+
+			if (p_node(node).height == height) break;
+		}
+
+		if (Cardinals) {
+			for (; i >= 0; --i) {
+				Node& node = p_node(*path[i]);
+				node.set_cardinal(node.get_cardinal() + delta);
+			}
+		}
+	}
+
+	void p_erase(Key const& elem) {
+		index_type* path[MAX_HEIGHT];
+		int depth = 0;
+
+		index_type* link = p_find_link(elem, path, depth);
+		index_type i = *link;
+		if (i == NIL) return;
+
+		Node& node = p_node(i);
+		if (node.right == NIL) {
+			*link = node.left;
+		}
+		else {
+			// The successor node takes the place of node, instead of moving its key
+			int top = depth;
+			path[depth++] = link;
+
+			index_type* min_link = &node.right;
+			while (p_node(*min_link).left != NIL) {
+				path[depth++] = min_link;
+				min_link = &p_node(*min_link).left;
+			}
+
+			index_type m = *min_link;
+			Node& min = p_node(m);
+			*min_link = min.right;
+			min.left = node.left;
+			min.right = node.right;
+			min.height = node.height;
+			min.set_cardinal(node.get_cardinal());
+			*link = m;
+
+			// The link below node was inside of it
+			if (depth > top + 1) path[top + 1] = &min.right;
+		}
+
+		p_destroy(i);
+		p_retrace(path, depth, -1);
+	}
+
+	/**
+	 * @brief Inserts the key, constructing the node only if it is not on the tree
+	 * @tparam K Key const& or Key&&
+	 */
+	template<class K>
+	void p_insert(K&& elem) {
+		// The pool must grow before taking the links, but not for a key that is on the tree
+		if (this->free_head == NIL) {
+			if (p_find(elem) != NIL) return;
+			p_ensure_free();
+		}
+
+		index_type* path[MAX_HEIGHT];
+		int depth = 0;
+
+		index_type* link = p_find_link(elem, path, depth);
+		if (*link != NIL) return;
+
+		*link = p_create(std::forward<K>(elem));
+		p_retrace(path, depth, +1);
+	}
+
+	/**
+	 * @brief Links an already created node. If its key is on the tree, it is destroyed
+	 */
+	void p_insert_node(index_type new_node) {
+		index_type* path[MAX_HEIGHT];
+		int depth = 0;
+
+		index_type* link = p_find_link(p_node(new_node).e, path, depth);
+		if (*link != NIL) {
+			p_destroy(new_node);
+			return;
+		}
+
+		*link = new_node;
+		p_retrace(path, depth, +1);
+	}
+
+	/**
+	 * @brief Builds a perfectly balanced tree with the next n keys of a sorted sequence.
+	 * Nodes are created on key order, so they are one after the other on the pool
+	 * @param it Iterator to the first key, it is left after the last one
+	 */
+	template<class ForwardIt>
+	index_type p_build(ForwardIt& it, std::size_t n) {
+		if (n == 0) return NIL;
+
+		index_type left = p_build(it, n / 2);
+		index_type node = p_create(*it);
+		++it;
+		p_node(node).left = left;
+		p_node(node).right = p_build(it, n - 1 - n / 2);
+		p_update(node);
+
+		return node;
+	}
+
+	template<class ForwardIt>
+	void p_assign_sorted(ForwardIt first, ForwardIt last) {
+		std::size_t n = std::distance(first, last);
+		this->p_delete();
+		this->p_reserve(n);
+		this->root = p_build(first, n);
+	}
+
+	friend class sorted_range<Key, Comparator>;
+
+	/** @see sorted_range::assign */
+	template<class ForwardIt>
+	void p_assign(ForwardIt first, ForwardIt last) {
+		sorted_range<Key, Comparator>::assign(*this, first, last, this->comparator);
+	}
+
+	/**
+	 * @brief Node with the key, or NIL. One comparison per level, and one more to check
+	 * the last node not less than key
+	 * @tparam K Key, or any type comparable with it if the Comparator is transparent
+	 */
+	template<class K>
+	index_type p_find(K const& key) const {
+		index_type candidate = NIL;
+		index_type i = this->root;
+		while (i != NIL) {
+			Node const& node = p_node(i);
+			if (comparator(node.e, key)) {
+				i = node.right;
+			}
+			else {
+				candidate = i;
+				i = node.left;
+			}
+		}
+
+		if (candidate != NIL && !comparator(key, p_node(candidate).e)) return candidate;
+		return NIL;
+	}
+
+	/**
+	 * @brief k-th smallest element, k < size
+	 */
+	Key const& p_select(std::size_t k) const {
+		index_type i = this->root;
+		while (true) {
+			Node const& node = p_node(i);
+			std::size_t left = p_cardinal(node.left);
+			if (k < left) {
+				i = node.left;
+			}
+			else if (k > left) {
+				k -= left + 1;
+				i = node.right;
+			}
+			else return node.e;
+		}
+	}
+
+	/**
+	 * @brief Number of elements less than key
+	 */
+	std::size_t p_rank(Key const& key) const {
+		std::size_t rank = 0;
+		index_type i = this->root;
+		while (i != NIL) {
+			Node const& node = p_node(i);
+			if (comparator(node.e, key)) {
+				rank += p_cardinal(node.left) + 1;
+				i = node.right;
+			}
+			else {
+				i = node.left;
+			}
+		}
+
+		return rank;
+	}
+
+public:
+
+	/**
+	 * @brief Bidirectional iterator over the keys, on increasing order. It keeps the
+	 * path from the root to the current node on a fixed-size stack of indices, and it
+	 * never allocates. <br>
+	 * Any insert or erase invalidates all the iterators.
+	 */
+	class iterator {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = Key;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Key const*;
+		using reference = Key const&;
+
+	private:
+		friend class CompactAVLTree;
+
+		Node const* nodes;
+		index_type root;
+		index_type path[MAX_HEIGHT];
+		int depth; // path[depth - 1] is the current node, end() has depth 0
+
+		iterator(Node const* nodes, index_type root) : nodes(nodes), root(root), depth(0) {}
+
+		void p_push_leftmost(index_type i) {
+			while (i != NIL) {
+				path[depth++] = i;
+				i = nodes[i].left;
+			}
+		}
+
+		void p_push_rightmost(index_type i) {
+			while (i != NIL) {
+				path[depth++] = i;
+				i = nodes[i].right;
+			}
+		}
+
+		index_type p_current() const {
+			return depth == 0 ? NIL : path[depth - 1];
+		}
+
+	public:
+		iterator() : nodes(nullptr), root(NIL), depth(0) {}
+
+		iterator(iterator const& other) : nodes(other.nodes), root(other.root), depth(other.depth) {
+			std::copy(other.path, other.path + other.depth, path);
+		}
+
+		iterator& operator=(iterator const& other) {
+			nodes = other.nodes;
+			root = other.root;
+			depth = other.depth;
+			std::copy(other.path, other.path + other.depth, path);
+			return *this;
+		}
+
+		reference operator*() const {
+			return nodes[path[depth - 1]].e;
+		}
+
+		pointer operator->() const {
+			return &nodes[path[depth - 1]].e;
+		}
+
+		/**
+		 * @brief Next key
+		 * Time complexity: O(log(n))
+		 * Amortized time complexity: O(1)
+		 */
+		iterator& operator++() {
+			index_type i = path[depth - 1];
+			if (nodes[i].right != NIL) {
+				p_push_leftmost(nodes[i].right);
+			}
+			else {
+				// Go up while coming from a right child
+				--depth;
+				while (depth > 0 && nodes[path[depth - 1]].right == i) {
+					i = path[depth - 1];
+					--depth;
+				}
+			}
+			return *this;
+		}
+
+		iterator operator++(int) {
+			iterator old(*this);
+			++(*this);
+			return old;
+		}
+
+		/**
+		 * @brief Previous key. Decrementing end() gives the greatest key
+		 * Time complexity: O(log(n))
+		 * Amortized time complexity: O(1)
+		 */
+		iterator& operator--() {
+			if (depth == 0) {
+				p_push_rightmost(root);
+				return *this;
+			}
+
+			index_type i = path[depth - 1];
+			if (nodes[i].left != NIL) {
+				p_push_rightmost(nodes[i].left);
+			}
+			else {
+				// Go up while coming from a left child
+				--depth;
+				while (depth > 0 && nodes[path[depth - 1]].left == i) {
+					i = path[depth - 1];
+					--depth;
+				}
+			}
+			return *this;
+		}
+
+		iterator operator--(int) {
+			iterator old(*this);
+			--(*this);
+			return old;
+		}
+
+		bool operator==(iterator const& other) const {
+			return p_current() == other.p_current();
+		}
+
+		bool operator!=(iterator const& other) const {
+			return p_current() != other.p_current();
+		}
+	};
+
+	using const_iterator = iterator;
+
+protected:
+	/**
+	 * @brief Iterator to the first key not less than key
+	 */
+	template<class K>
+	iterator p_lower_bound(K const& key) const {
+		iterator it(this->nodes, this->root);
+		int found = 0; // The path to the result is a prefix of the search path
+		index_type i = this->root;
+		while (i != NIL) {
+			it.path[it.depth++] = i;
+			if (comparator(p_node(i).e, key)) {
+				i = p_node(i).right;
+			}
+			else {
+				found = it.depth;
+				i = p_node(i).left;
+			}
+		}
+
+		it.depth = found;
+		return it;
+	}
+
+	/**
+	 * @brief Iterator to the first key greater than key
+	 */
+	template<class K>
+	iterator p_upper_bound(K const& key) const {
+		iterator it(this->nodes, this->root);
+		int found = 0; // The path to the result is a prefix of the search path
+		index_type i = this->root;
+		while (i != NIL) {
+			it.path[it.depth++] = i;
+			if (comparator(key, p_node(i).e)) {
+				found = it.depth;
+				i = p_node(i).left;
+			}
+			else {
+				i = p_node(i).right;
+			}
+		}
+
+		it.depth = found;
+		return it;
+	}
+
+	/**
+	 * @brief Iterator to key, or end(). The lower bound, if it is not greater than key
+	 */
+	template<class K>
+	iterator p_find_iterator(K const& key) const {
+		iterator it = p_lower_bound(key);
+		if (it.depth != 0 && comparator(key, *it)) return end();
+		return it;
+	}
+
+public:
+	/**
+	 * @brief Construct a new CompactAVLTree object
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	CompactAVLTree(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_new(c, alloc);
+	}
+
+	/**
+	 * @brief Construct a new CompactAVLTree object with the keys of [first, last). Repeated
+	 * keys are inserted once
+	 * Time complexity: O(n) if the range is sorted, O(n * log(n)) otherwise
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	template<class ForwardIt>
+	CompactAVLTree(ForwardIt first, ForwardIt last, Comparator const& c = Comparator(),
+		Allocator const& alloc = Allocator())
+	{
+		this->p_new(c, alloc);
+		this->p_assign(first, last);
+	}
+
+	/**
+	 * @brief Construct a new CompactAVLTree object by copy
+	 * Time complexity: O(other._capacity())
+	 * @param other The other tree to copy
+	 */
+	CompactAVLTree(CompactAVLTree const& other) {
+		this->p_copy(other);
+	}
+
+	/**
+	 * @brief Construct a new CompactAVLTree object by move
+	 * Time complexity: O(1)
+	 * @param other The other tree to move
+	 */
+	CompactAVLTree(CompactAVLTree&& other) noexcept {
+		this->p_move(other);
+	}
+
+	/**
+	 * @brief Destroy the CompactAVLTree object
+	 * Time complexity: O(1) if Key is trivially destructible, O(this->_capacity()) otherwise
+	 */
+	~CompactAVLTree() {
+		this->p_delete();
+	}
+
+	/**
+	 * @brief Copy assignment operator
+	 * Time complexity: O(other._capacity() + this->_capacity())
+	 * @param other The other tree to copy
+	 * @return CompactAVLTree& Reference to *this
+	 */
+	CompactAVLTree& operator=(CompactAVLTree const& other) {
+		if (this != &other) {
+			this->p_delete();
+			this->p_copy(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Move assignment operator
+	 * Time complexity: O(this->_capacity())
+	 * @param other The other tree to move
+	 * @return CompactAVLTree& Reference to *this
+	 */
+	CompactAVLTree& operator=(CompactAVLTree&& other) noexcept {
+		if (this != &other) {
+			this->p_delete();
+			this->p_move(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Swap the two trees
+	 * Time complexity: O(1)
+	 * @param other The other tree
+	 */
+	void swap(CompactAVLTree& other) {
+		this->p_swap(other);
+	}
+
+	/**
+	 * @brief Inserts a copy of key, if it is not on the tree
+	 * Time complexity: O(log(this->size())), amortized
+	 * @param key The key
+	 */
+	void insert(Key const& key) {
+		this->p_insert(key);
+	}
+
+	/**
+	 * @brief Inserts key moving it, if it is not on the tree
+	 * Time complexity: O(log(this->size())), amortized
+	 * @param key The key
+	 */
+	void insert(Key&& key) {
+		this->p_insert(std::move(key));
+	}
+
+	/**
+	 * @brief Constructs a key on the tree. It is destroyed if it was already on the tree
+	 * Time complexity: O(log(this->size()) + creation), amortized
+	 * @tparam Args Template parameter list, type parameters of the key constructor
+	 * @param args Parameters list of the key constructor
+	 */
+	template<class... Args>
+	void emplace(Args&&... args) {
+		this->p_insert_node(p_create(std::forward<Args>(args)...));
+	}
+
+	/**
+	 * @brief Erases key, if it is on the tree. Its slot is reused by the next insert
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	void erase(Key const& key) {
+		this->p_erase(key);
+	}
+
+	/**
+	 * @brief Replaces the keys of the tree with the keys of [first, last). Repeated keys
+	 * are inserted once
+	 * Time complexity: O(this->_capacity() + n) if the range is sorted,
+	 * O(this->_capacity() + n * log(n)) otherwise
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 */
+	template<class ForwardIt>
+	void assign(ForwardIt first, ForwardIt last) {
+		this->p_assign(first, last);
+	}
+
+	/**
+	 * @brief Replaces the keys of the tree with the keys of [first, last), that must be
+	 * on strictly increasing order. The new tree is perfectly balanced and its nodes are
+	 * on key order on a pool of exactly n slots
+	 * Time complexity: O(this->_capacity() + n)
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 */
+	template<class ForwardIt>
+	void assign_sorted(ForwardIt first, ForwardIt last) {
+		this->p_assign_sorted(first, last);
+	}
+
+	/**
+	 * @brief Makes room for n keys, so the next inserts do not grow the pool
+	 * Time complexity: O(this->_capacity())
+	 * @param n Number of keys
+	 */
+	void reserve(std::size_t n) {
+		this->p_reserve(n);
+	}
+
+	/**
+	 * @brief Number of slots of the pool
+	 * Time complexity: O(1)
+	 */
+	std::size_t capacity() const {
+		return this->_capacity;
+	}
+
+	bool contains(Key const& key) const {
+		return p_find(key) != NIL;
+	}
+
+	/**
+	 * @brief contains for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	bool contains(K const& key) const {
+		return p_find(key) != NIL;
+	}
+
+	bool count(Key const& key) const {
+		return p_find(key) != NIL ? 1 : 0;
+	}
+
+	/**
+	 * @brief count for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	bool count(K const& key) const {
+		return p_find(key) != NIL ? 1 : 0;
+	}
+
+	/**
+	 * @brief Iterator to the smallest key
+	 * Time complexity: O(log(this->size()))
+	 */
+	iterator begin() const {
+		iterator it(this->nodes, this->root);
+		it.p_push_leftmost(this->root);
+		return it;
+	}
+
+	/**
+	 * @brief Iterator past the greatest key
+	 * Time complexity: O(1)
+	 */
+	iterator end() const {
+		return iterator(this->nodes, this->root);
+	}
+
+	/**
+	 * @brief Iterator to key, or end() if it is not on the tree
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator find(Key const& key) const {
+		return p_find_iterator(key);
+	}
+
+	/**
+	 * @brief find for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	iterator find(K const& key) const {
+		return p_find_iterator(key);
+	}
+
+	/**
+	 * @brief Iterator to the first key not less than key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator lower_bound(Key const& key) const {
+		return p_lower_bound(key);
+	}
+
+	/**
+	 * @brief lower_bound for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	iterator lower_bound(K const& key) const {
+		return p_lower_bound(key);
+	}
+
+	/**
+	 * @brief Iterator to the first key greater than key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator upper_bound(Key const& key) const {
+		return p_upper_bound(key);
+	}
+
+	/**
+	 * @brief upper_bound for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	iterator upper_bound(K const& key) const {
+		return p_upper_bound(key);
+	}
+
+	/**
+	 * @brief Calls f with every key on the half-open range [lo, hi), on increasing order.
+	 * It does not allocate.
+	 * Time complexity: O(log(this->size()) + k), k is the number of keys on the range
+	 * @tparam F Callable with a Key const&
+	 * @param lo Lower bound, included
+	 * @param hi Upper bound, excluded
+	 * @param f Function to call
+	 */
+	template<class F>
+	void for_each_in_range(Key const& lo, Key const& hi, F f) const {
+		for (iterator it = lower_bound(lo); it.depth != 0 && comparator(*it, hi); ++it) {
+			f(*it);
+		}
+	}
+
+	/**
+	 * @brief Number of elements
+	 * Time complexity: O(1)
+	 */
+	std::size_t size() const {
+		return this->_size;
+	}
+
+	/**
+	 * @brief If the tree is empty
+	 * Time complexity: O(1)
+	 */
+	bool empty() const {
+		return this->_size == 0;
+	}
+
+	/**
+	 * @brief The k-th smallest element, counting from 0. Only if Cardinals is true
+	 * Time complexity: O(log(this->size()))
+	 * @param k Position of the element on the sorted sequence
+	 * @return Key const& Reference to the element
+	 */
+	template<bool C = Cardinals, class = typename std::enable_if<C>::type>
+	Key const& select(std::size_t k) const {
+		if (k >= size()) throw std::out_of_range("select: k >= size()");
+		return p_select(k);
+	}
+
+	/**
+	 * @brief Number of elements less than key. Only if Cardinals is true
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	template<bool C = Cardinals, class = typename std::enable_if<C>::type>
+	std::size_t rank(Key const& key) const {
+		return p_rank(key);
+	}
+
+	/**
+	 * @brief Number of elements on the half-open range [lo, hi). Only if Cardinals is true
+	 * Time complexity: O(log(this->size()))
+	 * @param lo Lower bound, included
+	 * @param hi Upper bound, excluded
+	 */
+	template<bool C = Cardinals, class = typename std::enable_if<C>::type>
+	std::size_t count_range(Key const& lo, Key const& hi) const {
+		if (!comparator(lo, hi)) return 0;
+		return p_rank(hi) - p_rank(lo);
+	}
+};
+
+/**
+ * @brief Swaps the two trees
+ * Time complexity: O(1)
+ * This implementation is intended to be found by the ADL algorithm
+ */
+template<typename Key, class C, class A, bool Cardinals>
+void swap(CompactAVLTree<Key, C, A, Cardinals>& lhs, CompactAVLTree<Key, C, A, Cardinals>& rhs) {
+	lhs.swap(rhs);
+}
@@ -0,0 +1,655 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "allocators/EpochManager.hpp"
+
+/**
+ * @brief ConcurrentAVLTree <br>
+ * Ordered set implemented as an AVL tree with copy-on-write path copying, for one writer
+ * and many readers that never block nor write shared memory. <br>
+ * Published nodes are never modified: insert and erase copy the nodes of the path they
+ * change (and the ones that rotations move), and atomically publish the new root. A
+ * reader takes a Snapshot, which sees the tree as it was when it was taken, whatever the
+ * writer does later. Old nodes are freed by epoch-based reclamation (EpochManager) once
+ * no snapshot can reach them. <br>
+ * Writes are serialized by a mutex. Every reader thread uses its own Reader: <br>
+ * ConcurrentAVLTree<int>::Reader reader(tree); <br>
+ * ConcurrentAVLTree<int>::Snapshot snapshot(reader); <br>
+ * snapshot.contains(key); <br>
+ * Keys are ordered by the Comparator, which the readers share, so it must be callable
+ * from many threads at the same time <br>
+ * Node allocations are made using the Allocator (rebound to the node type), which must be
+ * usable by the writers one after the other <br>
+ * @see https://en.wikipedia.org/wiki/AVL_tree
+ * @see https://en.wikipedia.org/wiki/Persistent_data_structure#Path_copying
+ * @tparam Key Elements' type this tree will store
+ * @tparam Comparator Strict weak ordering between keys
+ * @tparam Allocator Keys' allocator
+ */
+template <typename Key, class Comparator = std::less<Key>, class Allocator = std::allocator<Key>>
+class ConcurrentAVLTree {
+protected:
+	struct Node {
+		Key e;
+		Node* left;
+		Node* right;
+
+		int cardinal;
+		int height;
+		std::uint64_t version; // Write that created it, only that write can modify it
+	};
+
+	/**
+	 * @brief Upper bound of the height of the tree, AVL trees of 2^64 nodes are not
+	 * higher than 1.44 * 64
+	 */
+	static const int MAX_HEIGHT = 96;
+
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+
+	using alloc_key_traits = std::allocator_traits<Allocator>;
+	using alloc_node_traits = std::allocator_traits<NodeAllocator>;
+
+	/**
+	 * @brief Nodes unlinked by one write, that are freed when no reader can reach them
+	 */
+	struct Retired {
+		std::uint64_t epoch;
+		std::vector<Node*> nodes;
+	};
+
+	Comparator comparator;
+	NodeAllocator alloc_node;
+	Allocator alloc_key;
+
+	std::atomic<Node*> root;
+
+	std::mutex writer;
+	std::uint64_t version;
+	std::vector<Node*> unlinked; // By the current write
+	std::deque<Retired> retired;
+
+	EpochManager epochs;
+
+	void p_destroy(Node* node) {
+		alloc_key_traits::destroy(alloc_key, &node->e);
+		alloc_node_traits::deallocate(alloc_node, node, 1);
+	}
+
+	void p_del(Node* node) {
+		if (node != nullptr) {
+			p_del(node->left);
+			p_del(node->right);
+			p_destroy(node);
+		}
+	}
+
+	static int p_height(Node const* node) {
+		return node == nullptr ? 0 : node->height;
+	}
+
+	static int p_cardinal(Node const* node) {
+		return node == nullptr ? 0 : node->cardinal;
+	}
+
+	void p_update(Node* node) {
+		node->height = std::max(p_height(node->left), p_height(node->right)) + 1;
+		node->cardinal = 1 + p_cardinal(node->left) + p_cardinal(node->right);
+	}
+
+	template<class... Args>
+	Node* p_create(Args&&... args) {
+		Node* node = alloc_node_traits::allocate(alloc_node, 1);
+		alloc_key_traits::construct(alloc_key, &node->e, std::forward<Args>(args)...);
+
+		node->left = nullptr;
+		node->right = nullptr;
+		node->height = 1;
+		node->cardinal = 1;
+		node->version = this->version;
+
+		return node;
+	}
+
+	/**
+	 * @brief Node that the current write can modify: node itself if this write created
+	 * it, or a copy of it otherwise (the original is unlinked)
+	 */
+	Node* p_mutable(Node* node) {
+		if (node->version == this->version) return node;
+
+		Node* copy = p_create(node->e);
+		copy->left = node->left;
+		copy->right = node->right;
+		copy->height = node->height;
+		copy->cardinal = node->cardinal;
+		this->unlinked.push_back(node);
+
+		return copy;
+	}
+
+	/**
+	 * @brief Rotations only relink nodes, node must be mutable
+	 */
+	Node* p_rotateRight(Node* node) {
+		Node* l = p_mutable(node->left);
+		node->left = l->right;
+		l->right = node;
+
+		p_update(node);
+		p_update(l);
+		return l;
+	}
+
+	Node* p_rotateLeft(Node* node) {
+		Node* r = p_mutable(node->right);
+		node->right = r->left;
+		r->left = node;
+
+		p_update(node);
+		p_update(r);
+		return r;
+	}
+
+	/**
+	 * @brief Restores the AVL property on node (that must be mutable), whose subtrees are
+	 * AVL trees whose heights differ at most by 2
+	 * @return Node* New root of the subtree
+	 */
+	Node* p_equil(Node* node) {
+		p_update(node);
+
+		if (p_height(node->left) == p_height(node->right) + 2) {
+			if (p_height(node->left->left) < p_height(node->left->right)) {
+				node->left = p_rotateLeft(p_mutable(node->left));
+			}
+			return p_rotateRight(node);
+		}
+		else if (p_height(node->left) + 2 == p_height(node->right)) {
+			if (p_height(node->right->right) < p_height(node->right->left)) {
+				node->right = p_rotateRight(p_mutable(node->right));
+			}
+			return p_rotateLeft(node);
+		}
+		else return node;
+	}
+
+	/**
+	 * @brief Inserts the key on a new version of the subtree
+	 * @return Node* New root of the subtree, node itself if the key was on it
+	 */
+	template<class K>
+	Node* p_insert(Node* node, K&& key) {
+		if (node == nullptr) return p_create(std::forward<K>(key));
+
+		if (comparator(key, node->e)) {
+			Node* left = p_insert(node->left, std::forward<K>(key));
+			if (left == node->left) return node;
+
+			node = p_mutable(node);
+			node->left = left;
+		}
+		else if (comparator(node->e, key)) {
+			Node* right = p_insert(node->right, std::forward<K>(key));
+			if (right == node->right) return node;
+
+			node = p_mutable(node);
+			node->right = right;
+		}
+		else return node;
+
+		return p_equil(node);
+	}
+
+	/**
+	 * @brief Unlinks the minimum node of a new version of the subtree
+	 * @param min The minimum node, it is not modified
+	 * @return Node* New root of the subtree
+	 */
+	Node* p_unlinkMin(Node* node, Node*& min) {
+		if (node->left == nullptr) {
+			min = node;
+			return node->right;
+		}
+
+		Node* left = p_unlinkMin(node->left, min);
+		node = p_mutable(node);
+		node->left = left;
+		return p_equil(node);
+	}
+
+	/**
+	 * @brief Erases the key from a new version of the subtree
+	 * @return Node* New root of the subtree, node itself if the key was not on it
+	 */
+	Node* p_erase(Node* node, Key const& key) {
+		if (node == nullptr) return node;
+
+		if (comparator(key, node->e)) {
+			Node* left = p_erase(node->left, key);
+			if (left == node->left) return node;
+
+			node = p_mutable(node);
+			node->left = left;
+		}
+		else if (comparator(node->e, key)) {
+			Node* right = p_erase(node->right, key);
+			if (right == node->right) return node;
+
+			node = p_mutable(node);
+			node->right = right;
+		}
+		else {
+			this->unlinked.push_back(node);
+			if (node->right == nullptr) return node->left;
+
+			// The successor takes the place of node
+			Node* min;
+			Node* right = p_unlinkMin(node->right, min);
+			Node* successor = p_mutable(min);
+			successor->left = node->left;
+			successor->right = right;
+			node = successor;
+		}
+
+		return p_equil(node);
+	}
+
+	/**
+	 * @brief Publishes the new root and retires the nodes unlinked by the write, then
+	 * frees the ones that no reader can reach anymore
+	 */
+	void p_publish(Node* new_root) {
+		this->root.store(new_root);
+
+		if (!this->unlinked.empty()) {
+			this->retired.push_back(Retired());
+			this->retired.back().epoch = this->epochs.epoch();
+			this->retired.back().nodes.swap(this->unlinked);
+		}
+
+		std::uint64_t safe = this->epochs.advance();
+		while (!this->retired.empty() && this->retired.front().epoch < safe) {
+			for (Node* node : this->retired.front().nodes) {
+				p_destroy(node);
+			}
+			this->retired.pop_front();
+		}
+	}
+
+public:
+	class Snapshot;
+
+	/**
+	 * @brief Reader of the tree, it owns a slot of the epoch manager. Every reader thread
+	 * needs its own Reader, that must not be used by other threads at the same time
+	 */
+	class Reader {
+	private:
+		friend class Snapshot;
+
+		ConcurrentAVLTree* tree;
+		std::size_t slot;
+		int pins;
+
+	public:
+		/**
+		 * @brief Construct a new Reader object
+		 * Time complexity: O(max_readers)
+		 * @param tree Tree to read
+		 */
+		explicit Reader(ConcurrentAVLTree& tree) : tree(&tree), slot(tree.epochs.acquire()), pins(0) {}
+
+		Reader(Reader const&) = delete;
+		Reader& operator=(Reader const&) = delete;
+
+		~Reader() {
+			tree->epochs.release(slot);
+		}
+	};
+
+	/**
+	 * @brief Bidirectional iterator over the keys of a snapshot, on increasing order. It
+	 * keeps the path from the root to the current node on a fixed-size stack
+	 */
+	class iterator {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = Key;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Key const*;
+		using reference = Key const&;
+
+	private:
+		friend class Snapshot;
+
+		Node const* root;
+		Node const* path[MAX_HEIGHT];
+		int depth; // path[depth - 1] is the current node, end() has depth 0
+
+		iterator(Node const* root) : root(root), depth(0) {}
+
+		void p_push_leftmost(Node const* node) {
+			while (node != nullptr) {
+				path[depth++] = node;
+				node = node->left;
+			}
+		}
+
+		void p_push_rightmost(Node const* node) {
+			while (node != nullptr) {
+				path[depth++] = node;
+				node = node->right;
+			}
+		}
+
+		Node const* p_current() const {
+			return depth == 0 ? nullptr : path[depth - 1];
+		}
+
+	public:
+		iterator() : root(nullptr), depth(0) {}
+
+		iterator(iterator const& other) : root(other.root), depth(other.depth) {
+			std::copy(other.path, other.path + other.depth, path);
+		}
+
+		iterator& operator=(iterator const& other) {
+			root = other.root;
+			depth = other.depth;
+			std::copy(other.path, other.path + other.depth, path);
+			return *this;
+		}
+
+		reference operator*() const {
+			return path[depth - 1]->e;
+		}
+
+		pointer operator->() const {
+			return &path[depth - 1]->e;
+		}
+
+		/**
+		 * @brief Next key
+		 * Time complexity: O(log(n))
+		 * Amortized time complexity: O(1)
+		 */
+		iterator& operator++() {
+			Node const* node = path[depth - 1];
+			if (node->right != nullptr) {
+				p_push_leftmost(node->right);
+			}
+			else {
+				// Go up while coming from a right child
+				--depth;
+				while (depth > 0 && path[depth - 1]->right == node) {
+					node = path[--depth];
+				}
+			}
+			return *this;
+		}
+
+		iterator operator++(int) {
+			iterator it(*this);
+			++*this;
+			return it;
+		}
+
+		/**
+		 * @brief Previous key
+		 * Time complexity: O(log(n))
+		 * Amortized time complexity: O(1)
+		 */
+		iterator& operator--() {
+			if (depth == 0) {
+				p_push_rightmost(root);
+				return *this;
+			}
+
+			Node const* node = path[depth - 1];
+			if (node->left != nullptr) {
+				p_push_rightmost(node->left);
+			}
+			else {
+				// Go up while coming from a left child
+				--depth;
+				while (depth > 0 && path[depth - 1]->left == node) {
+					node = path[--depth];
+				}
+			}
+			return *this;
+		}
+
+		iterator operator--(int) {
+			iterator it(*this);
+			--*this;
+			return it;
+		}
+
+		bool operator==(iterator const& other) const {
+			return p_current() == other.p_current();
+		}
+
+		bool operator!=(iterator const& other) const {
+			return p_current() != other.p_current();
+		}
+	};
+
+	using const_iterator = iterator;
+
+	/**
+	 * @brief Immutable view of the tree at the moment it was taken. Its nodes are not
+	 * freed while it lives, so it must be short-lived if the writer is busy. Reading it
+	 * never blocks nor writes shared memory
+	 */
+	class Snapshot {
+	private:
+		Reader* reader;
+		Node const* root;
+
+	public:
+		/**
+		 * @brief Pins the epoch of the reader and takes the current version of the tree.
+		 * Snapshots of the same reader can be nested
+		 * Time complexity: O(1)
+		 * @param reader Reader of the thread
+		 */
+		explicit Snapshot(Reader& reader) : reader(&reader) {
+			if (reader.pins++ == 0) {
+				reader.tree->epochs.pin(reader.slot);
+			}
+			root = reader.tree->root.load();
+		}
+
+		Snapshot(Snapshot const&) = delete;
+		Snapshot& operator=(Snapshot const&) = delete;
+
+		~Snapshot() {
+			if (--reader->pins == 0) {
+				reader->tree->epochs.unpin(reader->slot);
+			}
+		}
+
+		/**
+		 * @brief If key is on the snapshot
+		 * Time complexity: O(log(this->size()))
+		 */
+		bool contains(Key const& key) const {
+			Comparator const& less = reader->tree->comparator;
+			Node const* node = root;
+			while (node != nullptr) {
+				if (less(key, node->e)) node = node->left;
+				else if (less(node->e, key)) node = node->right;
+				else return true;
+			}
+			return false;
+		}
+
+		bool count(Key const& key) const {
+			return contains(key) ? 1 : 0;
+		}
+
+		/**
+		 * @brief Number of keys
+		 * Time complexity: O(1)
+		 */
+		std::size_t size() const {
+			return p_cardinal(root);
+		}
+
+		/**
+		 * @brief Time complexity: O(1)
+		 */
+		bool empty() const {
+			return root == nullptr;
+		}
+
+		/**
+		 * @brief Iterator to the smallest key
+		 * Time complexity: O(log(this->size()))
+		 */
+		iterator begin() const {
+			iterator it(root);
+			it.p_push_leftmost(root);
+			return it;
+		}
+
+		/**
+		 * @brief Iterator past the greatest key
+		 * Time complexity: O(1)
+		 */
+		iterator end() const {
+			return iterator(root);
+		}
+
+		/**
+		 * @brief Calls f(key) for every key on [lo, hi), on increasing order
+		 * Time complexity: O(log(this->size()) + k), k is the number of keys on the range
+		 */
+		template<class F>
+		void for_each_in_range(Key const& lo, Key const& hi, F f) const {
+			Comparator const& less = reader->tree->comparator;
+			iterator it(root);
+			Node const* node = root;
+			while (node != nullptr) {
+				it.path[it.depth++] = node;
+				if (less(node->e, lo)) node = node->right;
+				else node = node->left;
+			}
+			// Back to the last node where the search went left, the first key not less than lo
+			while (it.depth > 0 && less(it.path[it.depth - 1]->e, lo)) {
+				--it.depth;
+			}
+
+			for (; it != end() && less(*it, hi); ++it) {
+				f(*it);
+			}
+		}
+	};
+
+	/**
+	 * @brief Construct a new ConcurrentAVLTree object
+	 * @param max_readers Maximum number of Readers at the same time
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	explicit ConcurrentAVLTree(std::size_t max_readers = 128, Comparator const& c = Comparator(),
+		Allocator const& alloc = Allocator()) :
+		comparator(c), alloc_node(alloc), alloc_key(alloc), root(nullptr), version(0), epochs(max_readers) {}
+
+	ConcurrentAVLTree(ConcurrentAVLTree const&) = delete;
+	ConcurrentAVLTree& operator=(ConcurrentAVLTree const&) = delete;
+
+	/**
+	 * @brief Destroy the ConcurrentAVLTree object. There must be no Readers left
+	 * Time complexity: O(this->size())
+	 */
+	~ConcurrentAVLTree() {
+		for (Retired& batch : this->retired) {
+			for (Node* node : batch.nodes) {
+				p_destroy(node);
+			}
+		}
+		p_del(this->root.load());
+	}
+
+	/**
+	 * @brief Inserts a copy of key, if it is not on the tree. It copies the nodes of the
+	 * path to key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	void insert(Key const& key) {
+		std::lock_guard<std::mutex> lock(this->writer);
+		++this->version;
+
+		Node* old_root = this->root.load();
+		Node* new_root = p_insert(old_root, key);
+		if (new_root != old_root) p_publish(new_root);
+	}
+
+	/**
+	 * @brief Inserts key, moving it, if it is not on the tree. It copies the nodes of the
+	 * path to key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	void insert(Key&& key) {
+		std::lock_guard<std::mutex> lock(this->writer);
+		++this->version;
+
+		Node* old_root = this->root.load();
+		Node* new_root = p_insert(old_root, std::move(key));
+		if (new_root != old_root) p_publish(new_root);
+	}
+
+	/**
+	 * @brief Erases key, if it is on the tree. It copies the nodes of the path to key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	void erase(Key const& key) {
+		std::lock_guard<std::mutex> lock(this->writer);
+		++this->version;
+
+		Node* old_root = this->root.load();
+		Node* new_root = p_erase(old_root, key);
+		if (new_root != old_root) p_publish(new_root);
+	}
+
+	/**
+	 * @brief Number of keys of the last version
+	 * Time complexity: O(1)
+	 */
+	std::size_t size() const {
+		return p_cardinal(this->root.load());
+	}
+
+	/**
+	 * @brief If the last version is empty
+	 * Time complexity: O(1)
+	 */
+	bool empty() const {
+		return this->root.load() == nullptr;
+	}
+
+	/**
+	 * @brief Number of write batches whose nodes are waiting for the readers
+	 * Time complexity: O(1)
+	 */
+	std::size_t pending() {
+		std::lock_guard<std::mutex> lock(this->writer);
+		return this->retired.size();
+	}
+};
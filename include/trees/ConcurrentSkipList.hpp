@@ -0,0 +1,686 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "allocators/EpochManager.hpp"
+
+/**
+ * @brief ConcurrentSkipList <br>
+ * Lock-free ordered set implemented as a skiplist, where any number of threads insert,
+ * erase and look up keys at the same time. <br>
+ * Every link has a mark bit. Erase marks the links of the node, from the top level to
+ * the bottom one (the mark of the bottom link is the linearization point), and then the
+ * searches that walk by unlink it. Insert links the node on the bottom level with a CAS
+ * (its linearization point) and then on the levels above. Lookups never write. <br>
+ * Unlinked nodes are freed by epoch-based reclamation (EpochManager). A node is retired
+ * by the last of its inserter and its remover, so a node that is still being linked on
+ * the upper levels is never retired. <br>
+ * Every thread uses its own Handle, and a Guard to iterate: <br>
+ * ConcurrentSkipList<int>::Handle handle(list); <br>
+ * handle.insert(key); <br>
+ * ConcurrentSkipList<int>::Guard guard(handle); <br>
+ * for (int key : guard) ... <br>
+ * Iterators and range scans are weakly consistent: they see the keys that were on the
+ * set for all the scan, and maybe the ones inserted or erased meanwhile. <br>
+ * Node allocations are made using the Allocator (rebound to the node storage), which
+ * must be usable by several threads at the same time <br>
+ * @see https://en.wikipedia.org/wiki/Skip_list
+ * @see Herlihy, Shavit, The Art of Multiprocessor Programming, 14.4
+ * @see Keir Fraser, Practical lock-freedom, 4.3
+ * @tparam Key Elements' type this set will store
+ * @tparam Comparator Strict weak ordering between keys
+ * @tparam Allocator Keys' allocator
+ */
+template <typename Key, class Comparator = std::less<Key>, class Allocator = std::allocator<Key>>
+class ConcurrentSkipList {
+protected:
+	/**
+	 * @brief Pointer to the next node, with the mark bit on the lowest bit
+	 */
+	using Link = std::atomic<std::uintptr_t>;
+
+	/**
+	 * @brief Levels of the skiplist, nodes have height i with probability 2^-i
+	 */
+	static const int MAX_LEVEL = 32;
+
+	/**
+	 * @brief Nodes retired by a Handle before trying to free them
+	 */
+	static const std::size_t RETIRE_BATCH = 64;
+
+	/**
+	 * @brief The links of the node (height of them) follow it, on the same allocation
+	 */
+	struct Node {
+		Key e;
+		std::atomic<int> owners; // The inserter and the remover, the last one retires it
+		int height;
+	};
+
+	static const std::size_t ALIGN = alignof(Node) > alignof(Link) ? alignof(Node) : alignof(Link);
+	static const std::size_t LINKS_OFFSET = (sizeof(Node) + alignof(Link) - 1) / alignof(Link) * alignof(Link);
+
+	using Block = typename std::aligned_storage<ALIGN, ALIGN>::type;
+	using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+
+	using alloc_key_traits = std::allocator_traits<Allocator>;
+	using alloc_block_traits = std::allocator_traits<BlockAllocator>;
+
+	struct Retired {
+		Node* node;
+		std::uint64_t epoch;
+	};
+
+	BlockAllocator alloc_block;
+	Allocator alloc_key;
+	Comparator comparator;
+
+	Link head[MAX_LEVEL];
+	std::atomic<long long> _size; // Can be negative for a moment
+
+	EpochManager epochs;
+
+	std::mutex orphans_mutex;
+	std::vector<Node*> orphans; // Retired by Handles destroyed before freeing them
+
+	static Node* p_ptr(std::uintptr_t link) {
+		return reinterpret_cast<Node*>(link & ~std::uintptr_t(1));
+	}
+
+	static bool p_marked(std::uintptr_t link) {
+		return (link & 1) != 0;
+	}
+
+	static std::uintptr_t p_link(Node* node) {
+		return reinterpret_cast<std::uintptr_t>(node);
+	}
+
+	static Link* p_links(Node* node) {
+		return reinterpret_cast<Link*>(reinterpret_cast<char*>(node) + LINKS_OFFSET);
+	}
+
+	static std::size_t p_blocks(int height) {
+		return (LINKS_OFFSET + height * sizeof(Link) + ALIGN - 1) / ALIGN;
+	}
+
+	template<class... Args>
+	Node* p_create(int height, Args&&... args) {
+		Node* node = reinterpret_cast<Node*>(alloc_block_traits::allocate(alloc_block, p_blocks(height)));
+		alloc_key_traits::construct(alloc_key, &node->e, std::forward<Args>(args)...);
+		new (&node->owners) std::atomic<int>(2);
+		node->height = height;
+
+		Link* links = p_links(node);
+		for (int level = 0; level < height; ++level) {
+			new (&links[level]) Link(0);
+		}
+		return node;
+	}
+
+	void p_destroy(Node* node) {
+		alloc_key_traits::destroy(alloc_key, &node->e);
+		alloc_block_traits::deallocate(alloc_block, reinterpret_cast<Block*>(node), p_blocks(node->height));
+	}
+
+	/**
+	 * @brief Searches the key, unlinking the marked nodes found on the way
+	 * @param preds Links (of the head or of a node) after which key is on every level
+	 * @param succs First node not less than key on every level
+	 * @return false if a CAS failed, and the search must start again
+	 */
+	bool p_try_find(Key const& key, Link* preds[], Node* succs[]) {
+		Link* pred = this->head;
+		for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+			Node* curr = p_ptr(pred[level].load());
+			while (curr != nullptr) {
+				std::uintptr_t succ = p_links(curr)[level].load();
+				if (p_marked(succ)) {
+					// curr is being erased, unlink it from pred on this level
+					std::uintptr_t expected = p_link(curr);
+					if (!pred[level].compare_exchange_strong(expected, succ & ~std::uintptr_t(1))) {
+						return false;
+					}
+					curr = p_ptr(succ);
+				}
+				else if (comparator(curr->e, key)) {
+					pred = p_links(curr);
+					curr = p_ptr(succ);
+				}
+				else break;
+			}
+			preds[level] = pred;
+			succs[level] = curr;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Node with the key, if it is on the set. After it, no marked node with the key
+	 * is linked on any level (if no one links it meanwhile)
+	 */
+	Node* p_find(Key const& key, Link* preds[], Node* succs[]) {
+		while (!p_try_find(key, preds, succs)) {}
+
+		Node* found = succs[0];
+		if (found != nullptr && !comparator(key, found->e)) return found;
+		return nullptr;
+	}
+
+	/**
+	 * @brief First node not less than key (greater than key if strict) not being erased.
+	 * It does not write
+	 */
+	Node* p_lower_bound(Key const& key, bool strict) const {
+		Link const* pred = this->head;
+		Node* curr = nullptr;
+		for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+			curr = p_ptr(pred[level].load());
+			while (curr != nullptr) {
+				std::uintptr_t succ = p_links(curr)[level].load();
+				if (p_marked(succ)) {
+					curr = p_ptr(succ); // Skip it, pred stays
+				}
+				else if (strict ? !comparator(key, curr->e) : comparator(curr->e, key)) {
+					pred = p_links(curr);
+					curr = p_ptr(succ);
+				}
+				else break;
+			}
+		}
+		return curr;
+	}
+
+	/**
+	 * @brief Node after node on the bottom level, skipping the ones being erased
+	 */
+	static Node* p_next(Node* node) {
+		Node* next = p_ptr(p_links(node)[0].load());
+		while (next != nullptr) {
+			std::uintptr_t succ = p_links(next)[0].load();
+			if (!p_marked(succ)) break;
+			next = p_ptr(succ);
+		}
+		return next;
+	}
+
+	Node* p_first() const {
+		Node* first = p_ptr(this->head[0].load());
+		while (first != nullptr && p_marked(p_links(first)[0].load())) {
+			first = p_ptr(p_links(first)[0].load());
+		}
+		return first;
+	}
+
+	/**
+	 * @brief Links a new node, created for a key that was not on the set
+	 * @return Node* node if it was linked, nullptr if the key was inserted meanwhile (and
+	 * node is destroyed)
+	 */
+	Node* p_insert_node(Node* node, Link* preds[], Node* succs[]) {
+		Link* links = p_links(node);
+		for (;;) {
+			for (int level = 0; level < node->height; ++level) {
+				links[level].store(p_link(succs[level]));
+			}
+			std::uintptr_t expected = p_link(succs[0]);
+			if (preds[0][0].compare_exchange_strong(expected, p_link(node))) break;
+
+			if (p_find(node->e, preds, succs) != nullptr) {
+				p_destroy(node);
+				return nullptr;
+			}
+		}
+		++this->_size;
+
+		// Upper levels, until it is linked on all of them or someone erases it
+		for (int level = 1; level < node->height; ++level) {
+			for (;;) {
+				std::uintptr_t next = links[level].load();
+				if (p_marked(next)) return node;
+
+				// An erased node with the same key is unlinked only by the searches of the
+				// key, which would stop at node: search again, that unlinks it
+				Node* succ = succs[level];
+				if (succ != nullptr && p_marked(p_links(succ)[0].load())) {
+					if (p_find(node->e, preds, succs) != node) return node;
+					continue;
+				}
+
+				if (p_ptr(next) != succs[level] &&
+					!links[level].compare_exchange_strong(next, p_link(succs[level])))
+				{
+					return node; // Marked meanwhile
+				}
+
+				std::uintptr_t expected = p_link(succs[level]);
+				if (preds[level][level].compare_exchange_strong(expected, p_link(node))) break;
+
+				if (p_find(node->e, preds, succs) != node) return node;
+			}
+		}
+		return node;
+	}
+
+	/**
+	 * @brief Marks the links of node from the top. Marking the bottom one erases it
+	 * @return true if this thread erased it
+	 */
+	bool p_mark(Node* node) {
+		Link* links = p_links(node);
+		for (int level = node->height - 1; level > 0; --level) {
+			std::uintptr_t next = links[level].load();
+			while (!p_marked(next) && !links[level].compare_exchange_weak(next, next | 1)) {}
+		}
+
+		std::uintptr_t next = links[0].load();
+		while (!p_marked(next)) {
+			if (links[0].compare_exchange_strong(next, next | 1)) return true;
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Frees the nodes on the bottom level and the orphans. No thread can be using
+	 * the set
+	 */
+	void p_delete() {
+		Node* node = p_ptr(this->head[0].load());
+		while (node != nullptr) {
+			Node* next = p_ptr(p_links(node)[0].load());
+			p_destroy(node);
+			node = next;
+		}
+		for (Node* orphan : this->orphans) {
+			p_destroy(orphan);
+		}
+		this->orphans.clear();
+	}
+
+public:
+	class Handle;
+
+	/**
+	 * @brief Forward iterator over the keys, on increasing order. It is valid while the
+	 * Guard that created it lives
+	 */
+	class iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Key;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Key const*;
+		using reference = Key const&;
+
+	private:
+		friend class ConcurrentSkipList;
+
+		Node* node; // nullptr on end()
+
+		explicit iterator(Node* node) : node(node) {}
+
+	public:
+		iterator() : node(nullptr) {}
+
+		reference operator*() const {
+			return node->e;
+		}
+
+		pointer operator->() const {
+			return &node->e;
+		}
+
+		/**
+		 * @brief Next key, skipping the ones being erased
+		 * Time complexity: O(1) if no keys are being erased
+		 */
+		iterator& operator++() {
+			node = p_next(node);
+			return *this;
+		}
+
+		iterator operator++(int) {
+			iterator old(*this);
+			++(*this);
+			return old;
+		}
+
+		bool operator==(iterator const& other) const {
+			return node == other.node;
+		}
+
+		bool operator!=(iterator const& other) const {
+			return node != other.node;
+		}
+	};
+
+	using const_iterator = iterator;
+
+	/**
+	 * @brief Pins the epoch of a Handle while it lives, so the nodes it reaches are not
+	 * freed. Guards of the same Handle can be nested, and the Handle can be used while
+	 * they live. It must be short-lived, no node retired meanwhile is freed
+	 */
+	class Guard {
+	private:
+		Handle* handle;
+
+	public:
+		/**
+		 * @brief Time complexity: O(1)
+		 * @param handle Handle of the thread
+		 */
+		explicit Guard(Handle& handle) : handle(&handle) {
+			if (handle.pins++ == 0) {
+				handle.list->epochs.pin(handle.slot);
+			}
+		}
+
+		Guard(Guard const&) = delete;
+		Guard& operator=(Guard const&) = delete;
+
+		~Guard() {
+			if (--handle->pins == 0) {
+				handle->list->epochs.unpin(handle->slot);
+			}
+		}
+
+		/**
+		 * @brief Iterator to the smallest key
+		 * Time complexity: O(1)
+		 */
+		iterator begin() const {
+			return iterator(handle->list->p_first());
+		}
+
+		/**
+		 * @brief Iterator past the greatest key
+		 * Time complexity: O(1)
+		 */
+		iterator end() const {
+			return iterator();
+		}
+
+		/**
+		 * @brief Iterator to the first key not less than key
+		 * Expected time complexity: O(log(n))
+		 */
+		iterator lower_bound(Key const& key) const {
+			return iterator(handle->list->p_lower_bound(key, false));
+		}
+
+		/**
+		 * @brief Iterator to the first key greater than key
+		 * Expected time complexity: O(log(n))
+		 */
+		iterator upper_bound(Key const& key) const {
+			return iterator(handle->list->p_lower_bound(key, true));
+		}
+
+		/**
+		 * @brief Iterator to key, or end() if it is not on the set
+		 * Expected time complexity: O(log(n))
+		 */
+		iterator find(Key const& key) const {
+			Node* node = handle->list->p_lower_bound(key, false);
+			if (node != nullptr && handle->list->comparator(key, node->e)) node = nullptr;
+			return iterator(node);
+		}
+	};
+
+	/**
+	 * @brief Access of one thread to the set. It owns a slot of the EpochManager and the
+	 * nodes retired by the thread until they can be freed. It must not be shared between
+	 * threads
+	 */
+	class Handle {
+	private:
+		friend class ConcurrentSkipList;
+		friend class Guard;
+
+		ConcurrentSkipList* list;
+		std::size_t slot;
+		int pins;
+		std::uint64_t seed;
+		std::vector<Retired> retired;
+
+		/**
+		 * @brief Height of a new node: i with probability 2^-i (xorshift64)
+		 */
+		int p_height() {
+			seed ^= seed << 13;
+			seed ^= seed >> 7;
+			seed ^= seed << 17;
+
+			int height = 1;
+			for (std::uint64_t bits = seed; (bits & 1) != 0 && height < MAX_LEVEL; bits >>= 1) {
+				++height;
+			}
+			return height;
+		}
+
+		/**
+		 * @brief Gives up a reference to the node, retiring it if it was the last one
+		 */
+		void p_release(Node* node) {
+			if (node->owners.fetch_sub(1) != 1) return;
+
+			retired.push_back(Retired{node, list->epochs.epoch()});
+			if (retired.size() >= RETIRE_BATCH) p_collect();
+		}
+
+		/**
+		 * @brief Frees the retired nodes that no thread can reach
+		 */
+		void p_collect() {
+			std::uint64_t safe = list->epochs.advance();
+			std::size_t kept = 0;
+			for (Retired const& r : retired) {
+				if (r.epoch < safe) list->p_destroy(r.node);
+				else retired[kept++] = r;
+			}
+			retired.resize(kept);
+		}
+
+	public:
+		/**
+		 * @brief Construct a new Handle object
+		 * Time complexity: O(max_threads)
+		 * @param list Set to use
+		 */
+		explicit Handle(ConcurrentSkipList& list) : list(&list), slot(list.epochs.acquire()), pins(0) {
+			seed = 0x9E3779B97F4A7C15ull * (slot + 1) ^ reinterpret_cast<std::uintptr_t>(this);
+			if (seed == 0) seed = 1;
+		}
+
+		Handle(Handle const&) = delete;
+		Handle& operator=(Handle const&) = delete;
+
+		/**
+		 * @brief Frees the retired nodes it can, and leaves the others to the set
+		 */
+		~Handle() {
+			if (!retired.empty()) p_collect();
+			if (!retired.empty()) {
+				std::lock_guard<std::mutex> lock(list->orphans_mutex);
+				for (Retired const& r : retired) {
+					list->orphans.push_back(r.node);
+				}
+			}
+			list->epochs.release(slot);
+		}
+
+		/**
+		 * @brief Inserts a copy of key, if it is not on the set
+		 * Expected time complexity: O(log(n)) without contention
+		 * @return true if it was inserted
+		 */
+		bool insert(Key const& key) {
+			Guard guard(*this);
+			Link* preds[MAX_LEVEL];
+			Node* succs[MAX_LEVEL];
+			if (list->p_find(key, preds, succs) != nullptr) return false;
+
+			Node* node = list->p_insert_node(list->p_create(p_height(), key), preds, succs);
+			if (node == nullptr) return false;
+			p_finish_insert(node, preds, succs);
+			return true;
+		}
+
+		/**
+		 * @brief Inserts key, moving it, if it is not on the set
+		 * Expected time complexity: O(log(n)) without contention
+		 * @return true if it was inserted
+		 */
+		bool insert(Key&& key) {
+			Guard guard(*this);
+			Link* preds[MAX_LEVEL];
+			Node* succs[MAX_LEVEL];
+			if (list->p_find(key, preds, succs) != nullptr) return false;
+
+			Node* node = list->p_insert_node(list->p_create(p_height(), std::move(key)), preds, succs);
+			if (node == nullptr) return false;
+			p_finish_insert(node, preds, succs);
+			return true;
+		}
+
+		/**
+		 * @brief Constructs a key on the set. It is destroyed if it was already on the set
+		 * Expected time complexity: O(log(n) + creation) without contention
+		 * @return true if it was inserted
+		 */
+		template<class... Args>
+		bool emplace(Args&&... args) {
+			Guard guard(*this);
+			Node* node = list->p_create(p_height(), std::forward<Args>(args)...);
+			Link* preds[MAX_LEVEL];
+			Node* succs[MAX_LEVEL];
+			if (list->p_find(node->e, preds, succs) != nullptr) {
+				list->p_destroy(node);
+				return false;
+			}
+
+			if (list->p_insert_node(node, preds, succs) == nullptr) return false;
+			p_finish_insert(node, preds, succs);
+			return true;
+		}
+
+		/**
+		 * @brief Erases key, if it is on the set
+		 * Expected time complexity: O(log(n)) without contention
+		 * @return true if this call erased it
+		 */
+		bool erase(Key const& key) {
+			Guard guard(*this);
+			Link* preds[MAX_LEVEL];
+			Node* succs[MAX_LEVEL];
+			Node* node = list->p_find(key, preds, succs);
+			if (node == nullptr || !list->p_mark(node)) return false;
+
+			--list->_size;
+			list->p_find(key, preds, succs); // Unlinks it from every level
+			p_release(node);
+			return true;
+		}
+
+		/**
+		 * @brief If key is on the set. It does not write shared memory
+		 * Expected time complexity: O(log(n))
+		 */
+		bool contains(Key const& key) {
+			Guard guard(*this);
+			Node* node = list->p_lower_bound(key, false);
+			return node != nullptr && !list->comparator(key, node->e);
+		}
+
+		std::size_t count(Key const& key) {
+			return contains(key) ? 1 : 0;
+		}
+
+		/**
+		 * @brief Calls f(key) for every key on [lo, hi), on increasing order
+		 * Expected time complexity: O(log(n) + k), k is the number of keys on the range
+		 */
+		template<class F>
+		void for_each_in_range(Key const& lo, Key const& hi, F f) {
+			Guard guard(*this);
+			for (Node* node = list->p_lower_bound(lo, false);
+				node != nullptr && list->comparator(node->e, hi); node = p_next(node))
+			{
+				f(node->e);
+			}
+		}
+
+		/**
+		 * @brief Number of nodes retired by this thread that are not freed yet
+		 * Time complexity: O(1)
+		 */
+		std::size_t pending() const {
+			return retired.size();
+		}
+
+	private:
+		/**
+		 * @brief If the node was erased while it was linked on the upper levels, unlinks it
+		 * from them. Then gives up the reference of the inserter
+		 */
+		void p_finish_insert(Node* node, Link* preds[], Node* succs[]) {
+			if (p_marked(p_links(node)[0].load())) list->p_find(node->e, preds, succs);
+			p_release(node);
+		}
+	};
+
+	/**
+	 * @brief Construct a new ConcurrentSkipList object
+	 * @param max_threads Maximum number of Handles at the same time
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	explicit ConcurrentSkipList(std::size_t max_threads = 128, Comparator const& c = Comparator(),
+		Allocator const& alloc = Allocator()) :
+		alloc_block(alloc), alloc_key(alloc), comparator(c), _size(0), epochs(max_threads)
+	{
+		for (int level = 0; level < MAX_LEVEL; ++level) {
+			this->head[level].store(0);
+		}
+	}
+
+	ConcurrentSkipList(ConcurrentSkipList const&) = delete;
+	ConcurrentSkipList& operator=(ConcurrentSkipList const&) = delete;
+
+	/**
+	 * @brief Destroy the ConcurrentSkipList object. There must be no Handles left
+	 * Time complexity: O(n)
+	 */
+	~ConcurrentSkipList() {
+		this->p_delete();
+	}
+
+	/**
+	 * @brief Number of keys, exact when no thread is writing
+	 * Time complexity: O(1)
+	 */
+	std::size_t size() const {
+		long long size = this->_size.load();
+		return size < 0 ? 0 : (std::size_t)size;
+	}
+
+	/**
+	 * @brief If there are no keys, exact when no thread is writing
+	 * Time complexity: O(1)
+	 */
+	bool empty() const {
+		return size() == 0;
+	}
+};
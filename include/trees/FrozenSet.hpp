@@ -0,0 +1,589 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "SortedRange.hpp"
+
+/**
+ * @brief FrozenSet <br>
+ * Immutable ordered set stored on a contiguous array in Eytzinger (BFS) order: the
+ * children of keys[k] are keys[2k] and keys[2k + 1]. It is built in O(n) from a sorted
+ * range, like the in-order traversal of an AVLTree, a LeftLeaningRedBlackTree or a
+ * BPlusTree: <br>
+ * FrozenSet<int> frozen(tree.begin(), tree.end()); <br>
+ * Searches have no unpredictable branches (the comparison only selects the next index),
+ * and they prefetch the cache line of the descendants some levels below, so the memory
+ * latency of the lower levels overlaps with the comparisons of the upper ones. <br>
+ * Keys are ordered by the Comparator. If the Comparator has an is_transparent member type,
+ * the lookups (contains, count, find, lower_bound, upper_bound) accept any type comparable
+ * with Key, without constructing a temporary key <br>
+ * @see Paul-Virak Khuong and Pat Morin, Array Layouts for Comparison-Based Searching
+ * @tparam Key Elements' type this set will store
+ * @tparam Comparator Strict weak ordering between keys
+ * @tparam Allocator Keys' allocator
+ */
+template <typename Key, class Comparator = std::less<Key>, class Allocator = std::allocator<Key>>
+class FrozenSet {
+protected:
+	/**
+	 * @brief Uses the first swap found by the ADL algorithm. <br>
+	 * This should find the user-defined swap before the generic std::swap, that makes
+	 * three moves
+	 * @tparam U Type
+	 * @param left Left object
+	 * @param right Right object
+	 */
+	template<typename U>
+	void p_adl_swap(U& left, U& right) {
+		using std::swap;
+		swap(left, right); // ADL swap
+	}
+
+	static const std::size_t CACHE_LINE = 64;
+
+	/**
+	 * @brief The descendants of keys[k] some levels below are keys[k * PREFETCH_STRIDE],
+	 * ..., keys[k * PREFETCH_STRIDE + PREFETCH_STRIDE - 1], about one cache line
+	 */
+	static const std::size_t PREFETCH_STRIDE =
+		CACHE_LINE / sizeof(Key) >= 16 ? 16 :
+		CACHE_LINE / sizeof(Key) >= 8 ? 8 :
+		CACHE_LINE / sizeof(Key) >= 4 ? 4 : 2;
+
+	using alloc_traits = std::allocator_traits<Allocator>;
+
+	Comparator comparator;
+	Allocator alloc;
+
+	Key* _storage;
+	std::size_t _capacity;
+	Key* _keys; // keys[1..size], keys[0] is not used
+	std::size_t _size;
+
+	void p_default() {
+		this->_storage = nullptr;
+		this->_capacity = 0;
+		this->_keys = nullptr;
+		this->_size = 0;
+	}
+
+	/**
+	 * @brief Allocates room for n keys. The blocks of PREFETCH_STRIDE keys are aligned to
+	 * the cache lines, if the size of Key allows it
+	 */
+	void p_allocate(std::size_t n) {
+		this->_size = n;
+		if (n == 0) return;
+
+		this->_capacity = n + 1 + CACHE_LINE / sizeof(Key) + 1;
+		this->_storage = alloc_traits::allocate(alloc, this->_capacity);
+		this->_keys = this->_storage;
+
+		std::uintptr_t address = reinterpret_cast<std::uintptr_t>(this->_storage);
+		if (CACHE_LINE % sizeof(Key) == 0 && address % CACHE_LINE % sizeof(Key) == 0) {
+			this->_keys += (CACHE_LINE - address % CACHE_LINE) % CACHE_LINE / sizeof(Key);
+		}
+	}
+
+	void p_delete() {
+		for (std::size_t k = 1; k <= this->_size; ++k) {
+			alloc_traits::destroy(alloc, this->_keys + k);
+		}
+		if (this->_storage != nullptr) {
+			alloc_traits::deallocate(alloc, this->_storage, this->_capacity);
+		}
+		this->p_default();
+	}
+
+	/**
+	 * @brief Fills the subtree of k with the next keys of a sorted sequence, on in-order
+	 */
+	template<class ForwardIt>
+	void p_fill(ForwardIt& it, std::size_t k) {
+		if (k > this->_size) return;
+
+		p_fill(it, 2 * k);
+		alloc_traits::construct(alloc, this->_keys + k, *it);
+		++it;
+		p_fill(it, 2 * k + 1);
+	}
+
+	template<class ForwardIt>
+	void p_assign_sorted(ForwardIt first, ForwardIt last) {
+		this->p_allocate(std::distance(first, last));
+		this->p_fill(first, 1);
+	}
+
+	friend class sorted_range<Key, Comparator>;
+
+	/** @see sorted_range::assign */
+	template<class ForwardIt>
+	void p_assign(ForwardIt first, ForwardIt last) {
+		sorted_range<Key, Comparator>::assign(*this, first, last, this->comparator);
+	}
+
+	void p_copy(FrozenSet const& other) {
+		this->comparator = other.comparator;
+		this->alloc = alloc_traits::select_on_container_copy_construction(other.alloc);
+		this->p_default();
+		this->p_allocate(other._size);
+		for (std::size_t k = 1; k <= this->_size; ++k) {
+			alloc_traits::construct(alloc, this->_keys + k, other._keys[k]);
+		}
+	}
+
+	void p_move(FrozenSet& other) {
+		this->comparator = std::move(other.comparator);
+		this->alloc = std::move(other.alloc);
+		this->_storage = other._storage;
+		this->_capacity = other._capacity;
+		this->_keys = other._keys;
+		this->_size = other._size;
+
+		other.p_default();
+	}
+
+	/**
+	 * @brief Prefetches the descendants of keys[k] some levels below. The index is
+	 * clamped to the last key, so the address stays inside the array
+	 */
+	void p_prefetch_below(std::size_t k) const {
+		p_prefetch(this->_keys + std::min(k * PREFETCH_STRIDE, this->_size));
+	}
+
+	static void p_prefetch(Key const* address) {
+#if defined(__GNUC__)
+		__builtin_prefetch(address);
+#else
+		(void)address;
+#endif
+	}
+
+	/**
+	 * @brief Removes the trailing ones and the zero before them. Searches go left
+	 * (append a 0) or right (append a 1) from the root, so this goes back to the last
+	 * node where the search went left
+	 */
+	static std::size_t p_last_left(std::size_t k) {
+#if defined(__GNUC__)
+		return k >> __builtin_ffsll(~(unsigned long long)k);
+#else
+		while (k & 1) k >>= 1;
+		return k >> 1;
+#endif
+	}
+
+	static int p_log2(std::size_t x) {
+		int log = 0;
+		while (x >>= 1) ++log;
+		return log;
+	}
+
+	/**
+	 * @brief Index of the first key not less than key, 0 if there is none
+	 */
+	template<class K>
+	std::size_t p_lower_bound(K const& key) const {
+		Key const* keys = this->_keys;
+		std::size_t n = this->_size;
+		std::size_t k = 1;
+		while (k <= n) {
+			p_prefetch_below(k);
+			k = 2 * k + comparator(keys[k], key);
+		}
+		return p_last_left(k);
+	}
+
+	/**
+	 * @brief Index of the first key greater than key, 0 if there is none
+	 */
+	template<class K>
+	std::size_t p_upper_bound(K const& key) const {
+		Key const* keys = this->_keys;
+		std::size_t n = this->_size;
+		std::size_t k = 1;
+		while (k <= n) {
+			p_prefetch_below(k);
+			k = 2 * k + !comparator(key, keys[k]);
+		}
+		return p_last_left(k);
+	}
+
+	/**
+	 * @brief Position of keys[k] on increasing order. On the complete tree of the same
+	 * height it would be p, minus the missing leaves of the last level before it
+	 */
+	std::size_t p_rank(std::size_t k) const {
+		int height = p_log2(this->_size);
+		int depth = p_log2(k);
+		std::size_t last_level = this->_size - (((std::size_t)1 << height) - 1);
+
+		std::size_t p = ((2 * (k - ((std::size_t)1 << depth)) + 1) << (height - depth)) - 1;
+		std::size_t left_leaves = (p + 1) / 2;
+		return left_leaves > last_level ? p - (left_leaves - last_level) : p;
+	}
+
+	/**
+	 * @brief Index of key, 0 if it is not on the set
+	 */
+	template<class K>
+	std::size_t p_find(K const& key) const {
+		std::size_t k = p_lower_bound(key);
+		return k != 0 && !comparator(key, this->_keys[k]) ? k : 0;
+	}
+
+public:
+
+	/**
+	 * @brief Bidirectional iterator over the keys, on increasing order. It walks the
+	 * implicit tree, so it is only an index
+	 */
+	class iterator {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = Key;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Key const*;
+		using reference = Key const&;
+
+	private:
+		friend class FrozenSet;
+
+		Key const* keys;
+		std::size_t n;
+		std::size_t k; // end() is 0
+
+		iterator(Key const* keys, std::size_t n, std::size_t k) : keys(keys), n(n), k(k) {}
+
+	public:
+		iterator() : keys(nullptr), n(0), k(0) {}
+
+		reference operator*() const {
+			return keys[k];
+		}
+
+		pointer operator->() const {
+			return keys + k;
+		}
+
+		/**
+		 * @brief Next key
+		 * Time complexity: O(log(n))
+		 * Amortized time complexity: O(1)
+		 */
+		iterator& operator++() {
+			if (2 * k + 1 <= n) {
+				k = 2 * k + 1;
+				while (2 * k <= n) k = 2 * k;
+			}
+			else {
+				// Go up while coming from a right child
+				while (k & 1) k >>= 1;
+				k >>= 1;
+			}
+			return *this;
+		}
+
+		iterator operator++(int) {
+			iterator it(*this);
+			++*this;
+			return it;
+		}
+
+		/**
+		 * @brief Previous key
+		 * Time complexity: O(log(n))
+		 * Amortized time complexity: O(1)
+		 */
+		iterator& operator--() {
+			if (k == 0) {
+				k = 1;
+				while (2 * k + 1 <= n) k = 2 * k + 1;
+			}
+			else if (2 * k <= n) {
+				k = 2 * k;
+				while (2 * k + 1 <= n) k = 2 * k + 1;
+			}
+			else {
+				// Go up while coming from a left child
+				while (!(k & 1)) k >>= 1;
+				k >>= 1;
+			}
+			return *this;
+		}
+
+		iterator operator--(int) {
+			iterator it(*this);
+			--*this;
+			return it;
+		}
+
+		bool operator==(iterator const& other) const {
+			return k == other.k;
+		}
+
+		bool operator!=(iterator const& other) const {
+			return k != other.k;
+		}
+	};
+
+	using const_iterator = iterator;
+
+	/**
+	 * @brief Construct a new empty FrozenSet object
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	FrozenSet(Comparator const& c = Comparator(), Allocator const& alloc = Allocator())
+		: comparator(c), alloc(alloc)
+	{
+		this->p_default();
+	}
+
+	/**
+	 * @brief Construct a new FrozenSet object with the keys of [first, last). Repeated
+	 * keys are inserted once
+	 * Time complexity: O(n) if the range is sorted (like the iterators of the trees give
+	 * them), O(n * log(n)) otherwise
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	template<class ForwardIt>
+	FrozenSet(ForwardIt first, ForwardIt last, Comparator const& c = Comparator(),
+		Allocator const& alloc = Allocator())
+		: comparator(c), alloc(alloc)
+	{
+		this->p_default();
+		this->p_assign(first, last);
+	}
+
+	/**
+	 * @brief Construct a new FrozenSet object by copy
+	 * Time complexity: O(other.size())
+	 * @param other The other set to copy
+	 */
+	FrozenSet(FrozenSet const& other) {
+		this->p_copy(other);
+	}
+
+	/**
+	 * @brief Construct a new FrozenSet object by move
+	 * Time complexity: O(1)
+	 * @param other The other set to move
+	 */
+	FrozenSet(FrozenSet&& other) noexcept {
+		this->p_move(other);
+	}
+
+	/**
+	 * @brief Destroy the FrozenSet object
+	 * Time complexity: O(this->size())
+	 */
+	~FrozenSet() {
+		this->p_delete();
+	}
+
+	/**
+	 * @brief Copy assignment operator
+	 * Time complexity: O(other.size() + this->size())
+	 * @param other The other set to copy
+	 * @return FrozenSet& Reference to *this
+	 */
+	FrozenSet& operator=(FrozenSet const& other) {
+		if (this != &other) {
+			this->p_delete();
+			this->p_copy(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Move assignment operator
+	 * Time complexity: O(this->size())
+	 * @param other The other set to move
+	 * @return FrozenSet& Reference to *this
+	 */
+	FrozenSet& operator=(FrozenSet&& other) noexcept {
+		if (this != &other) {
+			this->p_delete();
+			this->p_move(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Swap the two sets
+	 * Time complexity: O(1)
+	 * @param other The other set
+	 */
+	void swap(FrozenSet& other) {
+		p_adl_swap(this->comparator, other.comparator);
+		p_adl_swap(this->alloc, other.alloc);
+		p_adl_swap(this->_storage, other._storage);
+		p_adl_swap(this->_capacity, other._capacity);
+		p_adl_swap(this->_keys, other._keys);
+		p_adl_swap(this->_size, other._size);
+	}
+
+	/**
+	 * @brief Replaces the keys of the set with the keys of [first, last). Repeated keys
+	 * are inserted once
+	 * Time complexity: O(this->size() + n) if the range is sorted,
+	 * O(this->size() + n * log(n)) otherwise
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 */
+	template<class ForwardIt>
+	void assign(ForwardIt first, ForwardIt last) {
+		this->p_delete();
+		this->p_assign(first, last);
+	}
+
+	/**
+	 * @brief If key is on the set
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	bool contains(Key const& key) const {
+		return p_find(key) != 0;
+	}
+
+	/**
+	 * @brief contains for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	bool contains(K const& key) const {
+		return p_find(key) != 0;
+	}
+
+	bool count(Key const& key) const {
+		return p_find(key) != 0 ? 1 : 0;
+	}
+
+	/**
+	 * @brief count for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	bool count(K const& key) const {
+		return p_find(key) != 0 ? 1 : 0;
+	}
+
+	/**
+	 * @brief Number of keys less than key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	std::size_t rank(Key const& key) const {
+		std::size_t k = p_lower_bound(key);
+		if (k == 0) return this->_size;
+		return p_rank(k);
+	}
+
+	/**
+	 * @brief Iterator to the smallest key
+	 * Time complexity: O(log(this->size()))
+	 */
+	iterator begin() const {
+		std::size_t k = this->_size == 0 ? 0 : 1;
+		while (k != 0 && 2 * k <= this->_size) k = 2 * k;
+		return iterator(this->_keys, this->_size, k);
+	}
+
+	/**
+	 * @brief Iterator past the greatest key
+	 * Time complexity: O(1)
+	 */
+	iterator end() const {
+		return iterator(this->_keys, this->_size, 0);
+	}
+
+	/**
+	 * @brief Iterator to key, or end() if it is not on the set
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator find(Key const& key) const {
+		return iterator(this->_keys, this->_size, p_find(key));
+	}
+
+	/**
+	 * @brief find for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	iterator find(K const& key) const {
+		return iterator(this->_keys, this->_size, p_find(key));
+	}
+
+	/**
+	 * @brief Iterator to the first key not less than key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator lower_bound(Key const& key) const {
+		return iterator(this->_keys, this->_size, p_lower_bound(key));
+	}
+
+	/**
+	 * @brief lower_bound for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	iterator lower_bound(K const& key) const {
+		return iterator(this->_keys, this->_size, p_lower_bound(key));
+	}
+
+	/**
+	 * @brief Iterator to the first key greater than key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator upper_bound(Key const& key) const {
+		return iterator(this->_keys, this->_size, p_upper_bound(key));
+	}
+
+	/**
+	 * @brief upper_bound for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	iterator upper_bound(K const& key) const {
+		return iterator(this->_keys, this->_size, p_upper_bound(key));
+	}
+
+	/**
+	 * @brief Number of keys
+	 * Time complexity: O(1)
+	 */
+	std::size_t size() const {
+		return this->_size;
+	}
+
+	/**
+	 * @brief If the set is empty
+	 * Time complexity: O(1)
+	 */
+	bool empty() const {
+		return this->_size == 0;
+	}
+};
+
+/**
+ * @brief Time complexity: O(1)
+ * ADL finds this swap
+ */
+template<typename Key, class C, class A>
+void swap(FrozenSet<Key, C, A>& lhs, FrozenSet<Key, C, A>& rhs) {
+	lhs.swap(rhs);
+}
@@ -0,0 +1,809 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief IntegerSet <br>
+ * Ordered set of integers implemented as a compressed 64-way bitmap trie: every key is
+ * split on groups of 6 bits, every node has a 64-bit bitmap of its children and keeps
+ * only the present ones, on an array indexed by the popcount of the bitmap below the
+ * child. The last level stores the 64-bit words of the keys directly. <br>
+ * Every operation walks the levels of the trie, a constant number of them (5 for 32-bit
+ * keys, 10 for 64-bit keys), with a few word operations per level: successor and
+ * predecessor find the next child with a mask and ctz / clz instead of comparing keys. <br>
+ * Signed keys are ordered as integers (the sign bit is flipped internally). <br>
+ * Node allocations are made using the Allocator (rebound to the node and the child types)
+ * <br>
+ * @see https://en.wikipedia.org/wiki/Van_Emde_Boas_tree
+ * @see https://en.wikipedia.org/wiki/Hash_array_mapped_trie
+ * @tparam Key Integral type of the keys, up to 64 bits
+ * @tparam Allocator Keys' allocator
+ */
+template <typename Key, class Allocator = std::allocator<Key>>
+class IntegerSet {
+	static_assert(std::is_integral<Key>::value && sizeof(Key) <= 8, "IntegerSet keys must be integers up to 64 bits");
+
+protected:
+	/**
+	 * @brief Uses the first swap found by the ADL algorithm. <br>
+	 * This should find the user-defined swap before the generic std::swap, that makes
+	 * three moves
+	 * @tparam U Type
+	 * @param left Left object
+	 * @param right Right object
+	 */
+	template<typename U>
+	void p_adl_swap(U& left, U& right) {
+		using std::swap;
+		swap(left, right); // ADL swap
+	}
+
+	using Word = std::uint64_t;
+
+	static const int BITS = 8 * sizeof(Key);
+	/**
+	 * @brief Levels of nodes above the words of the keys, the root uses the bits left
+	 */
+	static const int LEVELS = (BITS - 6 + 5) / 6;
+	static const Word SIGN = std::is_signed<Key>::value ? Word(1) << (BITS - 1) : 0;
+
+	struct Node;
+
+	/**
+	 * @brief Child of a node: a node, or the word of the keys on the last level
+	 */
+	union Slot {
+		Node* node;
+		Word word;
+	};
+
+	struct Node {
+		Word bitmap;
+		Slot* slots; // popcount(bitmap) of them
+		int capacity;
+	};
+
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+
+	using alloc_node_traits = std::allocator_traits<NodeAllocator>;
+	using alloc_slot_traits = std::allocator_traits<SlotAllocator>;
+
+	NodeAllocator alloc_node;
+	SlotAllocator alloc_slot;
+
+	Node root;
+	std::size_t _size;
+
+	/**
+	 * @brief Keys are stored as unsigned words that keep their order
+	 */
+	static Word p_word(Key key) {
+		return (Word(key) ^ SIGN) & (BITS == 64 ? ~Word(0) : (Word(1) << (BITS % 64)) - 1);
+	}
+
+	static Key p_key(Word value) {
+		return static_cast<Key>(value ^ SIGN);
+	}
+
+	static int p_shift(int level) {
+		return 6 * (LEVELS - level);
+	}
+
+	static int p_index(Word value, int level) {
+		return (int)((value >> p_shift(level)) & 63);
+	}
+
+	/**
+	 * @brief value without the bits of the level and the ones below
+	 */
+	static Word p_prefix(Word value, int level) {
+		int bits = p_shift(level) + 6;
+		return bits >= 64 ? 0 : value & ~((Word(1) << bits) - 1);
+	}
+
+	/**
+	 * @brief Number of ones of x
+	 */
+	static int p_popcount(Word x) {
+#if defined(__GNUC__)
+		return __builtin_popcountll(x);
+#else
+		x = x - ((x >> 1) & 0x5555555555555555ULL);
+		x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+		x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return (int)((x * 0x0101010101010101ULL) >> 56);
+#endif
+	}
+
+	/**
+	 * @brief Number of trailing zeros of x, that must not be 0
+	 */
+	static int p_ctz(Word x) {
+#if defined(__GNUC__)
+		return __builtin_ctzll(x);
+#else
+		return p_popcount((x & (0 - x)) - 1);
+#endif
+	}
+
+	/**
+	 * @brief Number of leading zeros of x, that must not be 0
+	 */
+	static int p_clz(Word x) {
+#if defined(__GNUC__)
+		return __builtin_clzll(x);
+#else
+		int n = 0;
+		for (int shift = 32; shift > 0; shift >>= 1) {
+			if ((x >> (64 - shift)) == 0) {
+				n += shift;
+				x <<= shift;
+			}
+		}
+		return n;
+#endif
+	}
+
+	/**
+	 * @brief Position of the child i on the slots of the node
+	 */
+	static int p_rank(Word bitmap, int i) {
+		return p_popcount(bitmap & ((Word(1) << i) - 1));
+	}
+
+	/**
+	 * @brief Bits of bitmap above i, and below i
+	 */
+	static Word p_above(Word bitmap, int i) {
+		return i == 63 ? 0 : bitmap & (~Word(0) << (i + 1));
+	}
+
+	static Word p_below(Word bitmap, int i) {
+		return bitmap & ((Word(1) << i) - 1);
+	}
+
+	static int p_lowest(Word bitmap) {
+		return p_ctz(bitmap);
+	}
+
+	static int p_highest(Word bitmap) {
+		return 63 - p_clz(bitmap);
+	}
+
+	void p_reallocate(Node* node, int capacity) {
+		Slot* slots = capacity == 0 ? nullptr : alloc_slot_traits::allocate(alloc_slot, capacity);
+		int count = p_popcount(node->bitmap);
+		if (slots != nullptr) std::copy(node->slots, node->slots + std::min(count, capacity), slots);
+		if (node->slots != nullptr) alloc_slot_traits::deallocate(alloc_slot, node->slots, node->capacity);
+		node->slots = slots;
+		node->capacity = capacity;
+	}
+
+	/**
+	 * @brief Adds the child i to the node, the slot arrays double when they are full
+	 * @return Slot* The new slot
+	 */
+	Slot* p_add_slot(Node* node, int i) {
+		int count = p_popcount(node->bitmap);
+		if (count == node->capacity) p_reallocate(node, count == 0 ? 1 : 2 * count);
+
+		int rank = p_rank(node->bitmap, i);
+		std::copy_backward(node->slots + rank, node->slots + count, node->slots + count + 1);
+		node->bitmap |= Word(1) << i;
+		return &node->slots[rank];
+	}
+
+	/**
+	 * @brief Removes the child i of the node, the slot arrays halve when they are a quarter
+	 * full
+	 */
+	void p_remove_slot(Node* node, int i) {
+		int count = p_popcount(node->bitmap);
+		int rank = p_rank(node->bitmap, i);
+		std::copy(node->slots + rank + 1, node->slots + count, node->slots + rank);
+		node->bitmap &= ~(Word(1) << i);
+
+		--count;
+		if (count == 0) p_reallocate(node, 0);
+		else if (count <= node->capacity / 4) p_reallocate(node, node->capacity / 2);
+	}
+
+	Node* p_create() {
+		Node* node = alloc_node_traits::allocate(alloc_node, 1);
+		node->bitmap = 0;
+		node->slots = nullptr;
+		node->capacity = 0;
+		return node;
+	}
+
+	/**
+	 * @brief Frees the slots of the node, and the nodes below it
+	 * @param level Level of the node
+	 */
+	void p_clear(Node* node, int level) {
+		if (level < LEVELS - 1) {
+			int count = p_popcount(node->bitmap);
+			for (int k = 0; k < count; ++k) {
+				p_clear(node->slots[k].node, level + 1);
+				alloc_node_traits::deallocate(alloc_node, node->slots[k].node, 1);
+			}
+		}
+		p_reallocate(node, 0);
+		node->bitmap = 0;
+	}
+
+	/**
+	 * @brief Copies the children of other into node, that has none
+	 */
+	void p_copy_node(Node* node, Node const* other, int level) {
+		int count = p_popcount(other->bitmap);
+		if (count == 0) return;
+
+		p_reallocate(node, other->capacity);
+		node->bitmap = other->bitmap;
+		for (int k = 0; k < count; ++k) {
+			if (level < LEVELS - 1) {
+				node->slots[k].node = p_create();
+				p_copy_node(node->slots[k].node, other->slots[k].node, level + 1);
+			}
+			else {
+				node->slots[k].word = other->slots[k].word;
+			}
+		}
+	}
+
+	void p_default() {
+		this->root.bitmap = 0;
+		this->root.slots = nullptr;
+		this->root.capacity = 0;
+		this->_size = 0;
+	}
+
+	void p_new(Allocator const& alloc = Allocator()) {
+		this->p_default();
+		this->alloc_node = NodeAllocator(alloc);
+		this->alloc_slot = SlotAllocator(alloc);
+	}
+
+	void p_delete() {
+		this->p_clear(&this->root, 0);
+		this->p_default();
+	}
+
+	void p_copy(IntegerSet const& other) {
+		this->p_default();
+		this->alloc_node = alloc_node_traits::select_on_container_copy_construction(other.alloc_node);
+		this->alloc_slot = alloc_slot_traits::select_on_container_copy_construction(other.alloc_slot);
+		this->p_copy_node(&this->root, &other.root, 0);
+		this->_size = other._size;
+	}
+
+	void p_move(IntegerSet& other) {
+		this->alloc_node = std::move(other.alloc_node);
+		this->alloc_slot = std::move(other.alloc_slot);
+		this->root = other.root;
+		this->_size = other._size;
+
+		other.p_default();
+	}
+
+	void p_swap(IntegerSet& other) {
+		p_adl_swap(this->alloc_node, other.alloc_node);
+		p_adl_swap(this->alloc_slot, other.alloc_slot);
+		p_adl_swap(this->root, other.root);
+		p_adl_swap(this->_size, other._size);
+	}
+
+	bool p_contains(Word value) const {
+		Node const* node = &this->root;
+		for (int level = 0; ; ++level) {
+			int i = p_index(value, level);
+			if ((node->bitmap >> i & 1) == 0) return false;
+
+			Slot const& slot = node->slots[p_rank(node->bitmap, i)];
+			if (level == LEVELS - 1) return (slot.word >> (value & 63) & 1) != 0;
+			node = slot.node;
+		}
+	}
+
+	bool p_insert(Word value) {
+		Node* node = &this->root;
+		for (int level = 0; ; ++level) {
+			int i = p_index(value, level);
+			Slot* slot;
+			if ((node->bitmap >> i & 1) != 0) {
+				slot = &node->slots[p_rank(node->bitmap, i)];
+			}
+			else {
+				slot = p_add_slot(node, i);
+				if (level == LEVELS - 1) slot->word = 0;
+				else slot->node = p_create();
+			}
+
+			if (level == LEVELS - 1) {
+				Word bit = Word(1) << (value & 63);
+				if ((slot->word & bit) != 0) return false;
+				slot->word |= bit;
+				++this->_size;
+				return true;
+			}
+			node = slot->node;
+		}
+	}
+
+	bool p_erase(Word value) {
+		Node* path[LEVELS];
+		Node* node = &this->root;
+		for (int level = 0; ; ++level) {
+			path[level] = node;
+			int i = p_index(value, level);
+			if ((node->bitmap >> i & 1) == 0) return false;
+
+			Slot& slot = node->slots[p_rank(node->bitmap, i)];
+			if (level < LEVELS - 1) {
+				node = slot.node;
+				continue;
+			}
+
+			Word bit = Word(1) << (value & 63);
+			if ((slot.word & bit) == 0) return false;
+			slot.word &= ~bit;
+			--this->_size;
+			if (slot.word != 0) return true;
+			break;
+		}
+
+		// Remove the empty children, from the bottom
+		for (int level = LEVELS - 1; level >= 0; --level) {
+			p_remove_slot(path[level], p_index(value, level));
+			if (level == 0 || path[level]->bitmap != 0) break;
+			alloc_node_traits::deallocate(alloc_node, path[level], 1);
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Smallest value of the subtree of the child j of node
+	 * @param base Bits above the level of node
+	 */
+	static Word p_min_from(Node const* node, int level, int j, Word base) {
+		for (;;) {
+			base |= Word(j) << p_shift(level);
+			Slot const& slot = node->slots[p_rank(node->bitmap, j)];
+			if (level == LEVELS - 1) return base | p_lowest(slot.word);
+
+			node = slot.node;
+			++level;
+			j = p_lowest(node->bitmap);
+		}
+	}
+
+	/**
+	 * @brief Greatest value of the subtree of the child j of node
+	 * @param base Bits above the level of node
+	 */
+	static Word p_max_from(Node const* node, int level, int j, Word base) {
+		for (;;) {
+			base |= Word(j) << p_shift(level);
+			Slot const& slot = node->slots[p_rank(node->bitmap, j)];
+			if (level == LEVELS - 1) return base | p_highest(slot.word);
+
+			node = slot.node;
+			++level;
+			j = p_highest(node->bitmap);
+		}
+	}
+
+	/**
+	 * @brief Smallest value not less than value
+	 * @return false if there is none
+	 */
+	bool p_successor(Word value, Word& result) const {
+		Node const* path[LEVELS];
+		Node const* node = &this->root;
+		int level = 0;
+		for (; ; ++level) {
+			path[level] = node;
+			int i = p_index(value, level);
+			if ((node->bitmap >> i & 1) == 0) break;
+
+			Slot const& slot = node->slots[p_rank(node->bitmap, i)];
+			if (level == LEVELS - 1) {
+				Word bits = slot.word & (~Word(0) << (value & 63));
+				if (bits != 0) {
+					result = (value & ~Word(63)) | p_lowest(bits);
+					return true;
+				}
+				break;
+			}
+			node = slot.node;
+		}
+
+		// The next child of the deepest node that has one
+		for (; level >= 0; --level) {
+			Word next = p_above(path[level]->bitmap, p_index(value, level));
+			if (next != 0) {
+				result = p_min_from(path[level], level, p_lowest(next), p_prefix(value, level));
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Greatest value not greater than value
+	 * @return false if there is none
+	 */
+	bool p_predecessor(Word value, Word& result) const {
+		Node const* path[LEVELS];
+		Node const* node = &this->root;
+		int level = 0;
+		for (; ; ++level) {
+			path[level] = node;
+			int i = p_index(value, level);
+			if ((node->bitmap >> i & 1) == 0) break;
+
+			Slot const& slot = node->slots[p_rank(node->bitmap, i)];
+			if (level == LEVELS - 1) {
+				int low = (int)(value & 63);
+				Word bits = low == 63 ? slot.word : slot.word & ((Word(1) << (low + 1)) - 1);
+				if (bits != 0) {
+					result = (value & ~Word(63)) | p_highest(bits);
+					return true;
+				}
+				break;
+			}
+			node = slot.node;
+		}
+
+		// The previous child of the deepest node that has one
+		for (; level >= 0; --level) {
+			Word previous = p_below(path[level]->bitmap, p_index(value, level));
+			if (previous != 0) {
+				result = p_max_from(path[level], level, p_highest(previous), p_prefix(value, level));
+				return true;
+			}
+		}
+		return false;
+	}
+
+public:
+
+	/**
+	 * @brief Bidirectional iterator over the keys, on increasing order. It holds the key,
+	 * and every step searches the next one, so inserts and erases of other keys do not
+	 * invalidate it. <br>
+	 * The keys are not stored on the set, so this is a proxy iterator: dereferencing it
+	 * returns the key by value (reference is Key), like std::vector<bool>. This keeps
+	 * std::reverse_iterator, which dereferences a temporary copy, valid.
+	 */
+	class iterator {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = Key;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = Key;
+
+	private:
+		friend class IntegerSet;
+
+		IntegerSet const* set;
+		Key key;
+		bool valid; // false on end()
+
+		iterator(IntegerSet const* set, Word value, bool valid) :
+			set(set), key(p_key(value)), valid(valid) {}
+
+	public:
+		iterator() : set(nullptr), key(), valid(false) {}
+
+		reference operator*() const {
+			return key;
+		}
+
+		/**
+		 * @brief Next key
+		 * Time complexity: O(levels)
+		 */
+		iterator& operator++() {
+			Word value = p_word(key);
+			Word next;
+			valid = value != p_word(std::numeric_limits<Key>::max()) && set->p_successor(value + 1, next);
+			if (valid) key = p_key(next);
+			return *this;
+		}
+
+		iterator operator++(int) {
+			iterator old(*this);
+			++(*this);
+			return old;
+		}
+
+		/**
+		 * @brief Previous key. Decrementing end() gives the greatest key
+		 * Time complexity: O(levels)
+		 */
+		iterator& operator--() {
+			Word previous;
+			if (!valid) {
+				valid = set->p_predecessor(p_word(std::numeric_limits<Key>::max()), previous);
+			}
+			else {
+				Word value = p_word(key);
+				valid = value != 0 && set->p_predecessor(value - 1, previous);
+			}
+			if (valid) key = p_key(previous);
+			return *this;
+		}
+
+		iterator operator--(int) {
+			iterator old(*this);
+			--(*this);
+			return old;
+		}
+
+		bool operator==(iterator const& other) const {
+			return valid == other.valid && (!valid || key == other.key);
+		}
+
+		bool operator!=(iterator const& other) const {
+			return !(*this == other);
+		}
+	};
+
+	using const_iterator = iterator;
+
+	/**
+	 * @brief Construct a new IntegerSet object
+	 * @param alloc Allocator to use
+	 */
+	explicit IntegerSet(Allocator const& alloc = Allocator()) {
+		this->p_new(alloc);
+	}
+
+	/**
+	 * @brief Construct a new IntegerSet object with the keys of [first, last). Repeated
+	 * keys are inserted once
+	 * Time complexity: O(n * levels)
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 * @param alloc Allocator to use
+	 */
+	template<class InputIt>
+	IntegerSet(InputIt first, InputIt last, Allocator const& alloc = Allocator()) {
+		this->p_new(alloc);
+		this->assign(first, last);
+	}
+
+	/**
+	 * @brief Construct a new IntegerSet object by copy
+	 * Time complexity: O(number of nodes of other)
+	 * @param other The other set to copy
+	 */
+	IntegerSet(IntegerSet const& other) {
+		this->p_copy(other);
+	}
+
+	/**
+	 * @brief Construct a new IntegerSet object by move
+	 * Time complexity: O(1)
+	 * @param other The other set to move
+	 */
+	IntegerSet(IntegerSet&& other) noexcept {
+		this->p_move(other);
+	}
+
+	/**
+	 * @brief Destroy the IntegerSet object
+	 * Time complexity: O(number of nodes)
+	 */
+	~IntegerSet() {
+		this->p_delete();
+	}
+
+	/**
+	 * @brief Copy assignment operator
+	 * Time complexity: O(number of nodes of other + number of nodes)
+	 * @param other The other set to copy
+	 * @return IntegerSet& Reference to *this
+	 */
+	IntegerSet& operator=(IntegerSet const& other) {
+		if (this != &other) {
+			this->p_delete();
+			this->p_copy(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Move assignment operator
+	 * Time complexity: O(number of nodes)
+	 * @param other The other set to move
+	 * @return IntegerSet& Reference to *this
+	 */
+	IntegerSet& operator=(IntegerSet&& other) noexcept {
+		if (this != &other) {
+			this->p_delete();
+			this->p_move(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Swap the two sets
+	 * Time complexity: O(1)
+	 * @param other The other set
+	 */
+	void swap(IntegerSet& other) {
+		this->p_swap(other);
+	}
+
+	/**
+	 * @brief Inserts key, if it is not on the set
+	 * Time complexity: O(levels)
+	 * @return true if it was inserted
+	 */
+	bool insert(Key key) {
+		return this->p_insert(p_word(key));
+	}
+
+	/**
+	 * @brief Erases key, if it is on the set
+	 * Time complexity: O(levels)
+	 * @return true if it was erased
+	 */
+	bool erase(Key key) {
+		return this->p_erase(p_word(key));
+	}
+
+	/**
+	 * @brief Replaces the keys of the set with the keys of [first, last). Repeated keys
+	 * are inserted once, they do not need to be sorted
+	 * Time complexity: O(number of nodes + n * levels)
+	 */
+	template<class InputIt>
+	void assign(InputIt first, InputIt last) {
+		this->p_delete();
+		for (; first != last; ++first) {
+			this->p_insert(p_word(*first));
+		}
+	}
+
+	/**
+	 * @brief Same as assign, for the interface of the trees
+	 */
+	template<class InputIt>
+	void assign_sorted(InputIt first, InputIt last) {
+		this->assign(first, last);
+	}
+
+	/**
+	 * @brief If key is on the set
+	 * Time complexity: O(levels)
+	 */
+	bool contains(Key key) const {
+		return this->p_contains(p_word(key));
+	}
+
+	std::size_t count(Key key) const {
+		return this->p_contains(p_word(key)) ? 1 : 0;
+	}
+
+	/**
+	 * @brief Iterator to key, or end() if it is not on the set
+	 * Time complexity: O(levels)
+	 */
+	iterator find(Key key) const {
+		Word value = p_word(key);
+		return iterator(this, value, this->p_contains(value));
+	}
+
+	/**
+	 * @brief Iterator to the smallest key
+	 * Time complexity: O(levels)
+	 */
+	iterator begin() const {
+		Word first = 0;
+		bool found = this->p_successor(0, first);
+		return iterator(this, first, found);
+	}
+
+	/**
+	 * @brief Iterator past the greatest key
+	 * Time complexity: O(1)
+	 */
+	iterator end() const {
+		return iterator(this, 0, false);
+	}
+
+	/**
+	 * @brief Iterator to the first key not less than key
+	 * Time complexity: O(levels)
+	 */
+	iterator lower_bound(Key key) const {
+		Word result = 0;
+		bool found = this->p_successor(p_word(key), result);
+		return iterator(this, result, found);
+	}
+
+	/**
+	 * @brief Iterator to the first key greater than key
+	 * Time complexity: O(levels)
+	 */
+	iterator upper_bound(Key key) const {
+		if (key == std::numeric_limits<Key>::max()) return end();
+		Word result = 0;
+		bool found = this->p_successor(p_word(key) + 1, result);
+		return iterator(this, result, found);
+	}
+
+	/**
+	 * @brief Iterator to the smallest key greater than key, or end()
+	 * Time complexity: O(levels)
+	 */
+	iterator successor(Key key) const {
+		return upper_bound(key);
+	}
+
+	/**
+	 * @brief Iterator to the greatest key less than key, or end()
+	 * Time complexity: O(levels)
+	 */
+	iterator predecessor(Key key) const {
+		if (key == std::numeric_limits<Key>::min()) return end();
+		Word result = 0;
+		bool found = this->p_predecessor(p_word(key) - 1, result);
+		return iterator(this, result, found);
+	}
+
+	/**
+	 * @brief Calls f with every key on the half-open range [lo, hi), on increasing order.
+	 * It does not allocate.
+	 * Time complexity: O(levels * (k + 1)), k is the number of keys on the range
+	 * @tparam F Callable with a Key const&
+	 * @param lo Lower bound, included
+	 * @param hi Upper bound, excluded
+	 * @param f Function to call
+	 */
+	template<class F>
+	void for_each_in_range(Key lo, Key hi, F f) const {
+		for (iterator it = lower_bound(lo); it.valid && it.key < hi; ++it) {
+			f(it.key);
+		}
+	}
+
+	/**
+	 * @brief Number of elements
+	 * Time complexity: O(1)
+	 */
+	std::size_t size() const {
+		return this->_size;
+	}
+
+	/**
+	 * @brief If the set is empty
+	 * Time complexity: O(1)
+	 */
+	bool empty() const {
+		return this->_size == 0;
+	}
+};
+
+/**
+ * @brief Swaps the two sets
+ * Time complexity: O(1)
+ * This implementation is intended to be found by the ADL algorithm
+ */
+template<typename Key, class A>
+void swap(IntegerSet<Key, A>& lhs, IntegerSet<Key, A>& rhs) {
+	lhs.swap(rhs);
+}
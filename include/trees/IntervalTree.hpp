@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "AugmentedAVLTree.hpp"
+
+/**
+ * @brief Closed interval [lo, hi]. Intervals are ordered by lo, and then by hi
+ * @tparam T Endpoints' type
+ */
+template<typename T>
+struct Interval {
+	T lo;
+	T hi;
+
+	Interval() : lo(), hi() {}
+	Interval(T lo, T hi) : lo(std::move(lo)), hi(std::move(hi)) {}
+
+	bool contains(T const& point) const {
+		return !(point < lo) && !(hi < point);
+	}
+
+	bool overlaps(T const& from, T const& to) const {
+		return !(to < lo) && !(hi < from);
+	}
+
+	friend bool operator<(Interval const& a, Interval const& b) {
+		return a.lo < b.lo || (!(b.lo < a.lo) && a.hi < b.hi);
+	}
+
+	friend bool operator==(Interval const& a, Interval const& b) {
+		return !(a.lo < b.lo) && !(b.lo < a.lo) && !(a.hi < b.hi) && !(b.hi < a.hi);
+	}
+
+	friend bool operator!=(Interval const& a, Interval const& b) {
+		return !(a == b);
+	}
+};
+
+/**
+ * @brief Augmentation of the IntervalTree: the greatest hi of the subtree
+ * @tparam T Endpoints' type
+ */
+template<typename T>
+struct MaxEndpoint {
+	using value_type = T;
+
+	value_type identity() const {
+		return std::numeric_limits<T>::lowest();
+	}
+
+	value_type measure(Interval<T> const& interval) const {
+		return interval.hi;
+	}
+
+	value_type combine(value_type const& a, value_type const& b) const {
+		return a < b ? b : a;
+	}
+};
+
+/**
+ * @brief IntervalTree <br>
+ * Set of closed intervals, stored on an AugmentedAVLTree ordered by lo where every
+ * subtree knows its greatest hi. Queries skip the subtrees whose greatest hi is before
+ * the query, and stop at the first interval whose lo is after it, so a query that finds
+ * k intervals visits O(min(n, (k + 1) * log(n))) nodes. Equal intervals are stored
+ * once. <br>
+ * T needs operator< and std::numeric_limits<T>::lowest().
+ * @see https://en.wikipedia.org/wiki/Interval_tree#Augmented_tree
+ * @see Cormen, Leiserson, Rivest, Stein, Introduction to Algorithms, 14.3
+ * @tparam T Endpoints' type
+ * @tparam Allocator Intervals' allocator
+ */
+template<typename T, class Allocator = std::allocator<Interval<T>>>
+class IntervalTree : public AugmentedAVLTree<Interval<T>, MaxEndpoint<T>, std::less<Interval<T>>, Allocator> {
+private:
+	using Base = AugmentedAVLTree<Interval<T>, MaxEndpoint<T>, std::less<Interval<T>>, Allocator>;
+	using Node = typename Base::Node;
+
+	/**
+	 * @brief Calls f with every interval of the subtree overlapping [lo, hi], on order
+	 * @return std::size_t Number of intervals found
+	 */
+	template<class Function>
+	std::size_t p_overlapping(Node const* node, T const& lo, T const& hi, Function& f) const {
+		std::size_t found = 0;
+		// The recursion goes left, the loop goes right
+		while (node != nullptr && !(node->summary < lo)) {
+			found += p_overlapping(node->left, lo, hi, f);
+
+			// This and the right subtree start after the query
+			if (hi < node->e.lo) break;
+			if (!(node->e.hi < lo)) {
+				f(node->e);
+				++found;
+			}
+			node = node->right;
+		}
+		return found;
+	}
+
+public:
+	using Base::Base;
+	using Base::insert;
+	using Base::erase;
+	using Base::contains;
+
+	/**
+	 * @brief Inserts the interval [lo, hi], if it is not on the tree
+	 * Time complexity: O(log(this->size()))
+	 * @param lo Start of the interval, not greater than hi
+	 * @param hi End of the interval
+	 */
+	void insert(T const& lo, T const& hi) {
+		this->p_insert(Interval<T>(lo, hi));
+	}
+
+	/**
+	 * @brief Erases the interval [lo, hi], if it is on the tree
+	 * Time complexity: O(log(this->size()))
+	 */
+	void erase(T const& lo, T const& hi) {
+		this->p_erase(Interval<T>(lo, hi));
+	}
+
+	/**
+	 * @brief If the interval [lo, hi] is on the tree
+	 * Time complexity: O(log(this->size()))
+	 */
+	bool contains(T const& lo, T const& hi) const {
+		return this->p_find(Interval<T>(lo, hi)) != nullptr;
+	}
+
+	/**
+	 * @brief If any interval overlaps [lo, hi]
+	 * Time complexity: O(log(this->size()))
+	 */
+	bool overlaps(T const& lo, T const& hi) const {
+		Node const* node = this->root;
+		while (node != nullptr) {
+			if (node->e.overlaps(lo, hi)) return true;
+
+			// If no interval on the left reaches lo, none on the right starts before hi either
+			if (node->left != nullptr && !(node->left->summary < lo)) node = node->left;
+			else node = node->right;
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Calls f with every interval overlapping [lo, hi], on increasing order
+	 * Time complexity: O(min(this->size(), (k + 1) * log(this->size()))), with k the
+	 * number of intervals found
+	 * @param f Function called with Interval<T> const&
+	 * @return std::size_t Number of intervals found
+	 */
+	template<class Function>
+	std::size_t for_each_overlapping(T const& lo, T const& hi, Function f) const {
+		return p_overlapping(this->root, lo, hi, f);
+	}
+
+	/**
+	 * @brief Calls f with every interval containing point, on increasing order (stabbing
+	 * query)
+	 * Time complexity: O(min(this->size(), (k + 1) * log(this->size()))), with k the
+	 * number of intervals found
+	 * @param f Function called with Interval<T> const&
+	 * @return std::size_t Number of intervals found
+	 */
+	template<class Function>
+	std::size_t for_each_containing(T const& point, Function f) const {
+		return p_overlapping(this->root, point, point, f);
+	}
+
+	/**
+	 * @brief Number of intervals overlapping [lo, hi]
+	 * Time complexity: O(min(this->size(), (k + 1) * log(this->size()))), with k the
+	 * number of intervals found
+	 */
+	std::size_t count_overlapping(T const& lo, T const& hi) const {
+		return for_each_overlapping(lo, hi, [](Interval<T> const&) {});
+	}
+};
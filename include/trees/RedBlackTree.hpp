@@ -1,6 +1,29 @@
 #pragma once
 
-template <typename Key>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "SortedRange.hpp"
+
+/**
+ * @brief LeftLeaningRedBlackTree <br>
+ * Ordered set implemented as a left-leaning red-black tree <br>
+ * Keys are ordered by the Comparator. Lookups make one comparison per level and check the
+ * equality once at the end. If the Comparator has an is_transparent member type, the
+ * lookups (contains, count, find, lower_bound, upper_bound) accept any type comparable
+ * with Key, without constructing a temporary key <br>
+ * Node allocations are made using the Allocator (rebound to the node type) <br>
+ * @see https://en.wikipedia.org/wiki/Left-leaning_red%E2%80%93black_tree
+ * @tparam Key Elements' type this tree will store
+ * @tparam Comparator Strict weak ordering between keys
+ * @tparam Allocator Keys' allocator
+ */
+template <typename Key, class Comparator = std::less<Key>, class Allocator = std::allocator<Key>>
 class LeftLeaningRedBlackTree {
 private:
 
@@ -14,26 +37,87 @@ private:
 		Node* right;
 	};
 
+	/**
+	 * @brief Upper bound of the height of the tree, red-black trees of 2^64 nodes are
+	 * not higher than 2 * 64
+	 */
+	static const int MAX_HEIGHT = 128;
+
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+
+	using alloc_key_traits = std::allocator_traits<Allocator>;
+	using alloc_node_traits = std::allocator_traits<NodeAllocator>;
+
 	//********* END DEFINITIONS *********//
 
 	//************ STRUCTURE ************//
 
+	NodeAllocator alloc_node;
+	Allocator alloc_key;
+	Comparator comparator;
+
 	Node* root;
 
 	//********** END STRUCTURE **********//
 
-	LeftLeaningRedBlackTree(Node* node) : root(node) {}
-
 	//************* METHODS *************//
 
+	template<typename U>
+	void p_adl_swap(U& left, U& right) {
+		using std::swap;
+		swap(left, right); // ADL swap
+	}
+
+	template<class... Args>
+	Node* p_create(Args&&... args) {
+		Node* node = alloc_node_traits::allocate(alloc_node, 1);
+		alloc_key_traits::construct(alloc_key, &node->key, std::forward<Args>(args)...);
+		node->color = RED;
+		node->left = nullptr;
+		node->right = nullptr;
+
+		return node;
+	}
+
+	void p_destroy(Node* node) {
+		alloc_key_traits::destroy(alloc_key, &node->key);
+		alloc_node_traits::deallocate(alloc_node, node, 1);
+	}
+
 	void del(Node* node) {
 		if (node != nullptr) {
 			del(node->left);
 			del(node->right);
-			delete node;
+			p_destroy(node);
 		}
 	}
 
+	Node* p_copy(Node* node) {
+		if (node == nullptr) return nullptr;
+
+		Node* new_node = p_create(node->key);
+		new_node->color = node->color;
+		new_node->left = p_copy(node->left);
+		new_node->right = p_copy(node->right);
+
+		return new_node;
+	}
+
+	void p_copy(LeftLeaningRedBlackTree const& other) {
+		this->comparator = other.comparator;
+		this->alloc_key = other.alloc_key;
+		this->alloc_node = alloc_node_traits::select_on_container_copy_construction(other.alloc_node);
+		this->root = p_copy(other.root);
+	}
+
+	void p_move(LeftLeaningRedBlackTree& other) {
+		this->comparator = std::move(other.comparator);
+		this->alloc_key = std::move(other.alloc_key);
+		this->alloc_node = std::move(other.alloc_node);
+		this->root = other.root;
+		other.root = nullptr;
+	}
+
 	bool isRed(Node* node) {
 		if (node == nullptr) return false;
 		else return node->color == RED;
@@ -111,8 +195,7 @@ private:
 			node = rotateRight(node);
 
 		if (node->right == nullptr) {
-			//revise...
-			delete node;
+			p_destroy(node);
 			return nullptr;
 		}
 
@@ -126,30 +209,30 @@ private:
 
 	Node* p_eraseMin(Node* node) {
 		if (node->left == nullptr) {
-			//revise...
-			delete node;
+			p_destroy(node);
 			return nullptr;
 		}
 
 		if (!isRed(node->left) && !isRed(node->left->left)) // => node->left is a 2-node
-			node = moveRedRight(node);
+			node = moveRedLeft(node);
 
 		node->left = p_eraseMin(node->left);
 
 		return fixUp(node);
 	}
 
+	/**
+	 * @brief Unlinks the minimum node of the subtree, without deallocating it
+	 */
 	Node* p_setNullMin(Node* node) {
 		if (node->left == nullptr) {
-			//revise...
-			//delete node;
 			return nullptr;
 		}
 
 		if (!isRed(node->left) && !isRed(node->left->left)) // => node->left is a 2-node
-			node = moveRedRight(node);
+			node = moveRedLeft(node);
 
-		node->left = p_eraseMin(node->left);
+		node->left = p_setNullMin(node->left);
 
 		return fixUp(node);
 	}
@@ -173,7 +256,7 @@ private:
 	Node* p_erase(Node* node, Key const& key) {
 		if (node == nullptr) return nullptr;
 
-		if (key < node->key) {
+		if (comparator(key, node->key)) {
 			if (!isRed(node->left) && node->left != nullptr && !isRed(node->left->left))
 				node = moveRedLeft(node);
 
@@ -183,21 +266,23 @@ private:
 			if (isRed(node->left))
 				node = rotateRight(node);
 
-			if (key == node->key && node->right == nullptr) {
-				delete node;
+			// Here key is not less than node->key, so it is equal if it is not greater
+			if (!comparator(node->key, key) && node->right == nullptr) {
+				p_destroy(node);
 				return nullptr;
 			}
 
 			if (!isRed(node->right) && node->right != nullptr && !isRed(node->right->left))
 				node = moveRedRight(node);
 
-			if (key == node->key) {
-				//copying key and value may be expensive
+			if (!comparator(node->key, key)) {
+				// The successor node takes the place of node, instead of copying its key
 				Node* min = p_findMin(node->right);
-				min->left = node->left;
 				min->right = p_setNullMin(node->right);
+				min->left = node->left;
+				min->color = node->color;
 
-				delete node;
+				p_destroy(node);
 				node = min;
 			}
 			else node->right = p_erase(node->right, key);
@@ -206,33 +291,176 @@ private:
 		return node = fixUp(node);
 	}
 
-	bool p_contains(Node* node, Key const& key) {
+	/**
+	 * @brief Builds a 2-3 tree with the next n keys of a sorted sequence. All its leaves
+	 * are at the same depth h, so 2^h - 1 <= n <= 3^h - 1. 3-nodes are a black node with
+	 * a red left child. Nodes are created on key order, so they are allocated one after
+	 * the other
+	 * @param it Iterator to the first key, it is left after the last one
+	 * @param max_size 3^h - 1
+	 */
+	template<class ForwardIt>
+	Node* p_build(ForwardIt& it, std::size_t n, std::size_t max_size) {
+		if (n == 0) return nullptr;
+
+		std::size_t max_child = (max_size + 1) / 3 - 1;
+		if (n - 1 <= 2 * max_child) {
+			// 2-node
+			std::size_t left_size = (n - 1) / 2;
+			Node* left = p_build(it, left_size, max_child);
+			Node* node = p_create(*it);
+			++it;
+			node->color = BLACK;
+			node->left = left;
+			node->right = p_build(it, n - 1 - left_size, max_child);
+
+			return node;
+		}
+		else {
+			// 3-node
+			std::size_t a = (n - 2) / 3;
+			std::size_t b = (n - 2 - a) / 2;
+			Node* left = p_build(it, a, max_child);
+			Node* red = p_create(*it);
+			++it;
+			red->left = left;
+			red->right = p_build(it, b, max_child);
+
+			Node* node = p_create(*it);
+			++it;
+			node->color = BLACK;
+			node->left = red;
+			node->right = p_build(it, n - 2 - a - b, max_child);
+
+			return node;
+		}
+	}
+
+	template<class ForwardIt>
+	void p_assign_sorted(ForwardIt first, ForwardIt last) {
+		del(root);
+		std::size_t n = std::distance(first, last);
+		std::size_t max_size = 0;
+		while (max_size < n) max_size = 3 * max_size + 2;
+
+		root = p_build(first, n, max_size);
+	}
+
+	friend class sorted_range<Key, Comparator>;
+
+	/** @see sorted_range::assign */
+	template<class ForwardIt>
+	void p_assign(ForwardIt first, ForwardIt last) {
+		sorted_range<Key, Comparator>::assign(*this, first, last, this->comparator);
+	}
+
+	/**
+	 * @brief Node with the key, or nullptr. One comparison per level, and one more to
+	 * check the last node not less than key
+	 * @tparam K Key, or any type comparable with it if the Comparator is transparent
+	 */
+	template<class K>
+	Node* p_find(Node* node, K const& key) const {
+		Node* candidate = nullptr;
 		while (node != nullptr) {
-			if (node->key > key) {
-				node = node->left;
-			}
-			else if (node->key < key) {
+			if (comparator(node->key, key)) {
 				node = node->right;
 			}
-			else return true;
+			else {
+				candidate = node;
+				node = node->left;
+			}
 		}
 
-		return false;
+		if (candidate != nullptr && !comparator(key, candidate->key)) return candidate;
+		return nullptr;
 	}
 
-	Node* p_insert(Node* node, Key const& key) {
+	/**
+	 * @brief Number of lookups that a batch walks in lockstep
+	 */
+	static const int BATCH_GROUP = 16;
+
+	static void p_prefetch(Node const* node) {
+#if defined(__GNUC__)
+		__builtin_prefetch(node);
+#else
+		(void)node;
+#endif
+	}
 
-		if (node == nullptr) return new Node{ key, RED, nullptr, nullptr };
+	/**
+	 * @brief Looks up the keys of [first, last) in groups of BATCH_GROUP, one level of
+	 * every lookup of the group at a time, and prefetches the next node of each one, so
+	 * the cache misses of the group overlap instead of waiting one after the other.
+	 * Like p_find, every lookup goes down to a leaf and checks the equality at the end.
+	 * Writes result(node) for every key, node is nullptr if the key is not on the tree
+	 */
+	template<class ForwardIt, class OutputIt, class Result>
+	OutputIt p_batch(ForwardIt first, ForwardIt last, OutputIt out, Result result) const {
+		using K = typename std::iterator_traits<ForwardIt>::value_type;
+		K const* keys[BATCH_GROUP];
+		Node* nodes[BATCH_GROUP];
+		Node* found[BATCH_GROUP]; // Last node not less than the key
+
+		while (first != last) {
+			int n = 0;
+			for (; n < BATCH_GROUP && first != last; ++n, ++first) {
+				keys[n] = &*first;
+				nodes[n] = root;
+				found[n] = nullptr;
+			}
 
-		if (is4Node(node))
-			flipColor(node); //split 4-nodes
+			bool active = true;
+			while (active) {
+				active = false;
+				for (int i = 0; i < n; ++i) {
+					Node* node = nodes[i];
+					if (node == nullptr) continue;
+
+					if (comparator(node->key, *keys[i])) {
+						node = node->right;
+					}
+					else {
+						found[i] = node;
+						node = node->left;
+					}
+
+					nodes[i] = node;
+					if (node != nullptr) {
+						p_prefetch(node);
+						active = true;
+					}
+				}
+			}
 
-		if (node->key == key) node->key = key; //do nothing
-		else if (node->key > key) {
-			node->left = p_insert(node->left, key); //insert to left
+			for (int i = 0; i < n; ++i) {
+				if (found[i] != nullptr && comparator(*keys[i], found[i]->key)) found[i] = nullptr;
+				*out++ = result(found[i]);
+			}
+		}
+
+		return out;
+	}
+
+	/**
+	 * @brief Inserts the key with one comparison per level: it goes down to a leaf,
+	 * remembering on candidate the last node not less than key, and only creates the node
+	 * if candidate is not key. If it was, nothing changed, and the fixes on the way up do
+	 * nothing on a valid tree
+	 */
+	Node* p_insert(Node* node, Key const& key, Node* candidate = nullptr) {
+
+		if (node == nullptr) {
+			if (candidate != nullptr && !comparator(key, candidate->key)) return nullptr;
+			return p_create(key);
+		}
+
+		if (comparator(node->key, key)) {
+			node->right = p_insert(node->right, key, candidate); //insert to right
 		}
 		else {
-			node->right = p_insert(node->right, key); //insert to right
+			node->left = p_insert(node->left, key, node); //insert to left
 		}
 
 		if (isRed(node->right)) {
@@ -245,6 +473,9 @@ private:
 			node = rotateRight(node);
 		}
 
+		if (is4Node(node))
+			flipColor(node); //split 4-nodes on the way up, deletion relies on a 2-3 tree
+
 		return node;
 	}
 
@@ -252,28 +483,483 @@ private:
 
 public:
 
-	LeftLeaningRedBlackTree() {
+	/**
+	 * @brief Bidirectional iterator over the keys, on increasing order. It keeps the
+	 * path from the root to the current node on a fixed-size stack, so the nodes do not
+	 * need parent pointers and it never allocates. <br>
+	 * Any insert or erase invalidates all the iterators.
+	 */
+	class iterator {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = Key;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Key const*;
+		using reference = Key const&;
+
+	private:
+		friend class LeftLeaningRedBlackTree;
+
+		Node* root;
+		Node* path[MAX_HEIGHT];
+		int depth; // path[depth - 1] is the current node, end() has depth 0
+
+		iterator(Node* root) : root(root), depth(0) {}
+
+		void p_push_leftmost(Node* node) {
+			while (node != nullptr) {
+				path[depth++] = node;
+				node = node->left;
+			}
+		}
+
+		void p_push_rightmost(Node* node) {
+			while (node != nullptr) {
+				path[depth++] = node;
+				node = node->right;
+			}
+		}
+
+		Node* p_current() const {
+			return depth == 0 ? nullptr : path[depth - 1];
+		}
+
+	public:
+		iterator() : root(nullptr), depth(0) {}
+
+		iterator(iterator const& other) : root(other.root), depth(other.depth) {
+			std::copy(other.path, other.path + other.depth, path);
+		}
+
+		iterator& operator=(iterator const& other) {
+			root = other.root;
+			depth = other.depth;
+			std::copy(other.path, other.path + other.depth, path);
+			return *this;
+		}
+
+		reference operator*() const {
+			return path[depth - 1]->key;
+		}
+
+		pointer operator->() const {
+			return &path[depth - 1]->key;
+		}
+
+		/**
+		 * @brief Next key
+		 * Time complexity: O(log(n))
+		 * Amortized time complexity: O(1)
+		 */
+		iterator& operator++() {
+			Node* node = path[depth - 1];
+			if (node->right != nullptr) {
+				p_push_leftmost(node->right);
+			}
+			else {
+				// Go up while coming from a right child
+				--depth;
+				while (depth > 0 && path[depth - 1]->right == node) {
+					node = path[depth - 1];
+					--depth;
+				}
+			}
+			return *this;
+		}
+
+		iterator operator++(int) {
+			iterator old(*this);
+			++(*this);
+			return old;
+		}
+
+		/**
+		 * @brief Previous key. Decrementing end() gives the greatest key
+		 * Time complexity: O(log(n))
+		 * Amortized time complexity: O(1)
+		 */
+		iterator& operator--() {
+			if (depth == 0) {
+				p_push_rightmost(root);
+				return *this;
+			}
+
+			Node* node = path[depth - 1];
+			if (node->left != nullptr) {
+				p_push_rightmost(node->left);
+			}
+			else {
+				// Go up while coming from a left child
+				--depth;
+				while (depth > 0 && path[depth - 1]->left == node) {
+					node = path[depth - 1];
+					--depth;
+				}
+			}
+			return *this;
+		}
+
+		iterator operator--(int) {
+			iterator old(*this);
+			--(*this);
+			return old;
+		}
+
+		bool operator==(iterator const& other) const {
+			return p_current() == other.p_current();
+		}
+
+		bool operator!=(iterator const& other) const {
+			return p_current() != other.p_current();
+		}
+	};
+
+	using const_iterator = iterator;
+
+private:
+	/**
+	 * @brief Iterator to the first key not less than key
+	 */
+	template<class K>
+	iterator p_lower_bound(K const& key) const {
+		iterator it(root);
+		int found = 0; // The path to the result is a prefix of the search path
+		Node* node = root;
+		while (node != nullptr) {
+			it.path[it.depth++] = node;
+			if (comparator(node->key, key)) {
+				node = node->right;
+			}
+			else {
+				found = it.depth;
+				node = node->left;
+			}
+		}
+
+		it.depth = found;
+		return it;
+	}
+
+	/**
+	 * @brief Iterator to the first key greater than key
+	 */
+	template<class K>
+	iterator p_upper_bound(K const& key) const {
+		iterator it(root);
+		int found = 0; // The path to the result is a prefix of the search path
+		Node* node = root;
+		while (node != nullptr) {
+			it.path[it.depth++] = node;
+			if (comparator(key, node->key)) {
+				found = it.depth;
+				node = node->left;
+			}
+			else {
+				node = node->right;
+			}
+		}
+
+		it.depth = found;
+		return it;
+	}
+
+	/**
+	 * @brief Iterator to key, or end(). The lower bound, if it is not greater than key
+	 */
+	template<class K>
+	iterator p_find_iterator(K const& key) const {
+		iterator it = p_lower_bound(key);
+		if (it.depth != 0 && comparator(key, *it)) return end();
+		return it;
+	}
+
+public:
+
+	/**
+	 * @brief Construct a new LeftLeaningRedBlackTree object
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	LeftLeaningRedBlackTree(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) :
+		alloc_node(alloc), alloc_key(alloc), comparator(c)
+	{
+		root = nullptr;
+	}
+
+	/**
+	 * @brief Construct a new LeftLeaningRedBlackTree object with the keys of
+	 * [first, last). Repeated keys are inserted once
+	 * Time complexity: O(n) if the range is sorted, O(n * log(n)) otherwise
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	template<class ForwardIt>
+	LeftLeaningRedBlackTree(ForwardIt first, ForwardIt last, Comparator const& c = Comparator(),
+		Allocator const& alloc = Allocator()) : alloc_node(alloc), alloc_key(alloc), comparator(c)
+	{
 		root = nullptr;
+		this->p_assign(first, last);
+	}
+
+	/**
+	 * @brief Construct a new LeftLeaningRedBlackTree object by copy
+	 * Time complexity: O(other.size())
+	 * @param other The other tree to copy
+	 */
+	LeftLeaningRedBlackTree(LeftLeaningRedBlackTree const& other) {
+		this->p_copy(other);
+	}
+
+	/**
+	 * @brief Construct a new LeftLeaningRedBlackTree object by move
+	 * Time complexity: O(1)
+	 * @param other The other tree to move
+	 */
+	LeftLeaningRedBlackTree(LeftLeaningRedBlackTree&& other) noexcept {
+		this->p_move(other);
 	}
 
 	~LeftLeaningRedBlackTree() {
 		del(root);
 	}
 
+	/**
+	 * @brief Copy assignment operator
+	 * Time complexity: O(other.size() + this->size())
+	 * @param other The other tree to copy
+	 * @return LeftLeaningRedBlackTree& Reference to *this
+	 */
+	LeftLeaningRedBlackTree& operator=(LeftLeaningRedBlackTree const& other) {
+		if (this != &other) {
+			del(root);
+			this->p_copy(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Move assignment operator
+	 * Time complexity: O(this->size())
+	 * @param other The other tree to move
+	 * @return LeftLeaningRedBlackTree& Reference to *this
+	 */
+	LeftLeaningRedBlackTree& operator=(LeftLeaningRedBlackTree&& other) noexcept {
+		if (this != &other) {
+			del(root);
+			this->p_move(other);
+		}
+		return *this;
+	}
 
-	bool contains(Key const& key) {
-		return p_contains(root, key);
+	/**
+	 * @brief Swap the two trees
+	 * Time complexity: O(1)
+	 * @param other The other tree
+	 */
+	void swap(LeftLeaningRedBlackTree& other) {
+		p_adl_swap(this->comparator, other.comparator);
+		p_adl_swap(this->alloc_key, other.alloc_key);
+		p_adl_swap(this->alloc_node, other.alloc_node);
+		p_adl_swap(this->root, other.root);
+	}
+
+
+	/**
+	 * @brief Replaces the keys of the tree with the keys of [first, last). Repeated keys
+	 * are inserted once
+	 * Time complexity: O(this->size() + n) if the range is sorted,
+	 * O(this->size() + n * log(n)) otherwise
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 */
+	template<class ForwardIt>
+	void assign(ForwardIt first, ForwardIt last) {
+		this->p_assign(first, last);
+	}
+
+	/**
+	 * @brief Replaces the keys of the tree with the keys of [first, last), that must be
+	 * on strictly increasing order. The new tree is a 2-3 tree of minimum height, and its
+	 * nodes are allocated on key order
+	 * Time complexity: O(this->size() + n)
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 */
+	template<class ForwardIt>
+	void assign_sorted(ForwardIt first, ForwardIt last) {
+		this->p_assign_sorted(first, last);
+	}
+
+	bool contains(Key const& key) const {
+		return p_find(root, key) != nullptr;
+	}
+
+	/**
+	 * @brief contains for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	bool contains(K const& key) const {
+		return p_find(root, key) != nullptr;
 	}
 
 	void insert(Key const& key) {
 		root = p_insert(root, key);
+		root->color = BLACK;
 	}
 
 	void erase(Key const& key) {
+		if (p_find(root, key) == nullptr) return;
+
+		if (!isRed(root->left) && !isRed(root->right))
+			root->color = RED;
+
 		root = p_erase(root, key);
+		if (root != nullptr) root->color = BLACK;
 	}
 
-	bool count(Key const& key) {
-		return p_contains(root, key) ? 1 : 0;
+	bool count(Key const& key) const {
+		return p_find(root, key) != nullptr ? 1 : 0;
+	}
+
+	/**
+	 * @brief count for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	bool count(K const& key) const {
+		return p_find(root, key) != nullptr ? 1 : 0;
+	}
+
+	/**
+	 * @brief Writes contains(key) for every key of [first, last), on the same order. The
+	 * lookups are interleaved (see BATCH_GROUP), so it is faster than calling contains
+	 * once per key when the tree does not fit on the cache
+	 * Time complexity: O(k * log(this->size())), k is the number of keys
+	 * @param first First key
+	 * @param last Past the last key
+	 * @param out Output iterator of bool
+	 * @return OutputIt Past the last written value
+	 */
+	template<class ForwardIt, class OutputIt>
+	OutputIt contains_batch(ForwardIt first, ForwardIt last, OutputIt out) const {
+		return p_batch(first, last, out, [](Node const* node) { return node != nullptr; });
+	}
+
+	/**
+	 * @brief Writes, for every key of [first, last) and on the same order, a pointer to the
+	 * key on the tree, or nullptr if it is not on it. The lookups are interleaved (see
+	 * BATCH_GROUP). The pointers are invalidated like the iterators
+	 * Time complexity: O(k * log(this->size())), k is the number of keys
+	 * @param first First key
+	 * @param last Past the last key
+	 * @param out Output iterator of Key const*
+	 * @return OutputIt Past the last written value
+	 */
+	template<class ForwardIt, class OutputIt>
+	OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) const {
+		return p_batch(first, last, out, [](Node const* node) -> Key const* {
+			return node == nullptr ? nullptr : &node->key;
+		});
+	}
+
+	/**
+	 * @brief Iterator to the smallest key
+	 * Time complexity: O(log(this->size()))
+	 */
+	iterator begin() const {
+		iterator it(root);
+		it.p_push_leftmost(root);
+		return it;
+	}
+
+	/**
+	 * @brief Iterator past the greatest key
+	 * Time complexity: O(1)
+	 */
+	iterator end() const {
+		return iterator(root);
+	}
+
+	/**
+	 * @brief Iterator to key, or end() if it is not on the tree
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator find(Key const& key) const {
+		return p_find_iterator(key);
+	}
+
+	/**
+	 * @brief find for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	iterator find(K const& key) const {
+		return p_find_iterator(key);
+	}
+
+	/**
+	 * @brief Iterator to the first key not less than key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator lower_bound(Key const& key) const {
+		return p_lower_bound(key);
+	}
+
+	/**
+	 * @brief lower_bound for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	iterator lower_bound(K const& key) const {
+		return p_lower_bound(key);
+	}
+
+	/**
+	 * @brief Iterator to the first key greater than key
+	 * Time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator upper_bound(Key const& key) const {
+		return p_upper_bound(key);
+	}
+
+	/**
+	 * @brief upper_bound for any type comparable with Key, if the Comparator is transparent
+	 * Time complexity: O(log(this->size()))
+	 */
+	template<class K, class C = Comparator, class = typename C::is_transparent>
+	iterator upper_bound(K const& key) const {
+		return p_upper_bound(key);
+	}
+
+	/**
+	 * @brief Calls f with every key on the half-open range [lo, hi), on increasing order.
+	 * It does not allocate.
+	 * Time complexity: O(log(this->size()) + k), k is the number of keys on the range
+	 * @tparam F Callable with a Key const&
+	 * @param lo Lower bound, included
+	 * @param hi Upper bound, excluded
+	 * @param f Function to call
+	 */
+	template<class F>
+	void for_each_in_range(Key const& lo, Key const& hi, F f) const {
+		for (iterator it = lower_bound(lo); it.depth != 0 && comparator(*it, hi); ++it) {
+			f(*it);
+		}
 	}
-};
\ No newline at end of file
+};
+
+/**
+ * @brief Swaps the two trees
+ * Time complexity: O(1)
+ * This implementation is intended to be found by the ADL algorithm
+ */
+template<typename Key, class C, class A>
+void swap(LeftLeaningRedBlackTree<Key, C, A>& lhs, LeftLeaningRedBlackTree<Key, C, A>& rhs) {
+	lhs.swap(rhs);
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+/**
+ * @brief Builds the ordered containers from any range of keys. <br>
+ * Sorted ranges (without duplicates) are built directly by the container, with its
+ * 'p_assign_sorted' in O(n). The others are copied, sorted and deduplicated first, in
+ * O(n * log(n)). <br>
+ * The containers declare this class as a friend, to reach their p_assign_sorted.
+ * @tparam Key Keys' type
+ * @tparam Comparator Strict weak ordering between keys
+ */
+template<class Key, class Comparator>
+class sorted_range {
+public:
+	/**
+	 * @brief Replaces the keys of container with the keys of [first, last), inserting
+	 * repeated keys once
+	 * @param container Container with a p_assign_sorted(first, last)
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 * @param less Ordering of the container
+	 */
+	template<class Container, class ForwardIt>
+	static void assign(Container& container, ForwardIt first, ForwardIt last, Comparator const& less) {
+		auto not_less = [&less](Key const& a, Key const& b) { return !less(a, b); };
+		if (std::adjacent_find(first, last, not_less) == last) {
+			container.p_assign_sorted(first, last);
+		}
+		else {
+			std::vector<Key> keys(first, last);
+			std::sort(keys.begin(), keys.end(), less);
+			keys.erase(std::unique(keys.begin(), keys.end(), not_less), keys.end());
+			container.p_assign_sorted(std::make_move_iterator(keys.begin()), std::make_move_iterator(keys.end()));
+		}
+	}
+};
@@ -0,0 +1,817 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "SortedRange.hpp"
+
+/**
+ * @brief SplayTree <br>
+ * Ordered set implemented as a splay tree: every insert, erase and (non-const) lookup
+ * moves the key it reaches to the root, so recently used keys are found after a few
+ * comparisons. On skewed (for example, Zipfian) accesses its cost is proportional to
+ * the entropy of the access distribution instead of log(n). <br>
+ * Non-const lookups (contains, count, find, begin, lower_bound, upper_bound,
+ * for_each_in_range) restructure the tree, so they are writes for synchronization
+ * purposes. Their const overloads only search, in O(depth). <br>
+ * Nodes have parent pointers, so iterators stay valid until their key is erased. The
+ * tree can be as deep as the number of keys, nothing is recursive on its height. <br>
+ * Node allocations are made using the Allocator (rebound to the node type) <br>
+ * @see https://en.wikipedia.org/wiki/Splay_tree
+ * @see Sleator, Tarjan, Self-Adjusting Binary Search Trees, 1985
+ * @tparam Key Elements' type this tree will store
+ * @tparam Comparator Strict weak ordering between keys
+ * @tparam Allocator Keys' allocator
+ */
+template <typename Key, class Comparator = std::less<Key>, class Allocator = std::allocator<Key>>
+class SplayTree {
+protected:
+	/**
+	 * @brief Uses the first swap found by the ADL algorithm. <br>
+	 * This should find the user-defined swap before the generic std::swap, that makes
+	 * three moves
+	 * @tparam U Type
+	 * @param left Left object
+	 * @param right Right object
+	 */
+	template<typename U>
+	void p_adl_swap(U& left, U& right) {
+		using std::swap;
+		swap(left, right); // ADL swap
+	}
+
+	struct Node {
+		Key e;
+		Node* left;
+		Node* right;
+		Node* parent;
+	};
+
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+
+	using alloc_key_traits = std::allocator_traits<Allocator>;
+	using alloc_node_traits = std::allocator_traits<NodeAllocator>;
+
+	NodeAllocator alloc_node;
+	Allocator alloc_key;
+	Comparator comparator;
+
+	Node* root;
+	std::size_t _size;
+
+	void p_destroy(Node* node) {
+		alloc_key_traits::destroy(alloc_key, &node->e);
+		alloc_node_traits::deallocate(alloc_node, node, 1);
+		--this->_size;
+	}
+
+	/**
+	 * @brief Destroys the subtree without recursion: left children are rotated up until
+	 * the node has none, then it is destroyed and its right subtree follows
+	 */
+	void p_del(Node* node) {
+		while (node != nullptr) {
+			if (node->left != nullptr) {
+				Node* l = node->left;
+				node->left = l->right;
+				l->right = node;
+				node = l;
+			}
+			else {
+				Node* next = node->right;
+				p_destroy(node);
+				node = next;
+			}
+		}
+	}
+
+	template<class... Args>
+	Node* p_create(Args&&... args) {
+		Node* node = alloc_node_traits::allocate(alloc_node, 1);
+		alloc_key_traits::construct(alloc_key, &node->e, std::forward<Args>(args)...);
+
+		node->left = nullptr;
+		node->right = nullptr;
+		node->parent = nullptr;
+		++this->_size;
+
+		return node;
+	}
+
+	void p_default() {
+		this->root = nullptr;
+		this->_size = 0;
+	}
+
+	void p_new(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_default();
+		this->comparator = c;
+		this->alloc_key = alloc;
+		this->alloc_node = NodeAllocator(alloc);
+	}
+
+	void p_delete() {
+		this->p_del(this->root);
+		this->p_default();
+	}
+
+	/**
+	 * @brief The copy is perfectly balanced, the shape of other is not kept
+	 */
+	void p_copy(SplayTree const& other) {
+		this->p_default();
+		this->comparator = other.comparator;
+		this->alloc_key = other.alloc_key;
+		this->alloc_node = alloc_node_traits::select_on_container_copy_construction(other.alloc_node);
+
+		iterator it = other.begin();
+		this->root = p_build(it, other._size, nullptr);
+	}
+
+	void p_move(SplayTree& other) {
+		this->comparator = std::move(other.comparator);
+		this->alloc_key = std::move(other.alloc_key);
+		this->alloc_node = std::move(other.alloc_node);
+		this->root = other.root;
+		this->_size = other._size;
+
+		other.p_default();
+	}
+
+	void p_swap(SplayTree& other) {
+		p_adl_swap(this->comparator, other.comparator);
+		p_adl_swap(this->alloc_key, other.alloc_key);
+		p_adl_swap(this->alloc_node, other.alloc_node);
+		p_adl_swap(this->root, other.root);
+		p_adl_swap(this->_size, other._size);
+	}
+
+	/**
+	 * @brief Rotates node over its parent
+	 */
+	void p_rotate(Node* node) {
+		Node* parent = node->parent;
+		Node* grandparent = parent->parent;
+
+		if (parent->left == node) {
+			parent->left = node->right;
+			if (node->right != nullptr) node->right->parent = parent;
+			node->right = parent;
+		}
+		else {
+			parent->right = node->left;
+			if (node->left != nullptr) node->left->parent = parent;
+			node->left = parent;
+		}
+		parent->parent = node;
+		node->parent = grandparent;
+
+		if (grandparent == nullptr) this->root = node;
+		else if (grandparent->left == parent) grandparent->left = node;
+		else grandparent->right = node;
+	}
+
+	/**
+	 * @brief Moves node to the root with zig-zig and zig-zag steps, that roughly halve
+	 * the depth of the nodes on its path
+	 */
+	void p_splay(Node* node) {
+		while (node->parent != nullptr) {
+			Node* parent = node->parent;
+			Node* grandparent = parent->parent;
+			if (grandparent != nullptr) {
+				if ((grandparent->left == parent) == (parent->left == node)) p_rotate(parent); // zig-zig
+				else p_rotate(node); // zig-zag
+			}
+			p_rotate(node);
+		}
+	}
+
+	/**
+	 * @brief Searches the key without splaying
+	 * @param last Last node visited, nullptr if the tree is empty
+	 * @return Node* Node with the key, or nullptr
+	 */
+	Node* p_search(Key const& key, Node*& last) const {
+		last = nullptr;
+		Node* node = this->root;
+		while (node != nullptr) {
+			last = node;
+			if (comparator(key, node->e)) node = node->left;
+			else if (comparator(node->e, key)) node = node->right;
+			else return node;
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @brief Searches the key and splays the last node visited, so misses also adapt
+	 * @return Node* Node with the key (the root now), or nullptr
+	 */
+	Node* p_access(Key const& key) {
+		Node* last;
+		Node* node = p_search(key, last);
+		if (last != nullptr) p_splay(last);
+		return node;
+	}
+
+	/**
+	 * @brief First node not less than key, without splaying
+	 * @param last Last node visited, nullptr if the tree is empty
+	 */
+	Node* p_lower_bound(Key const& key, Node*& last) const {
+		Node* found = nullptr;
+		last = nullptr;
+		Node* node = this->root;
+		while (node != nullptr) {
+			last = node;
+			if (comparator(node->e, key)) {
+				node = node->right;
+			}
+			else {
+				found = node;
+				node = node->left;
+			}
+		}
+		return found;
+	}
+
+	/**
+	 * @brief First node greater than key, without splaying
+	 * @param last Last node visited, nullptr if the tree is empty
+	 */
+	Node* p_upper_bound(Key const& key, Node*& last) const {
+		Node* found = nullptr;
+		last = nullptr;
+		Node* node = this->root;
+		while (node != nullptr) {
+			last = node;
+			if (comparator(key, node->e)) {
+				found = node;
+				node = node->left;
+			}
+			else {
+				node = node->right;
+			}
+		}
+		return found;
+	}
+
+	/**
+	 * @brief Links a new node under parent and splays it
+	 */
+	void p_link(Node* node, Node* parent) {
+		node->parent = parent;
+		if (parent == nullptr) this->root = node;
+		else if (comparator(node->e, parent->e)) parent->left = node;
+		else parent->right = node;
+		p_splay(node);
+	}
+
+	/**
+	 * @brief Inserts the key, constructing the node only if it is not on the tree
+	 * @tparam K Key const& or Key&&
+	 */
+	template<class K>
+	void p_insert(K&& elem) {
+		Node* last;
+		Node* node = p_search(elem, last);
+		if (node != nullptr) {
+			p_splay(node);
+			return;
+		}
+		p_link(p_create(std::forward<K>(elem)), last);
+	}
+
+	/**
+	 * @brief Links an already created node. If its key is on the tree, it is destroyed
+	 */
+	void p_insert_node(Node* new_node) {
+		Node* last;
+		Node* node = p_search(new_node->e, last);
+		if (node != nullptr) {
+			p_destroy(new_node);
+			p_splay(node);
+			return;
+		}
+		p_link(new_node, last);
+	}
+
+	void p_erase(Key const& elem) {
+		Node* node = p_access(elem);
+		if (node == nullptr) return;
+
+		// node is the root, its greatest left key replaces it
+		Node* left = node->left;
+		Node* right = node->right;
+		if (left == nullptr) {
+			this->root = right;
+			if (right != nullptr) right->parent = nullptr;
+		}
+		else {
+			left->parent = nullptr;
+			this->root = left;
+
+			Node* max = left;
+			while (max->right != nullptr) max = max->right;
+			p_splay(max);
+
+			max->right = right;
+			if (right != nullptr) right->parent = max;
+		}
+
+		p_destroy(node);
+	}
+
+	/**
+	 * @brief Builds a perfectly balanced tree with the next n keys of a sorted sequence.
+	 * Nodes are created on key order, so they are allocated one after the other
+	 * @param it Iterator to the first key, it is left after the last one
+	 */
+	template<class ForwardIt>
+	Node* p_build(ForwardIt& it, std::size_t n, Node* parent) {
+		if (n == 0) return nullptr;
+
+		Node* left = p_build(it, n / 2, nullptr);
+		Node* node = p_create(*it);
+		++it;
+		node->parent = parent;
+		node->left = left;
+		if (left != nullptr) left->parent = node;
+		node->right = p_build(it, n - 1 - n / 2, node);
+
+		return node;
+	}
+
+	template<class ForwardIt>
+	void p_assign_sorted(ForwardIt first, ForwardIt last) {
+		this->p_delete();
+		this->root = p_build(first, std::distance(first, last), nullptr);
+	}
+
+	friend class sorted_range<Key, Comparator>;
+
+	/** @see sorted_range::assign */
+	template<class ForwardIt>
+	void p_assign(ForwardIt first, ForwardIt last) {
+		sorted_range<Key, Comparator>::assign(*this, first, last, this->comparator);
+	}
+
+public:
+
+	/**
+	 * @brief Bidirectional iterator over the keys, on increasing order. It follows the
+	 * parent pointers, so lookups (that only relink nodes) do not invalidate it, only
+	 * erasing its key does.
+	 */
+	class iterator {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = Key;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Key const*;
+		using reference = Key const&;
+
+	private:
+		friend class SplayTree;
+
+		SplayTree const* tree;
+		Node* node; // nullptr on end()
+
+		iterator(SplayTree const* tree, Node* node) : tree(tree), node(node) {}
+
+		static Node* p_leftmost(Node* node) {
+			while (node->left != nullptr) node = node->left;
+			return node;
+		}
+
+		static Node* p_rightmost(Node* node) {
+			while (node->right != nullptr) node = node->right;
+			return node;
+		}
+
+	public:
+		iterator() : tree(nullptr), node(nullptr) {}
+
+		reference operator*() const {
+			return node->e;
+		}
+
+		pointer operator->() const {
+			return &node->e;
+		}
+
+		/**
+		 * @brief Next key
+		 * Time complexity: O(depth)
+		 * Amortized time complexity: O(1)
+		 */
+		iterator& operator++() {
+			if (node->right != nullptr) {
+				node = p_leftmost(node->right);
+			}
+			else {
+				// Go up while coming from a right child
+				Node* child = node;
+				node = node->parent;
+				while (node != nullptr && node->right == child) {
+					child = node;
+					node = node->parent;
+				}
+			}
+			return *this;
+		}
+
+		iterator operator++(int) {
+			iterator old(*this);
+			++(*this);
+			return old;
+		}
+
+		/**
+		 * @brief Previous key. Decrementing end() gives the greatest key
+		 * Time complexity: O(depth)
+		 * Amortized time complexity: O(1)
+		 */
+		iterator& operator--() {
+			if (node == nullptr) {
+				node = p_rightmost(tree->root);
+			}
+			else if (node->left != nullptr) {
+				node = p_rightmost(node->left);
+			}
+			else {
+				// Go up while coming from a left child
+				Node* child = node;
+				node = node->parent;
+				while (node != nullptr && node->left == child) {
+					child = node;
+					node = node->parent;
+				}
+			}
+			return *this;
+		}
+
+		iterator operator--(int) {
+			iterator old(*this);
+			--(*this);
+			return old;
+		}
+
+		bool operator==(iterator const& other) const {
+			return node == other.node;
+		}
+
+		bool operator!=(iterator const& other) const {
+			return node != other.node;
+		}
+	};
+
+	using const_iterator = iterator;
+
+	/**
+	 * @brief Construct a new SplayTree object
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	SplayTree(Comparator const& c = Comparator(), Allocator const& alloc = Allocator()) {
+		this->p_new(c, alloc);
+	}
+
+	/**
+	 * @brief Construct a new SplayTree object with the keys of [first, last). Repeated
+	 * keys are inserted once
+	 * Time complexity: O(n) if the range is sorted, O(n * log(n)) otherwise
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 * @param c Comparator to use
+	 * @param alloc Allocator to use
+	 */
+	template<class ForwardIt>
+	SplayTree(ForwardIt first, ForwardIt last, Comparator const& c = Comparator(),
+		Allocator const& alloc = Allocator())
+	{
+		this->p_new(c, alloc);
+		this->p_assign(first, last);
+	}
+
+	/**
+	 * @brief Construct a new SplayTree object by copy
+	 * Time complexity: O(other.size())
+	 * @param other The other tree to copy
+	 */
+	SplayTree(SplayTree const& other) {
+		this->p_copy(other);
+	}
+
+	/**
+	 * @brief Construct a new SplayTree object by move
+	 * Time complexity: O(1)
+	 * @param other The other tree to move
+	 */
+	SplayTree(SplayTree&& other) noexcept {
+		this->p_move(other);
+	}
+
+	/**
+	 * @brief Destroy the SplayTree object
+	 * Time complexity: O(this->size())
+	 */
+	~SplayTree() {
+		this->p_delete();
+	}
+
+	/**
+	 * @brief Copy assignment operator
+	 * Time complexity: O(other.size() + this->size())
+	 * @param other The other tree to copy
+	 * @return SplayTree& Reference to *this
+	 */
+	SplayTree& operator=(SplayTree const& other) {
+		if (this != &other) {
+			this->p_delete();
+			this->p_copy(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Move assignment operator
+	 * Time complexity: O(this->size())
+	 * @param other The other tree to move
+	 * @return SplayTree& Reference to *this
+	 */
+	SplayTree& operator=(SplayTree&& other) noexcept {
+		if (this != &other) {
+			this->p_delete();
+			this->p_move(other);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Swap the two trees
+	 * Time complexity: O(1)
+	 * @param other The other tree
+	 */
+	void swap(SplayTree& other) {
+		this->p_swap(other);
+	}
+
+	/**
+	 * @brief Inserts a copy of key, if it is not on the tree. Either way, key ends on
+	 * the root
+	 * Amortized time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	void insert(Key const& key) {
+		this->p_insert(key);
+	}
+
+	/**
+	 * @brief Inserts key moving it, if it is not on the tree. Either way, key ends on
+	 * the root
+	 * Amortized time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	void insert(Key&& key) {
+		this->p_insert(std::move(key));
+	}
+
+	/**
+	 * @brief Constructs a key on the tree. It is destroyed if it was already on the tree
+	 * Amortized time complexity: O(log(this->size()) + creation)
+	 * @tparam Args Template parameter list, type parameters of the key constructor
+	 * @param args Parameters list of the key constructor
+	 */
+	template<class... Args>
+	void emplace(Args&&... args) {
+		this->p_insert_node(p_create(std::forward<Args>(args)...));
+	}
+
+	/**
+	 * @brief Erases key, if it is on the tree
+	 * Amortized time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	void erase(Key const& key) {
+		this->p_erase(key);
+	}
+
+	/**
+	 * @brief Replaces the keys of the tree with the keys of [first, last). Repeated keys
+	 * are inserted once
+	 * Time complexity: O(this->size() + n) if the range is sorted,
+	 * O(this->size() + n * log(n)) otherwise
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 */
+	template<class ForwardIt>
+	void assign(ForwardIt first, ForwardIt last) {
+		this->p_assign(first, last);
+	}
+
+	/**
+	 * @brief Replaces the keys of the tree with the keys of [first, last), that must be
+	 * on strictly increasing order
+	 * Time complexity: O(this->size() + n)
+	 * @param first Iterator to the first key
+	 * @param last Iterator past the last key
+	 */
+	template<class ForwardIt>
+	void assign_sorted(ForwardIt first, ForwardIt last) {
+		this->p_assign_sorted(first, last);
+	}
+
+	/**
+	 * @brief If key is on the tree. The last node visited is splayed to the root
+	 * Amortized time complexity: O(log(this->size())), less for frequent keys
+	 * @param key The key
+	 */
+	bool contains(Key const& key) {
+		return p_access(key) != nullptr;
+	}
+
+	/**
+	 * @brief If key is on the tree, without restructuring it
+	 * Time complexity: O(depth)
+	 * @param key The key
+	 */
+	bool contains(Key const& key) const {
+		Node* last;
+		return p_search(key, last) != nullptr;
+	}
+
+	/**
+	 * @brief 1 if key is on the tree, 0 otherwise. The last node visited is splayed to
+	 * the root
+	 * Amortized time complexity: O(log(this->size()))
+	 */
+	std::size_t count(Key const& key) {
+		return contains(key) ? 1 : 0;
+	}
+
+	/**
+	 * @brief count without restructuring the tree
+	 * Time complexity: O(depth)
+	 */
+	std::size_t count(Key const& key) const {
+		return contains(key) ? 1 : 0;
+	}
+
+	/**
+	 * @brief Iterator to key, or end(). The last node visited is splayed to the root
+	 * Amortized time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator find(Key const& key) {
+		return iterator(this, p_access(key));
+	}
+
+	/**
+	 * @brief find without restructuring the tree
+	 * Time complexity: O(depth)
+	 */
+	iterator find(Key const& key) const {
+		Node* last;
+		return iterator(this, p_search(key, last));
+	}
+
+	/**
+	 * @brief Iterator to the smallest key, which is splayed to the root
+	 * Amortized time complexity: O(log(this->size()))
+	 */
+	iterator begin() {
+		if (root == nullptr) return end();
+		Node* node = iterator::p_leftmost(root);
+		p_splay(node);
+		return iterator(this, node);
+	}
+
+	/**
+	 * @brief begin without restructuring the tree
+	 * Time complexity: O(depth)
+	 */
+	iterator begin() const {
+		if (root == nullptr) return end();
+		return iterator(this, iterator::p_leftmost(root));
+	}
+
+	/**
+	 * @brief Iterator past the greatest key
+	 * Time complexity: O(1)
+	 */
+	iterator end() const {
+		return iterator(this, nullptr);
+	}
+
+	/**
+	 * @brief Iterator to the first key not less than key. The last node visited is
+	 * splayed to the root
+	 * Amortized time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator lower_bound(Key const& key) {
+		Node* last;
+		Node* found = p_lower_bound(key, last);
+		if (last != nullptr) p_splay(last);
+		return iterator(this, found);
+	}
+
+	/**
+	 * @brief lower_bound without restructuring the tree
+	 * Time complexity: O(depth)
+	 */
+	iterator lower_bound(Key const& key) const {
+		Node* last;
+		return iterator(this, p_lower_bound(key, last));
+	}
+
+	/**
+	 * @brief Iterator to the first key greater than key. The last node visited is splayed
+	 * to the root
+	 * Amortized time complexity: O(log(this->size()))
+	 * @param key The key
+	 */
+	iterator upper_bound(Key const& key) {
+		Node* last;
+		Node* found = p_upper_bound(key, last);
+		if (last != nullptr) p_splay(last);
+		return iterator(this, found);
+	}
+
+	/**
+	 * @brief upper_bound without restructuring the tree
+	 * Time complexity: O(depth)
+	 */
+	iterator upper_bound(Key const& key) const {
+		Node* last;
+		return iterator(this, p_upper_bound(key, last));
+	}
+
+	/**
+	 * @brief Calls f with every key on the half-open range [lo, hi), on increasing order.
+	 * The first key of the range (or the last node visited, if it is empty) is splayed
+	 * to the root. It does not allocate
+	 * Amortized time complexity: O(log(this->size()) + k), k is the number of keys on
+	 * the range
+	 * @tparam F Callable with a Key const&
+	 * @param lo Lower bound, included
+	 * @param hi Upper bound, excluded
+	 * @param f Function to call
+	 */
+	template<class F>
+	void for_each_in_range(Key const& lo, Key const& hi, F f) {
+		Node* last;
+		Node* first = p_lower_bound(lo, last);
+		if (first != nullptr && comparator(first->e, hi)) p_splay(first);
+		else if (last != nullptr) p_splay(last);
+
+		for (iterator it(this, first); it.node != nullptr && comparator(*it, hi); ++it) {
+			f(*it);
+		}
+	}
+
+	/**
+	 * @brief for_each_in_range without restructuring the tree
+	 * Time complexity: O(depth + k), k is the number of keys on the range
+	 */
+	template<class F>
+	void for_each_in_range(Key const& lo, Key const& hi, F f) const {
+		Node* last;
+		for (iterator it(this, p_lower_bound(lo, last)); it.node != nullptr && comparator(*it, hi); ++it) {
+			f(*it);
+		}
+	}
+
+	/**
+	 * @brief Number of elements
+	 * Time complexity: O(1)
+	 */
+	std::size_t size() const {
+		return this->_size;
+	}
+
+	/**
+	 * @brief If the tree is empty
+	 * Time complexity: O(1)
+	 */
+	bool empty() const {
+		return root == nullptr;
+	}
+};
+
+/**
+ * @brief Swaps the two trees
+ * Time complexity: O(1)
+ * This implementation is intended to be found by the ADL algorithm
+ */
+template<typename Key, class C, class A>
+void swap(SplayTree<Key, C, A>& lhs, SplayTree<Key, C, A>& rhs) {
+	lhs.swap(rhs);
+}
@@ -2,6 +2,7 @@
 #include "HeapTest.hpp"
 
 #include "heaps/BinomialHeap.hpp"
+#include "allocators/BlockAllocator.hpp"
 
 TEST(BinomialHeapTest, Construct) {
 	construct_test<BinomialHeap<int>>();
@@ -69,3 +70,39 @@ TEST(BinomialHeapTest, Merge) {
 TEST(BinomialHeapTest, BigMerge) {
 	big_merge_test<BinomialHeap<int>>();
 }
+
+TEST(BinomialHeapTest, BigCopy) {
+	big_copy_test<BinomialHeap<int>>();
+}
+
+TEST(BinomialHeapTest, BigDestroy) {
+	big_destroy_test<BinomialHeap<int>>();
+}
+
+TEST(BinomialHeapTest, BlockAllocatorBigPush) {
+	big_push1_test<BinomialHeap<int, std::greater<int>, BlockAllocator<int>>>();
+}
+
+TEST(BinomialHeapTest, BlockAllocatorMerge) {
+	merge_test<BinomialHeap<int, std::greater<int>, BlockAllocator<int>>>();
+}
+
+TEST(BinomialHeapTest, BlockAllocatorBigCopy) {
+	big_copy_test<BinomialHeap<int, std::greater<int>, BlockAllocator<int>>>();
+}
+
+TEST(BinomialHeapTest, MeldAll) {
+	meld_all_test<BinomialHeap<int>>(false);
+}
+
+TEST(BinomialHeapTest, MeldAllParallel) {
+	meld_all_test<BinomialHeap<int>>(true);
+}
+
+TEST(BinomialHeapTest, BlockAllocatorMeldAll) {
+	meld_all_test<BinomialHeap<int, std::greater<int>, BlockAllocator<int>>>(false);
+}
+
+TEST(BinomialHeapTest, Range) {
+	range_test<BinomialHeap<int>>();
+}
@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+#include "HeapTest.hpp"
+
+#include "heaps/CompactFibonacciHeap.hpp"
+
+#include <string>
+#include <vector>
+
+TEST(CompactFibonacciHeapTest, Construct) {
+	construct_test<CompactFibonacciHeap<int>>();
+}
+
+TEST(CompactFibonacciHeapTest, ConstructCopy) {
+	construct_copy_test<CompactFibonacciHeap<int>>();
+}
+
+TEST(CompactFibonacciHeapTest, ConstructMove) {
+	construct_move_test<CompactFibonacciHeap<int>>();
+}
+
+TEST(CompactFibonacciHeapTest, Push1) {
+	push1_test<CompactFibonacciHeap<int>>();
+}
+
+TEST(CompactFibonacciHeapTest, Push2) {
+	push2_test<CompactFibonacciHeap<int>>();
+}
+
+TEST(CompactFibonacciHeapTest, Emplace1) {
+	emplace1_reverse_test<CompactFibonacciHeap<int, std::less<int>>>();
+}
+
+TEST(CompactFibonacciHeapTest, BigPush1) {
+	big_push1_test<CompactFibonacciHeap<int>>();
+}
+
+TEST(CompactFibonacciHeapTest, BigPush2) {
+	big_push2_test<CompactFibonacciHeap<int>>();
+}
+
+TEST(CompactFibonacciHeapTest, NestedHeap) {
+	CompactFibonacciHeap<int> h0;
+	CompactFibonacciHeap<int> h1;
+	h1.push(1);
+	CompactFibonacciHeap<int> h2;
+	h2.push(2);
+	h2.push(3);
+
+	CompactFibonacciHeap<CompactFibonacciHeap<int>, std::function<bool(const CompactFibonacciHeap<int>&, const CompactFibonacciHeap<int>&)>> heap(
+		[](const CompactFibonacciHeap<int>& left, const CompactFibonacciHeap<int>& right) {
+		return left.size() < right.size();
+		}
+	);
+
+	heap.push(h0);
+	heap.push(h1);
+	heap.push(h2);
+
+	EXPECT_EQ(heap.pop().size(), 0);
+	EXPECT_EQ(heap.pop().size(), 1);
+	EXPECT_EQ(heap.pop().size(), 2);
+}
+
+TEST(CompactFibonacciHeapTest, RaisesExceptionWhenEmpty) {
+	raises_exception_when_empty_test<CompactFibonacciHeap<int>>();
+}
+
+TEST(CompactFibonacciHeapTest, MergeTest) {
+	merge_test<CompactFibonacciHeap<int>>();
+}
+
+TEST(CompactFibonacciHeapTest, BigMerge) {
+	big_merge_test<CompactFibonacciHeap<int>>();
+}
+
+TEST(CompactFibonacciHeapTest, DecreaseKey) {
+	decrease_key_test<CompactFibonacciHeap<int>>();
+}
+
+TEST(CompactFibonacciHeapTest, BigDecreaseKey) {
+	big_decrease_key_test<CompactFibonacciHeap<int>>();
+}
+
+TEST(CompactFibonacciHeapTest, BigCopy) {
+	big_copy_test<CompactFibonacciHeap<int>>();
+}
+
+TEST(CompactFibonacciHeapTest, BigDestroy) {
+	big_destroy_test<CompactFibonacciHeap<int>>();
+}
+
+TEST(CompactFibonacciHeapTest, NonTrivialKey) {
+	CompactFibonacciHeap<std::string> heap;
+	heap.push("b");
+	heap.push("d");
+	auto node = heap.push("a");
+	heap.push("c");
+
+	heap.decreaseKey(node, "e");
+
+	EXPECT_EQ(heap.pop(), "e");
+	EXPECT_EQ(heap.pop(), "d");
+	EXPECT_EQ(heap.pop(), "c");
+	EXPECT_EQ(heap.pop(), "b");
+	EXPECT_TRUE(heap.empty());
+}
+
+TEST(CompactFibonacciHeapTest, HandlesSurviveGrowth) {
+	CompactFibonacciHeap<int> heap;
+	std::vector<CompactFibonacciHeap<int>::handle_type> nodes;
+	for (int i = 0; i < 1000; ++i) {
+		nodes.push_back(heap.push(i));
+	}
+
+	heap.decreaseKey(nodes[10], 5000);
+	EXPECT_EQ(heap.pop(), 5000);
+	EXPECT_EQ(heap.pop(), 999);
+}
@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+#include "HeapTest.hpp"
+
+#include "heaps/FibonacciHeap.hpp"
+#include "allocators/BlockAllocator.hpp"
+
+TEST(EagerFibonacciHeapTest, Emplace1) {
+	emplace1_reverse_test<EagerFibonacciHeap<int, std::less<int>>>();
+}
+
+TEST(EagerFibonacciHeapTest, Construct) {
+	construct_test<EagerFibonacciHeap<int>>();
+}
+
+TEST(EagerFibonacciHeapTest, ConstructCopy) {
+	construct_copy_test<EagerFibonacciHeap<int>>();
+}
+
+TEST(EagerFibonacciHeapTest, ConstructMove) {
+	construct_move_test<EagerFibonacciHeap<int>>();
+}
+
+TEST(EagerFibonacciHeapTest, Push1) {
+	push1_test<EagerFibonacciHeap<int>>();
+}
+
+TEST(EagerFibonacciHeapTest, Push2) {
+	push2_test<EagerFibonacciHeap<int>>();
+}
+
+TEST(EagerFibonacciHeapTest, BigPush1) {
+	big_push1_test<EagerFibonacciHeap<int>>();
+}
+
+TEST(EagerFibonacciHeapTest, BigPush2) {
+	big_push2_test<EagerFibonacciHeap<int>>();
+}
+
+TEST(EagerFibonacciHeapTest, RaisesExceptionWhenEmpty) {
+	raises_exception_when_empty_test<EagerFibonacciHeap<int>>();
+}
+
+TEST(EagerFibonacciHeapTest, MergeTest) {
+	merge_test<EagerFibonacciHeap<int>>();
+}
+
+TEST(EagerFibonacciHeapTest, BigMerge) {
+	big_merge_test<EagerFibonacciHeap<int>>();
+}
+
+TEST(EagerFibonacciHeapTest, DecreaseKey) {
+	decrease_key_test<EagerFibonacciHeap<int>>();
+}
+
+TEST(EagerFibonacciHeapTest, BigDecreaseKey) {
+	big_decrease_key_test<EagerFibonacciHeap<int>>();
+}
+
+TEST(EagerFibonacciHeapTest, BigCopy) {
+	big_copy_test<EagerFibonacciHeap<int>>();
+}
+
+TEST(EagerFibonacciHeapTest, BigDestroy) {
+	big_destroy_test<EagerFibonacciHeap<int>>();
+}
+
+TEST(EagerFibonacciHeapTest, DuplicateMerge) {
+	duplicate_merge_test<EagerFibonacciHeap<int>>();
+}
+
+TEST(EagerFibonacciHeapTest, MeldAll) {
+	meld_all_test<EagerFibonacciHeap<int>>(false);
+}
+
+TEST(EagerFibonacciHeapTest, MeldAllParallel) {
+	meld_all_test<EagerFibonacciHeap<int>>(true);
+}
+
+TEST(EagerFibonacciHeapTest, BlockAllocatorBigPush) {
+	big_push1_test<EagerFibonacciHeap<int, std::greater<int>, BlockAllocator<int>>>();
+}
+
+TEST(EagerFibonacciHeapTest, BlockAllocatorMerge) {
+	merge_test<EagerFibonacciHeap<int, std::greater<int>, BlockAllocator<int>>>();
+}
+
+TEST(EagerFibonacciHeapTest, Range) {
+	range_test<EagerFibonacciHeap<int>>();
+}
@@ -2,6 +2,7 @@
 #include "HeapTest.hpp"
 
 #include "heaps/FibonacciHeap.hpp"
+#include "allocators/BlockAllocator.hpp"
 
 TEST(FibonacciHeapTest, Construct) {
 	construct_test<FibonacciHeap<int>>();
@@ -69,3 +70,51 @@ TEST(FibonacciHeapTest, MergeTest) {
 TEST(BinomialHeapTest, BigMerge) {
 	big_merge_test<FibonacciHeap<int>>();
 }
+
+TEST(FibonacciHeapTest, DecreaseKey) {
+	decrease_key_test<FibonacciHeap<int>>();
+}
+
+TEST(FibonacciHeapTest, BigDecreaseKey) {
+	big_decrease_key_test<FibonacciHeap<int>>();
+}
+
+TEST(FibonacciHeapTest, BigCopy) {
+	big_copy_test<FibonacciHeap<int>>();
+}
+
+TEST(FibonacciHeapTest, BigDestroy) {
+	big_destroy_test<FibonacciHeap<int>>();
+}
+
+TEST(FibonacciHeapTest, BlockAllocatorBigPush) {
+	big_push1_test<FibonacciHeap<int, std::greater<int>, BlockAllocator<int>>>();
+}
+
+TEST(FibonacciHeapTest, BlockAllocatorMerge) {
+	merge_test<FibonacciHeap<int, std::greater<int>, BlockAllocator<int>>>();
+}
+
+TEST(FibonacciHeapTest, BlockAllocatorBigCopy) {
+	big_copy_test<FibonacciHeap<int, std::greater<int>, BlockAllocator<int>>>();
+}
+
+TEST(FibonacciHeapTest, DuplicateMerge) {
+	duplicate_merge_test<FibonacciHeap<int>>();
+}
+
+TEST(FibonacciHeapTest, MeldAll) {
+	meld_all_test<FibonacciHeap<int>>(false);
+}
+
+TEST(FibonacciHeapTest, MeldAllParallel) {
+	meld_all_test<FibonacciHeap<int>>(true);
+}
+
+TEST(FibonacciHeapTest, BlockAllocatorMeldAll) {
+	meld_all_test<FibonacciHeap<int, std::greater<int>, BlockAllocator<int>>>(false);
+}
+
+TEST(FibonacciHeapTest, Range) {
+	range_test<FibonacciHeap<int>>();
+}
@@ -204,3 +204,242 @@ void big_merge_test(){
 
 	EXPECT_TRUE(heap1.empty());
 }
+
+#include <algorithm>
+#include <vector>
+template<class T>
+void duplicate_merge_test(){
+	std::default_random_engine random(1227992885);
+
+	// The top of the other heap has the same key as a root of this one
+	T heap1, heap2;
+	heap1.push(5);
+	heap1.push(5);
+	heap1.push(1);
+	heap2.push(5);
+	heap2.push(5);
+	heap2.push(2);
+	heap1.merge(heap2);
+	EXPECT_EQ(heap1.size(), 6);
+	for (int expected : {5, 5, 5, 5, 2, 1}) {
+		EXPECT_EQ(heap1.top(), expected); heap1.pop();
+	}
+	EXPECT_TRUE(heap1.empty());
+
+	// Small heaps with a few distinct keys, merged many times
+	for (int round = 0; round < 2000; ++round) {
+		T heap, other;
+		std::vector<int> keys;
+		std::size_t size = random() % 9, other_size = random() % 9;
+		for (std::size_t i = 0; i < size; ++i) {
+			keys.push_back(random() % 3);
+			heap.push(keys.back());
+		}
+		if (size > 1 && random() % 2 == 0) {
+			heap.pop(); // Builds trees of higher degree
+			keys.erase(std::max_element(keys.begin(), keys.end()));
+		}
+		for (std::size_t i = 0; i < other_size; ++i) {
+			keys.push_back(random() % 3);
+			other.push(keys.back());
+		}
+
+		heap.merge(other);
+		ASSERT_EQ(heap.size(), keys.size());
+		std::sort(keys.rbegin(), keys.rend());
+		for (int expected : keys) {
+			ASSERT_EQ(heap.top(), expected); heap.pop();
+		}
+		EXPECT_TRUE(heap.empty());
+	}
+}
+
+template<class T>
+void decrease_key_test(){
+	T heap;
+	heap.push(5);
+	auto node1 = heap.push(1);
+	heap.push(3);
+	auto node2 = heap.push(2);
+	heap.push(4);
+
+	EXPECT_EQ(heap.top(), 5);
+
+	heap.decreaseKey(node1, 6); // 1 -> 6
+	EXPECT_EQ(heap.top(), 6);
+
+	heap.decreaseKey(node2, 4); // 2 -> 4
+	EXPECT_THROW(heap.decreaseKey(node2, 0), std::invalid_argument);
+
+	EXPECT_EQ(heap.top(), 6); heap.pop();
+	EXPECT_EQ(heap.top(), 5); heap.pop();
+	EXPECT_EQ(heap.top(), 4); heap.pop();
+	EXPECT_EQ(heap.top(), 4); heap.pop();
+	EXPECT_EQ(heap.top(), 3); heap.pop();
+	EXPECT_TRUE(heap.empty());
+}
+
+#include <vector>
+#include <algorithm>
+template<class T>
+void big_decrease_key_test(){
+	T heap;
+	std::default_random_engine random(1227992885);
+	size_t size = 100000;
+	std::vector<decltype(heap.push(0))> nodes;
+	std::vector<int> keys;
+
+	for (std::size_t i = 0; i < size; ++i) {
+		int key = random() % 1000000;
+		nodes.push_back(heap.push(key));
+		keys.push_back(key);
+	}
+
+	// Pop some elements so the heap gets structure, their nodes are not used anymore
+	for (std::size_t i = 0; i < size / 10; ++i) {
+		heap.pop();
+	}
+	std::vector<int> sorted = keys;
+	std::sort(sorted.begin(), sorted.end());
+	int popped_limit = sorted[size - size / 10 - 1];
+
+	for (std::size_t i = 0; i < size; ++i) {
+		if (keys[i] < popped_limit && random() % 2 == 0) {
+			keys[i] += (popped_limit - keys[i]) / 2;
+			heap.decreaseKey(nodes[i], keys[i]);
+		}
+	}
+
+	int actual = heap.top(); heap.pop();
+	while (!heap.empty()) {
+		EXPECT_LE(heap.top(), actual);
+		actual = heap.top(); heap.pop();
+	}
+}
+
+template<class T>
+void big_copy_test(){
+	T heap1;
+	std::default_random_engine random(1227992885);
+	size_t size = 100000;
+
+	for (std::size_t i = 0; i < size; ++i) {
+		heap1.push(random());
+	}
+	heap1.pop(); // Gives some structure to the heap
+
+	T heap2(heap1);
+	EXPECT_EQ(heap1.size(), heap2.size());
+
+	while (!heap1.empty()) {
+		EXPECT_EQ(heap1.top(), heap2.top());
+		heap1.pop();
+		heap2.pop();
+	}
+	EXPECT_TRUE(heap2.empty());
+}
+
+template<class T>
+void big_destroy_test(){
+	std::default_random_engine random(1227992885);
+	size_t size = 1000000;
+
+	// Without pops some heaps keep a very long root list
+	T heap1;
+	for (std::size_t i = 0; i < size; ++i) {
+		heap1.push(random());
+	}
+
+	T heap2(heap1);
+	EXPECT_EQ(heap2.size(), size);
+}
+
+template<class T>
+void meld_all_test(bool parallel){
+	T heap;
+	std::vector<T> others(37);
+	std::default_random_engine random(1227992885);
+	size_t size = 1000;
+
+	for (std::size_t i = 0; i < size; ++i) {
+		heap.push(random());
+	}
+	for (std::size_t h = 0; h < others.size(); ++h) {
+		for (std::size_t i = 0; i < h * 10; ++i) {
+			others[h].push(random());
+		}
+	}
+	std::size_t total = size + 10 * others.size() * (others.size() - 1) / 2;
+
+	if (parallel) heap.meld_all_parallel(others.begin(), others.end(), 4);
+	else heap.meld_all(others.begin(), others.end());
+
+	EXPECT_EQ(heap.size(), total);
+	for (std::size_t h = 0; h < others.size(); ++h) {
+		EXPECT_TRUE(others[h].empty());
+		EXPECT_EQ(others[h].size(), 0);
+	}
+
+	int actual = heap.top(); heap.pop();
+	for (std::size_t i = 0; i < total - 1; ++i) {
+		EXPECT_LE(heap.top(), actual);
+		actual = heap.top(); heap.pop();
+	}
+	EXPECT_TRUE(heap.empty());
+
+	others[0].push(1); // Check that the others are usable
+	EXPECT_EQ(others[0].top(), 1);
+
+	// Into an empty heap, with empty heaps on the range (1, 4 and 7)
+	T empty_heap;
+	std::vector<T> batch(9);
+	std::size_t batch_total = 0;
+	for (std::size_t h = 0; h < batch.size(); ++h) {
+		if (h % 3 == 1) continue;
+		for (std::size_t i = 0; i < 20; ++i) {
+			batch[h].push(random());
+		}
+		batch_total += 20;
+	}
+
+	if (parallel) empty_heap.meld_all_parallel(batch.begin(), batch.end(), 4);
+	else empty_heap.meld_all(batch.begin(), batch.end());
+
+	EXPECT_EQ(empty_heap.size(), batch_total);
+	for (std::size_t h = 0; h < batch.size(); ++h) {
+		EXPECT_TRUE(batch[h].empty());
+	}
+
+	actual = empty_heap.top(); empty_heap.pop();
+	for (std::size_t i = 0; i < batch_total - 1; ++i) {
+		EXPECT_LE(empty_heap.top(), actual);
+		actual = empty_heap.top(); empty_heap.pop();
+	}
+	EXPECT_TRUE(empty_heap.empty());
+}
+
+template<class T>
+void range_test(){
+	std::default_random_engine random(1227992885);
+	size_t size = 100000;
+	std::vector<int> v;
+	for (std::size_t i = 0; i < size; ++i) {
+		v.push_back(random());
+	}
+
+	T heap(v.begin(), v.begin() + size / 2);
+	EXPECT_EQ(heap.size(), size / 2);
+
+	heap.push_range(v.begin() + size / 2, v.end());
+	EXPECT_EQ(heap.size(), size);
+
+	std::sort(v.begin(), v.end());
+	for (std::size_t i = 0; i < size; ++i) {
+		EXPECT_EQ(heap.top(), v[size - 1 - i]);
+		heap.pop();
+	}
+	EXPECT_TRUE(heap.empty());
+
+	heap.push_range(v.begin(), v.begin()); // Empty range
+	EXPECT_TRUE(heap.empty());
+}
@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include "HeapTest.hpp"
+
+#include "heaps/PairingHeap.hpp"
+#include "allocators/BlockAllocator.hpp"
+
+TEST(PairingHeapTest, Construct) {
+	construct_test<PairingHeap<int>>();
+}
+
+TEST(PairingHeapTest, ConstructCopy) {
+	construct_copy_test<PairingHeap<int>>();
+}
+
+TEST(PairingHeapTest, ConstructMove) {
+	construct_move_test<PairingHeap<int>>();
+}
+
+TEST(PairingHeapTest, Push1) {
+	push1_test<PairingHeap<int>>();
+}
+
+TEST(PairingHeapTest, Push2) {
+	push2_test<PairingHeap<int>>();
+}
+
+TEST(PairingHeapTest, Emplace1) {
+	emplace1_reverse_test<PairingHeap<int, std::less<int>>>();
+}
+
+TEST(PairingHeapTest, BigPush1) {
+	big_push1_test<PairingHeap<int>>();
+}
+
+TEST(PairingHeapTest, BigPush2) {
+	big_push2_test<PairingHeap<int>>();
+}
+
+TEST(PairingHeapTest, NestedHeap) {
+	PairingHeap<int> h0;
+	PairingHeap<int> h1;
+	h1.push(1);
+	PairingHeap<int> h2;
+	h2.push(2);
+	h2.push(3);
+
+	PairingHeap<PairingHeap<int>, std::function<bool(const PairingHeap<int>&, const PairingHeap<int>&)>> heap(
+		[](const PairingHeap<int>& left, const PairingHeap<int>& right) {
+		return left.size() < right.size();
+		}
+	);
+
+	heap.push(h0);
+	heap.push(h1);
+	heap.push(h2);
+
+	EXPECT_EQ(heap.pop().size(), 0);
+	EXPECT_EQ(heap.pop().size(), 1);
+	EXPECT_EQ(heap.pop().size(), 2);
+}
+
+TEST(PairingHeapTest, RaisesExceptionWhenEmpty) {
+	raises_exception_when_empty_test<PairingHeap<int>>();
+}
+
+TEST(PairingHeapTest, MergeTest) {
+	merge_test<PairingHeap<int>>();
+}
+
+TEST(PairingHeapTest, BigMerge) {
+	big_merge_test<PairingHeap<int>>();
+}
+
+TEST(PairingHeapTest, DecreaseKey) {
+	decrease_key_test<PairingHeap<int>>();
+}
+
+TEST(PairingHeapTest, BigDecreaseKey) {
+	big_decrease_key_test<PairingHeap<int>>();
+}
+
+TEST(PairingHeapTest, BigCopy) {
+	big_copy_test<PairingHeap<int>>();
+}
+
+TEST(PairingHeapTest, BigDestroy) {
+	big_destroy_test<PairingHeap<int>>();
+}
+
+TEST(PairingHeapTest, BlockAllocatorBigPush) {
+	big_push1_test<PairingHeap<int, std::greater<int>, BlockAllocator<int>>>();
+}
+
+TEST(PairingHeapTest, BlockAllocatorMerge) {
+	merge_test<PairingHeap<int, std::greater<int>, BlockAllocator<int>>>();
+}
+
+TEST(PairingHeapTest, BlockAllocatorBigCopy) {
+	big_copy_test<PairingHeap<int, std::greater<int>, BlockAllocator<int>>>();
+}
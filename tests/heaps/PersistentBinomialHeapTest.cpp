@@ -0,0 +1,125 @@
+#include "gtest/gtest.h"
+#include "HeapTest.hpp"
+
+#include "heaps/PersistentBinomialHeap.hpp"
+
+#include <string>
+#include <vector>
+
+TEST(PersistentBinomialHeapTest, Emplace1) {
+	emplace1_reverse_test<PersistentBinomialHeap<int, std::less<int>>>();
+}
+
+TEST(PersistentBinomialHeapTest, Construct) {
+	construct_test<PersistentBinomialHeap<int>>();
+}
+
+TEST(PersistentBinomialHeapTest, ConstructCopy) {
+	construct_copy_test<PersistentBinomialHeap<int>>();
+}
+
+TEST(PersistentBinomialHeapTest, ConstructMove) {
+	construct_move_test<PersistentBinomialHeap<int>>();
+}
+
+TEST(PersistentBinomialHeapTest, Push1) {
+	push1_test<PersistentBinomialHeap<int>>();
+}
+
+TEST(PersistentBinomialHeapTest, Push2) {
+	push2_test<PersistentBinomialHeap<int>>();
+}
+
+TEST(PersistentBinomialHeapTest, BigPush1) {
+	big_push1_test<PersistentBinomialHeap<int>>();
+}
+
+TEST(PersistentBinomialHeapTest, BigPush2) {
+	big_push2_test<PersistentBinomialHeap<int>>();
+}
+
+TEST(PersistentBinomialHeapTest, RaisesExceptionWhenEmpty) {
+	raises_exception_when_empty_test<PersistentBinomialHeap<int>>();
+}
+
+TEST(PersistentBinomialHeapTest, MergeTest) {
+	merge_test<PersistentBinomialHeap<int>>();
+}
+
+TEST(PersistentBinomialHeapTest, BigMerge) {
+	big_merge_test<PersistentBinomialHeap<int>>();
+}
+
+TEST(PersistentBinomialHeapTest, BigCopy) {
+	big_copy_test<PersistentBinomialHeap<int>>();
+}
+
+TEST(PersistentBinomialHeapTest, BigDestroy) {
+	big_destroy_test<PersistentBinomialHeap<int>>();
+}
+
+TEST(PersistentBinomialHeapTest, VersionsAreIndependent) {
+	std::default_random_engine random(1227992885);
+	std::vector<PersistentBinomialHeap<int>> versions(1);
+	std::vector<std::vector<int>> expected(1);
+
+	// Every version forks the previous one and pushes or pops one element
+	for (std::size_t i = 1; i < 2000; ++i) {
+		std::size_t from = random() % versions.size();
+		versions.push_back(versions[from]);
+		expected.push_back(expected[from]);
+
+		if (!expected.back().empty() && random() % 3 == 0) {
+			EXPECT_EQ(versions.back().pop(), expected.back().back());
+			expected.back().pop_back();
+		}
+		else {
+			int elem = random() % 1000;
+			versions.back().push(elem);
+			expected.back().insert(std::lower_bound(expected.back().begin(), expected.back().end(), elem), elem);
+		}
+	}
+
+	for (std::size_t i = 0; i < versions.size(); ++i) {
+		EXPECT_EQ(versions[i].size(), expected[i].size());
+		while (!expected[i].empty()) {
+			EXPECT_EQ(versions[i].pop(), expected[i].back());
+			expected[i].pop_back();
+		}
+		EXPECT_TRUE(versions[i].empty());
+	}
+}
+
+TEST(PersistentBinomialHeapTest, MergeKeepsCopies) {
+	PersistentBinomialHeap<int> heap1, heap2;
+	for (int i = 0; i < 100; ++i) {
+		heap1.push(2 * i);
+		heap2.push(2 * i + 1);
+	}
+
+	PersistentBinomialHeap<int> copy1(heap1), copy2(heap2);
+	heap1.merge(heap2);
+	EXPECT_EQ(heap1.size(), 200);
+	EXPECT_TRUE(heap2.empty());
+
+	for (int i = 199; i >= 0; --i) {
+		EXPECT_EQ(heap1.pop(), i);
+	}
+	for (int i = 99; i >= 0; --i) {
+		EXPECT_EQ(copy1.pop(), 2 * i);
+		EXPECT_EQ(copy2.pop(), 2 * i + 1);
+	}
+}
+
+TEST(PersistentBinomialHeapTest, NonTrivialKey) {
+	PersistentBinomialHeap<std::string> heap;
+	heap.emplace(3, 'b');
+	heap.push(std::string("c"));
+	heap.push(std::string("a"));
+
+	PersistentBinomialHeap<std::string> fork(heap);
+	EXPECT_EQ(heap.pop(), "c");
+	EXPECT_EQ(heap.pop(), "bbb");
+	EXPECT_EQ(fork.top(), "c");
+	EXPECT_EQ(fork.size(), 3);
+}
@@ -1,6 +1,12 @@
 #include "TreeTest.hpp"
 
 #include "trees/AVLTree.hpp"
+#include "allocators/BlockAllocator.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <string>
 
 TEST(AVLTreeTest, Construct) {
 	construct_test<AVLTree<int>>();
@@ -17,3 +23,222 @@ TEST(AVLTreeTest, Insert2) {
 TEST(AVLTreeTest, BigInsert1) {
     big_insert1_test<AVLTree<int>>();
 }
+
+TEST(AVLTreeTest, Copy) {
+    copy_test<AVLTree<int>>();
+}
+
+TEST(AVLTreeTest, BigRandomErase) {
+    big_random_erase_test<AVLTree<int>>();
+}
+
+TEST(AVLTreeTest, BlockAllocatorInsert1) {
+    insert1_test<AVLTree<int, std::less<int>, BlockAllocator<int>>>();
+}
+
+TEST(AVLTreeTest, BlockAllocatorBigInsert1) {
+    big_insert1_test<AVLTree<int, std::less<int>, BlockAllocator<int>>>();
+}
+
+TEST(AVLTreeTest, OrderStatistics) {
+    AVLTree<int> tree;
+    std::default_random_engine random(1227992885);
+    std::set<int> set;
+
+    for (std::size_t i = 0; i < 20000; ++i) {
+        int elem = random() % 10000;
+        if (random() % 3 == 0) {
+            tree.erase(elem);
+            set.erase(elem);
+        }
+        else {
+            tree.insert(elem);
+            set.insert(elem);
+        }
+    }
+
+    std::vector<int> sorted(set.begin(), set.end());
+    EXPECT_EQ(tree.size(), sorted.size());
+    for (std::size_t k = 0; k < sorted.size(); ++k) {
+        EXPECT_EQ(tree.select(k), sorted[k]);
+        EXPECT_EQ(tree.rank(sorted[k]), k);
+    }
+    EXPECT_THROW(tree.select(sorted.size()), std::out_of_range);
+
+    for (int i = 0; i < 1000; ++i) {
+        int lo = random() % 11000 - 500;
+        int hi = random() % 11000 - 500;
+        std::size_t expected = lo < hi ? std::distance(set.lower_bound(lo), set.lower_bound(hi)) : 0;
+        EXPECT_EQ(tree.count_range(lo, hi), expected);
+        EXPECT_EQ(tree.rank(lo), (std::size_t)std::distance(set.begin(), set.lower_bound(lo)));
+    }
+}
+
+TEST(AVLTreeTest, Iterators) {
+    iterator_test<AVLTree<int>>();
+}
+
+/**
+ * @brief Key that counts its copies and moves
+ */
+struct CountedKey {
+    static int copies;
+    static int moves;
+
+    int value;
+
+    CountedKey(int value) : value(value) {}
+    CountedKey(CountedKey const& other) : value(other.value) { ++copies; }
+    CountedKey(CountedKey&& other) : value(other.value) { ++moves; }
+    CountedKey& operator=(CountedKey const& other) { value = other.value; ++copies; return *this; }
+    CountedKey& operator=(CountedKey&& other) { value = other.value; ++moves; return *this; }
+
+    bool operator<(CountedKey const& other) const { return value < other.value; }
+    bool operator>(CountedKey const& other) const { return value > other.value; }
+    bool operator==(CountedKey const& other) const { return value == other.value; }
+};
+
+int CountedKey::copies = 0;
+int CountedKey::moves = 0;
+
+TEST(AVLTreeTest, SortedBuild) {
+    sorted_build_test<AVLTree<int>>();
+}
+
+TEST(AVLTreeTest, BatchLookup) {
+    batch_lookup_test<AVLTree<int>>();
+}
+
+TEST(AVLTreeTest, Comparator) {
+    comparator_test<AVLTree<int, std::greater<int>>>();
+}
+
+TEST(AVLTreeTest, TransparentLookup) {
+    transparent_lookup_test<AVLTree<std::string, StringLess>>();
+}
+
+TEST(AVLTreeTest, RebalancingDoesNotCopyKeys) {
+    AVLTree<CountedKey> tree;
+    std::default_random_engine random(1227992885);
+    CountedKey::copies = 0;
+    CountedKey::moves = 0;
+
+    for (int i = 0; i < 10000; ++i) {
+        tree.emplace((int)(random() % 5000));
+    }
+    for (int i = 0; i < 10000; ++i) {
+        tree.erase(CountedKey(random() % 5000));
+    }
+    EXPECT_EQ(CountedKey::copies, 0);
+    EXPECT_EQ(CountedKey::moves, 0);
+
+    tree.insert(CountedKey(-1));
+    EXPECT_EQ(CountedKey::copies, 0);
+    EXPECT_EQ(CountedKey::moves, 1);
+}
+
+TEST(AVLTreeTest, StringKeys) {
+    AVLTree<std::string> tree;
+    std::string b(100, 'b');
+    tree.insert(b);
+    tree.insert(std::string(100, 'a'));
+    tree.emplace(100, 'c');
+    tree.emplace(100, 'c');
+
+    EXPECT_EQ(b, std::string(100, 'b'));
+    EXPECT_EQ(tree.size(), 3);
+    EXPECT_EQ(tree.select(0), std::string(100, 'a'));
+    EXPECT_EQ(tree.select(2), std::string(100, 'c'));
+
+    tree.erase(b);
+    EXPECT_FALSE(tree.contains(b));
+    EXPECT_EQ(tree.size(), 2);
+}
+
+static void set_operations_test(std::size_t threads) {
+    std::default_random_engine random(1227992885);
+
+    for (int round = 0; round < 60; ++round) {
+        int n = random() % 20000;
+        int m = round % 3 == 0 ? random() % 50 : random() % 20000;
+        int range = 1 + random() % (n + m + 1);
+
+        std::set<int> a, b;
+        AVLTree<int> tree_a, tree_b;
+        for (int i = 0; i < n; ++i) {
+            int key = random() % range;
+            a.insert(key);
+            tree_a.insert(key);
+        }
+        for (int i = 0; i < m; ++i) {
+            int key = random() % range;
+            b.insert(key);
+            tree_b.insert(key);
+        }
+
+        std::vector<int> expected;
+        AVLTree<int> tree(tree_a);
+        switch (round % 3) {
+        case 0:
+            std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+            if (threads == 0) tree.union_with(tree_b);
+            else tree.union_with_parallel(tree_b, threads);
+            break;
+        case 1:
+            std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+            if (threads == 0) tree.intersect_with(tree_b);
+            else tree.intersect_with_parallel(tree_b, threads);
+            break;
+        case 2:
+            std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+            if (threads == 0) tree.difference_with(tree_b);
+            else tree.difference_with_parallel(tree_b, threads);
+            break;
+        }
+
+        EXPECT_EQ(std::vector<int>(tree.begin(), tree.end()), expected);
+        EXPECT_EQ(tree.size(), expected.size());
+        EXPECT_EQ(std::vector<int>(tree_b.begin(), tree_b.end()), std::vector<int>(b.begin(), b.end()));
+
+        // The result must stay balanced
+        for (int key : expected) tree.erase(key);
+        EXPECT_TRUE(tree.empty());
+    }
+}
+
+TEST(AVLTreeTest, SetOperations) {
+    set_operations_test(0);
+}
+
+TEST(AVLTreeTest, ParallelSetOperations) {
+    set_operations_test(4);
+}
+
+TEST(AVLTreeTest, SplitJoin) {
+    std::vector<int> keys;
+    for (int i = 0; i < 1000; ++i) keys.push_back(2 * i);
+
+    for (int key = -1; key < 2002; key += 7) {
+        AVLTree<int> left(keys.begin(), keys.end());
+        AVLTree<int> right = left.split(key);
+
+        std::vector<int>::iterator middle = std::lower_bound(keys.begin(), keys.end(), key);
+        EXPECT_EQ(std::vector<int>(left.begin(), left.end()), std::vector<int>(keys.begin(), middle));
+        EXPECT_EQ(std::vector<int>(right.begin(), right.end()), std::vector<int>(middle, keys.end()));
+        EXPECT_EQ(left.size() + right.size(), keys.size());
+
+        AVLTree<int> copy(right);
+        left.join(copy);
+        EXPECT_TRUE(copy.empty());
+        EXPECT_EQ(std::vector<int>(left.begin(), left.end()), keys);
+
+        // Odd keys are not on the tree
+        if (key % 2 != 0 && key > 0 && key < 1999) {
+            AVLTree<int> low(keys.begin(), middle);
+            AVLTree<int> high(middle, keys.end());
+            low.join(key, high);
+            EXPECT_EQ(low.size(), keys.size() + 1);
+            EXPECT_EQ(low.rank(key), (std::size_t)(middle - keys.begin()));
+        }
+    }
+}
@@ -0,0 +1,149 @@
+#include "TreeTest.hpp"
+
+#include "trees/AugmentedAVLTree.hpp"
+#include "allocators/BlockAllocator.hpp"
+
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Sum of the keys of a subtree
+ */
+struct SumAugmentation {
+    using value_type = long long;
+
+    value_type identity() const { return 0; }
+    value_type measure(int key) const { return key; }
+    value_type combine(value_type a, value_type b) const { return a + b; }
+};
+
+/**
+ * @brief Concatenation of the keys, it is not commutative, so the order of the
+ * combinations is checked too
+ */
+struct ConcatAugmentation {
+    using value_type = std::string;
+
+    value_type identity() const { return std::string(); }
+    value_type measure(int key) const { return std::to_string(key) + ","; }
+    value_type combine(value_type const& a, value_type const& b) const { return a + b; }
+};
+
+template<class Key, class Comparator = std::less<Key>, class Allocator = std::allocator<Key>>
+using SumTree = AugmentedAVLTree<Key, SumAugmentation, Comparator, Allocator>;
+
+TEST(AugmentedAVLTreeTest, Construct) {
+    construct_test<SumTree<int>>();
+}
+
+TEST(AugmentedAVLTreeTest, Insert1) {
+    insert1_test<SumTree<int>>();
+}
+
+TEST(AugmentedAVLTreeTest, Insert2) {
+    insert2_test<SumTree<int>>();
+}
+
+TEST(AugmentedAVLTreeTest, BigInsert1) {
+    big_insert1_test<SumTree<int>>();
+}
+
+TEST(AugmentedAVLTreeTest, Copy) {
+    copy_test<SumTree<int>>();
+}
+
+TEST(AugmentedAVLTreeTest, BigRandomErase) {
+    big_random_erase_test<SumTree<int>>();
+}
+
+TEST(AugmentedAVLTreeTest, Iterators) {
+    iterator_test<SumTree<int>>();
+}
+
+TEST(AugmentedAVLTreeTest, SortedBuild) {
+    sorted_build_test<SumTree<int>>();
+}
+
+TEST(AugmentedAVLTreeTest, Comparator) {
+    comparator_test<SumTree<int, std::greater<int>>>();
+}
+
+TEST(AugmentedAVLTreeTest, BlockAllocator) {
+    insert1_test<SumTree<int, std::less<int>, BlockAllocator<int>>>();
+}
+
+TEST(AugmentedAVLTreeTest, RangeSummaries) {
+    std::default_random_engine random(1227992885);
+    SumTree<int> tree;
+    std::set<int> set;
+
+    for (int i = 0; i < 3000; ++i) {
+        int elem = random() % 1000;
+        if (random() % 3 == 0) {
+            tree.erase(elem);
+            set.erase(elem);
+        }
+        else {
+            tree.insert(elem);
+            set.insert(elem);
+        }
+
+        if (i % 100 == 0) {
+            long long total = 0;
+            for (int key : set) total += key;
+            ASSERT_EQ(tree.summary(), total);
+        }
+    }
+
+    for (int i = 0; i < 500; ++i) {
+        int lo = (int)(random() % 1100) - 50;
+        int hi = lo + (int)(random() % 600);
+        long long expected = 0;
+        for (auto it = set.lower_bound(lo); it != set.lower_bound(hi); ++it) expected += *it;
+        EXPECT_EQ(tree.summary(lo, hi), expected);
+    }
+    EXPECT_EQ(tree.summary(10, 10), 0);
+    EXPECT_EQ(tree.summary(10, 5), 0);
+}
+
+TEST(AugmentedAVLTreeTest, OrderedCombinations) {
+    std::default_random_engine random(1227992885);
+    AugmentedAVLTree<int, ConcatAugmentation> tree;
+    std::set<int> set;
+
+    auto concat = [&set](int lo, int hi) {
+        std::string expected;
+        for (auto it = set.lower_bound(lo); it != set.lower_bound(hi); ++it) {
+            expected += std::to_string(*it) + ",";
+        }
+        return expected;
+    };
+
+    // Rotations on both directions
+    for (int i = 0; i < 2000; ++i) {
+        int elem = random() % 500;
+        if (random() % 4 == 0) {
+            tree.erase(elem);
+            set.erase(elem);
+        }
+        else {
+            tree.insert(elem);
+            set.insert(elem);
+        }
+    }
+    EXPECT_EQ(tree.summary(), concat(0, 500));
+
+    for (int i = 0; i < 200; ++i) {
+        int lo = random() % 500;
+        int hi = lo + random() % 200;
+        EXPECT_EQ(tree.summary(lo, hi), concat(lo, hi));
+    }
+
+    // The copy keeps the summaries, and the sorted build computes them
+    AugmentedAVLTree<int, ConcatAugmentation> copy(tree);
+    EXPECT_EQ(copy.summary(100, 400), concat(100, 400));
+    AugmentedAVLTree<int, ConcatAugmentation> built(set.begin(), set.end());
+    EXPECT_EQ(built.summary(), concat(0, 500));
+}
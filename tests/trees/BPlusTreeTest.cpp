@@ -0,0 +1,100 @@
+#include "TreeTest.hpp"
+
+#include "trees/BPlusTree.hpp"
+#include "allocators/BlockAllocator.hpp"
+
+#include <string>
+
+// Nodes of 4 keys, so small tests split and merge many levels
+template<class Key, class Comparator = std::less<Key>, class Allocator = std::allocator<Key>>
+using SmallBPlusTree = BPlusTree<Key, Comparator, Allocator, 8>;
+
+TEST(BPlusTreeTest, Construct) {
+    construct_test<BPlusTree<int>>();
+}
+
+TEST(BPlusTreeTest, Insert1) {
+    insert1_test<BPlusTree<int>>();
+    insert1_test<SmallBPlusTree<int>>();
+}
+
+TEST(BPlusTreeTest, Insert2) {
+    insert2_test<BPlusTree<int>>();
+    insert2_test<SmallBPlusTree<int>>();
+}
+
+TEST(BPlusTreeTest, BigInsert1) {
+    big_insert1_test<BPlusTree<int>>();
+    big_insert1_test<SmallBPlusTree<int>>();
+}
+
+TEST(BPlusTreeTest, Copy) {
+    copy_test<BPlusTree<int>>();
+    copy_test<SmallBPlusTree<int>>();
+}
+
+TEST(BPlusTreeTest, BigRandomErase) {
+    big_random_erase_test<BPlusTree<int>>();
+    big_random_erase_test<SmallBPlusTree<int>>();
+}
+
+TEST(BPlusTreeTest, BlockAllocatorInsert1) {
+    insert1_test<BPlusTree<int, std::less<int>, BlockAllocator<int>>>();
+}
+
+TEST(BPlusTreeTest, BlockAllocatorBigInsert1) {
+    big_insert1_test<SmallBPlusTree<int, std::less<int>, BlockAllocator<int>>>();
+}
+
+TEST(BPlusTreeTest, Iterators) {
+    iterator_test<BPlusTree<int>>();
+    iterator_test<SmallBPlusTree<int>>();
+}
+
+TEST(BPlusTreeTest, SortedBuild) {
+    sorted_build_test<BPlusTree<int>>();
+    sorted_build_test<SmallBPlusTree<int>>();
+}
+
+TEST(BPlusTreeTest, Comparator) {
+    comparator_test<BPlusTree<int, std::greater<int>>>();
+    comparator_test<SmallBPlusTree<int, std::greater<int>>>();
+}
+
+TEST(BPlusTreeTest, TransparentLookup) {
+    transparent_lookup_test<BPlusTree<std::string, StringLess>>();
+}
+
+TEST(BPlusTreeTest, EraseAll) {
+    SmallBPlusTree<int> tree;
+    for (int i = 0; i < 5000; ++i) tree.insert(i);
+    EXPECT_EQ(tree.size(), 5000u);
+
+    for (int i = 0; i < 5000; i += 2) tree.erase(i);
+    for (int i = 4999; i >= 0; i -= 2) tree.erase(i);
+    EXPECT_TRUE(tree.empty());
+    EXPECT_TRUE(tree.begin() == tree.end());
+
+    tree.insert(7);
+    EXPECT_EQ(*tree.begin(), 7);
+}
+
+TEST(BPlusTreeTest, StringKeys) {
+    SmallBPlusTree<std::string> tree;
+    std::set<std::string> set;
+    std::default_random_engine random(1227992885);
+
+    for (int i = 0; i < 20000; ++i) {
+        std::string key = std::string(40, 'k') + std::to_string(random() % 3000);
+        if (random() % 3 == 0) {
+            tree.erase(key);
+            set.erase(key);
+        }
+        else {
+            tree.insert(key);
+            set.insert(key);
+        }
+    }
+
+    EXPECT_EQ(std::vector<std::string>(tree.begin(), tree.end()), std::vector<std::string>(set.begin(), set.end()));
+}
@@ -0,0 +1,103 @@
+#include "TreeTest.hpp"
+
+#include "trees/CompactAVLTree.hpp"
+#include "allocators/BlockAllocator.hpp"
+
+#include <set>
+#include <string>
+#include <vector>
+
+template<class Key>
+using CountedCompactAVLTree = CompactAVLTree<Key, std::less<Key>, std::allocator<Key>, true>;
+
+TEST(CompactAVLTreeTest, Construct) {
+    construct_test<CompactAVLTree<int>>();
+}
+
+TEST(CompactAVLTreeTest, Insert1) {
+    insert1_test<CompactAVLTree<int>>();
+}
+
+TEST(CompactAVLTreeTest, Insert2) {
+    insert2_test<CompactAVLTree<int>>();
+}
+
+TEST(CompactAVLTreeTest, BigInsert1) {
+    big_insert1_test<CompactAVLTree<int>>();
+}
+
+TEST(CompactAVLTreeTest, Copy) {
+    copy_test<CompactAVLTree<int>>();
+}
+
+TEST(CompactAVLTreeTest, BigRandomErase) {
+    big_random_erase_test<CompactAVLTree<int>>();
+    big_random_erase_test<CountedCompactAVLTree<int>>();
+}
+
+TEST(CompactAVLTreeTest, Iterators) {
+    iterator_test<CompactAVLTree<int>>();
+}
+
+TEST(CompactAVLTreeTest, SortedBuild) {
+    sorted_build_test<CompactAVLTree<int>>();
+}
+
+TEST(CompactAVLTreeTest, Comparator) {
+    comparator_test<CompactAVLTree<int, std::greater<int>>>();
+}
+
+TEST(CompactAVLTreeTest, TransparentLookup) {
+    transparent_lookup_test<CompactAVLTree<std::string, StringLess>>();
+}
+
+TEST(CompactAVLTreeTest, BlockAllocator) {
+    insert1_test<CompactAVLTree<int, std::less<int>, BlockAllocator<int>>>();
+}
+
+TEST(CompactAVLTreeTest, OrderStatistics) {
+    std::default_random_engine random(1227992885);
+    CountedCompactAVLTree<int> tree;
+    std::set<int> set;
+    for (int i = 0; i < 20000; ++i) {
+        int elem = random() % 5000;
+        if (random() % 3 == 0) {
+            tree.erase(elem);
+            set.erase(elem);
+        }
+        else {
+            tree.insert(elem);
+            set.insert(elem);
+        }
+    }
+
+    ASSERT_EQ(tree.size(), set.size());
+    std::vector<int> keys(set.begin(), set.end());
+    for (std::size_t k = 0; k < keys.size(); ++k) {
+        EXPECT_EQ(tree.select(k), keys[k]);
+        EXPECT_EQ(tree.rank(keys[k]), k);
+    }
+    EXPECT_EQ(tree.count_range(1000, 2000),
+        (std::size_t)std::distance(set.lower_bound(1000), set.lower_bound(2000)));
+    EXPECT_THROW(tree.select(keys.size()), std::out_of_range);
+}
+
+TEST(CompactAVLTreeTest, SlotsAreReused) {
+    CompactAVLTree<std::string> tree;
+    tree.reserve(100);
+    ASSERT_EQ(tree.capacity(), 100u);
+
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 100; ++i) tree.insert(std::string(32, 'k') + std::to_string(i));
+        EXPECT_EQ(tree.size(), 100u);
+        for (int i = 0; i < 100; i += 2) tree.erase(std::string(32, 'k') + std::to_string(i));
+        EXPECT_EQ(tree.size(), 50u);
+    }
+
+    // Erased slots are taken again, the pool never grows
+    EXPECT_EQ(tree.capacity(), 100u);
+
+    CompactAVLTree<std::string> copy(tree);
+    tree.insert("a");
+    EXPECT_EQ(std::vector<std::string>(++tree.begin(), tree.end()), std::vector<std::string>(copy.begin(), copy.end()));
+}
@@ -0,0 +1,180 @@
+#include "gtest/gtest.h"
+
+#include "trees/ConcurrentAVLTree.hpp"
+
+#include <atomic>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Tree = ConcurrentAVLTree<int>;
+
+template<class Key, class Comparator>
+void check_snapshot(typename ConcurrentAVLTree<Key, Comparator>::Snapshot const& snapshot,
+    std::set<Key, Comparator> const& set)
+{
+    EXPECT_EQ(snapshot.size(), set.size());
+    EXPECT_EQ(snapshot.empty(), set.empty());
+    EXPECT_EQ(std::vector<Key>(snapshot.begin(), snapshot.end()), std::vector<Key>(set.begin(), set.end()));
+
+    std::vector<Key> backward;
+    for (auto it = snapshot.end(); it != snapshot.begin();) {
+        --it;
+        backward.push_back(*it);
+    }
+    EXPECT_EQ(backward, std::vector<Key>(set.rbegin(), set.rend()));
+}
+
+TEST(ConcurrentAVLTreeTest, InsertErase) {
+    std::default_random_engine random(1227992885);
+
+    Tree tree;
+    Tree::Reader reader(tree);
+    std::set<int> set;
+
+    for (int i = 0; i < 5000; ++i) {
+        int key = (int)(random() % 1000);
+        if (random() % 3 == 0) {
+            tree.erase(key);
+            set.erase(key);
+        }
+        else {
+            tree.insert(key);
+            set.insert(key);
+        }
+        ASSERT_EQ(tree.size(), set.size());
+    }
+
+    Tree::Snapshot snapshot(reader);
+    check_snapshot(snapshot, set);
+    for (int key = -1; key <= 1000; ++key) {
+        EXPECT_EQ(snapshot.contains(key), set.count(key) == 1);
+    }
+
+    std::vector<int> range;
+    snapshot.for_each_in_range(250, 750, [&](int key) { range.push_back(key); });
+    EXPECT_EQ(range, std::vector<int>(set.lower_bound(250), set.lower_bound(750)));
+}
+
+TEST(ConcurrentAVLTreeTest, Comparator) {
+    using GreaterTree = ConcurrentAVLTree<int, std::greater<int>>;
+    std::default_random_engine random(1227992885);
+
+    GreaterTree tree;
+    GreaterTree::Reader reader(tree);
+    std::set<int, std::greater<int>> set;
+    for (int i = 0; i < 2000; ++i) {
+        int key = (int)(random() % 1000);
+        if (random() % 3 == 0) {
+            tree.erase(key);
+            set.erase(key);
+        }
+        else {
+            tree.insert(key);
+            set.insert(key);
+        }
+    }
+
+    // Keys on decreasing order
+    GreaterTree::Snapshot snapshot(reader);
+    check_snapshot(snapshot, set);
+    for (int key = -1; key <= 1000; ++key) {
+        EXPECT_EQ(snapshot.contains(key), set.count(key) == 1);
+    }
+
+    std::vector<int> range;
+    snapshot.for_each_in_range(750, 250, [&](int key) { range.push_back(key); });
+    EXPECT_EQ(range, std::vector<int>(set.lower_bound(750), set.lower_bound(250)));
+}
+
+TEST(ConcurrentAVLTreeTest, SnapshotIsolation) {
+    Tree tree;
+    Tree::Reader reader(tree);
+    std::set<int> set;
+    for (int i = 0; i < 100; ++i) {
+        tree.insert(i);
+        set.insert(i);
+    }
+
+    {
+        Tree::Snapshot before(reader);
+
+        for (int i = 0; i < 100; i += 2) tree.erase(i);
+        for (int i = 100; i < 200; ++i) tree.insert(i);
+
+        // Nested snapshots keep the oldest pin
+        Tree::Snapshot after(reader);
+        EXPECT_EQ(after.size(), 150u);
+        EXPECT_FALSE(after.contains(0));
+        EXPECT_TRUE(after.contains(150));
+
+        check_snapshot(before, set);
+        EXPECT_GT(tree.pending(), 0u);
+    }
+
+    // Without snapshots the next write frees every old version
+    tree.insert(1000);
+    EXPECT_EQ(tree.pending(), 0u);
+}
+
+TEST(ConcurrentAVLTreeTest, ConcurrentReaders) {
+    const int READERS = 4;
+    const int KEYS = 2000;
+
+    Tree tree;
+    std::atomic<bool> done(false);
+    std::atomic<int> errors(0);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; ++r) {
+        readers.emplace_back([&]() {
+            Tree::Reader reader(tree);
+            do {
+                Tree::Snapshot snapshot(reader);
+
+                // Every snapshot is a valid, sorted set of even keys
+                std::size_t count = 0;
+                int last = -1;
+                for (int key : snapshot) {
+                    if (key <= last || key % 2 != 0) ++errors;
+                    last = key;
+                    ++count;
+                }
+                if (count != snapshot.size()) ++errors;
+            } while (!done.load());
+        });
+    }
+
+    std::default_random_engine random(1227992885);
+    for (int i = 0; i < 20000; ++i) {
+        int key = 2 * (int)(random() % KEYS);
+        if (random() % 2 == 0) tree.insert(key);
+        else tree.erase(key);
+    }
+    done.store(true);
+
+    for (std::thread& reader : readers) reader.join();
+    EXPECT_EQ(errors.load(), 0);
+}
+
+TEST(ConcurrentAVLTreeTest, StringKeys) {
+    ConcurrentAVLTree<std::string> tree;
+    ConcurrentAVLTree<std::string>::Reader reader(tree);
+    std::set<std::string> set;
+
+    for (int i = 0; i < 500; ++i) {
+        std::string key = std::string(32, 'k') + std::to_string(i * 7 % 500);
+        tree.insert(key);
+        set.insert(key);
+        if (i % 5 == 0) {
+            tree.erase(std::string(32, 'k') + std::to_string(i));
+            set.erase(std::string(32, 'k') + std::to_string(i));
+        }
+    }
+
+    ConcurrentAVLTree<std::string>::Snapshot snapshot(reader);
+    check_snapshot(snapshot, set);
+}
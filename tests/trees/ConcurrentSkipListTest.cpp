@@ -0,0 +1,226 @@
+#include "gtest/gtest.h"
+
+#include "trees/ConcurrentSkipList.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using List = ConcurrentSkipList<int>;
+
+template<class Key, class C>
+void check_guard(typename ConcurrentSkipList<Key, C>::Guard const& guard, std::set<Key, C> const& set) {
+    EXPECT_EQ(std::vector<Key>(guard.begin(), guard.end()), std::vector<Key>(set.begin(), set.end()));
+}
+
+TEST(ConcurrentSkipListTest, InsertErase) {
+    std::default_random_engine random(1227992885);
+
+    List list;
+    List::Handle handle(list);
+    std::set<int> set;
+    EXPECT_TRUE(list.empty());
+
+    for (int i = 0; i < 20000; ++i) {
+        int key = random() % 1000;
+        if (random() % 3 == 0) {
+            EXPECT_EQ(handle.erase(key), set.erase(key) == 1);
+        }
+        else {
+            EXPECT_EQ(handle.insert(key), set.insert(key).second);
+        }
+        ASSERT_EQ(list.size(), set.size());
+    }
+
+    List::Guard guard(handle);
+    check_guard(guard, set);
+    for (int key = -1; key <= 1000; ++key) {
+        EXPECT_EQ(handle.contains(key), set.count(key) == 1);
+        EXPECT_EQ(handle.count(key), set.count(key));
+
+        auto found = guard.find(key);
+        EXPECT_EQ(found == guard.end(), set.count(key) == 0);
+
+        auto lower = guard.lower_bound(key);
+        EXPECT_EQ(lower == guard.end(), set.lower_bound(key) == set.end());
+        if (lower != guard.end()) {
+            EXPECT_EQ(*lower, *set.lower_bound(key));
+        }
+
+        auto upper = guard.upper_bound(key);
+        EXPECT_EQ(upper == guard.end(), set.upper_bound(key) == set.end());
+        if (upper != guard.end()) {
+            EXPECT_EQ(*upper, *set.upper_bound(key));
+        }
+    }
+
+    std::vector<int> range;
+    handle.for_each_in_range(250, 750, [&](int key) { range.push_back(key); });
+    EXPECT_EQ(range, std::vector<int>(set.lower_bound(250), set.lower_bound(750)));
+}
+
+TEST(ConcurrentSkipListTest, ComparatorAndEmplace) {
+    ConcurrentSkipList<std::string, std::greater<std::string>> list;
+    ConcurrentSkipList<std::string, std::greater<std::string>>::Handle handle(list);
+    std::set<std::string, std::greater<std::string>> set;
+
+    for (int i = 0; i < 500; ++i) {
+        std::string key = std::string(32, 'k') + std::to_string(i * 7 % 300);
+        EXPECT_EQ(handle.emplace(32, 'k'), i == 0);
+        EXPECT_EQ(handle.insert(key), set.insert(key).second);
+    }
+    set.insert(std::string(32, 'k'));
+    EXPECT_EQ(list.size(), set.size());
+
+    ConcurrentSkipList<std::string, std::greater<std::string>>::Guard guard(handle);
+    check_guard(guard, set);
+}
+
+TEST(ConcurrentSkipListTest, DisjointWriters) {
+    const int THREADS = 4;
+    const int KEYS = 5000;
+
+    List list;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&list, t]() {
+            List::Handle handle(list);
+            // Keys interleaved with the other threads, so they write the same places
+            for (int i = 0; i < KEYS; ++i) handle.insert(i * THREADS + t);
+            for (int i = 0; i < KEYS; i += 2) handle.erase(i * THREADS + t);
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    std::set<int> set;
+    for (int t = 0; t < THREADS; ++t) {
+        for (int i = 1; i < KEYS; i += 2) set.insert(i * THREADS + t);
+    }
+    EXPECT_EQ(list.size(), set.size());
+
+    List::Handle handle(list);
+    List::Guard guard(handle);
+    check_guard(guard, set);
+}
+
+TEST(ConcurrentSkipListTest, ContendedKeys) {
+    const int THREADS = 4;
+    const int KEYS = 64;
+
+    List list;
+    std::atomic<long long> balance(0); // Successful inserts minus successful erases
+    std::atomic<int> errors(0);
+    std::atomic<bool> done(false);
+
+    // A reader checks that every scan is sorted
+    std::thread reader([&]() {
+        List::Handle handle(list);
+        do {
+            List::Guard guard(handle);
+            int last = -1;
+            for (int key : guard) {
+                if (key <= last) ++errors;
+                last = key;
+            }
+        } while (!done.load());
+    });
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < THREADS; ++t) {
+        writers.emplace_back([&, t]() {
+            List::Handle handle(list);
+            std::default_random_engine random(1227992885 + t);
+            for (int i = 0; i < 50000; ++i) {
+                int key = random() % KEYS;
+                if (random() % 2 == 0) {
+                    if (handle.insert(key)) ++balance;
+                }
+                else if (handle.erase(key)) --balance;
+            }
+        });
+    }
+    for (std::thread& writer : writers) writer.join();
+    done.store(true);
+    reader.join();
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ((long long)list.size(), balance.load());
+
+    List::Handle handle(list);
+    List::Guard guard(handle);
+    std::vector<int> keys(guard.begin(), guard.end());
+    EXPECT_EQ((long long)keys.size(), balance.load());
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    for (int key = 0; key < KEYS; ++key) {
+        EXPECT_EQ(handle.contains(key), std::binary_search(keys.begin(), keys.end(), key));
+    }
+}
+
+TEST(ConcurrentSkipListTest, SameKeys) {
+    // Every thread inserts and erases the same few keys, so new nodes are linked next to
+    // erased nodes with the same key, on all their levels
+    const int THREADS = 4;
+    const int KEYS = 4;
+
+    List list;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&list, t]() {
+            List::Handle handle(list);
+            std::default_random_engine random(1227992885 + t);
+            for (int i = 0; i < 200000; ++i) {
+                int key = random() % KEYS;
+                if (random() % 2 == 0) handle.insert(key);
+                else handle.erase(key);
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    List::Handle handle(list);
+    {
+        List::Guard guard(handle);
+        std::vector<int> keys(guard.begin(), guard.end());
+        EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+        EXPECT_EQ(keys.size(), list.size());
+    }
+    for (int key = 0; key < KEYS; ++key) handle.erase(key);
+    EXPECT_TRUE(list.empty());
+    for (int key = 0; key < KEYS; ++key) {
+        EXPECT_FALSE(handle.contains(key));
+        EXPECT_TRUE(handle.insert(key));
+    }
+    EXPECT_EQ(list.size(), (std::size_t)KEYS);
+}
+
+TEST(ConcurrentSkipListTest, Reclamation) {
+    List list;
+    List::Handle handle(list);
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 1000; ++i) handle.insert(i);
+        for (int i = 0; i < 1000; ++i) handle.erase(i);
+    }
+    // Without pinned threads, every batch is freed when it is full
+    EXPECT_LT(handle.pending(), 64u);
+    EXPECT_TRUE(list.empty());
+
+    {
+        // A guard of another thread keeps the nodes erased meanwhile
+        List::Handle other(list);
+        List::Guard guard(other);
+        for (int i = 0; i < 1000; ++i) handle.insert(i);
+        for (int i = 0; i < 1000; ++i) handle.erase(i);
+        EXPECT_GE(handle.pending(), 1000u);
+    }
+    handle.insert(0);
+    for (int i = 0; i < 64; ++i) {
+        handle.insert(i + 1);
+        handle.erase(i + 1);
+    }
+    EXPECT_LT(handle.pending(), 64u);
+}
@@ -0,0 +1,183 @@
+#include "TreeTest.hpp"
+
+#include "trees/FrozenSet.hpp"
+#include "trees/AVLTree.hpp"
+#include "trees/RedBlackTree.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+template<class Key, class Comparator>
+void check_queries(FrozenSet<Key, Comparator> const& frozen, std::set<Key, Comparator> const& set,
+    std::vector<Key> const& queries)
+{
+    EXPECT_EQ(frozen.size(), set.size());
+    EXPECT_EQ(std::vector<Key>(frozen.begin(), frozen.end()), std::vector<Key>(set.begin(), set.end()));
+
+    std::vector<Key> backward;
+    for (auto it = frozen.end(); it != frozen.begin();) {
+        --it;
+        backward.push_back(*it);
+    }
+    EXPECT_EQ(backward, std::vector<Key>(set.rbegin(), set.rend()));
+
+    for (Key const& key : queries) {
+        EXPECT_EQ(frozen.contains(key), set.count(key) == 1);
+        EXPECT_EQ(frozen.rank(key), (std::size_t)std::distance(set.begin(), set.lower_bound(key)));
+
+        auto lower = frozen.lower_bound(key);
+        auto set_lower = set.lower_bound(key);
+        EXPECT_EQ(lower == frozen.end(), set_lower == set.end());
+        if (set_lower != set.end()) {
+            EXPECT_EQ(*lower, *set_lower);
+        }
+
+        auto upper = frozen.upper_bound(key);
+        auto set_upper = set.upper_bound(key);
+        EXPECT_EQ(upper == frozen.end(), set_upper == set.end());
+        if (set_upper != set.end()) {
+            EXPECT_EQ(*upper, *set_upper);
+        }
+
+        auto found = frozen.find(key);
+        EXPECT_EQ(found == frozen.end(), set.count(key) == 0);
+    }
+}
+
+TEST(FrozenSetTest, Construct) {
+    FrozenSet<int> frozen;
+    EXPECT_TRUE(frozen.empty());
+    EXPECT_TRUE(frozen.begin() == frozen.end());
+    EXPECT_FALSE(frozen.contains(0));
+    EXPECT_EQ(frozen.rank(0), 0u);
+}
+
+TEST(FrozenSetTest, AllSizes) {
+    // Every shape of the last level
+    for (int size = 0; size < 300; ++size) {
+        std::set<int> set;
+        for (int i = 0; i < size; ++i) set.insert(2 * i);
+
+        std::vector<int> queries;
+        for (int key = -2; key <= 2 * size + 1; ++key) queries.push_back(key);
+
+        FrozenSet<int> frozen(set.begin(), set.end());
+        check_queries(frozen, set, queries);
+    }
+}
+
+TEST(FrozenSetTest, FromTrees) {
+    std::default_random_engine random(1227992885);
+    AVLTree<int> avl;
+    LeftLeaningRedBlackTree<int> llrb;
+    std::set<int> set;
+    for (int i = 0; i < 50000; ++i) {
+        int key = random() % 100000;
+        avl.insert(key);
+        llrb.insert(key);
+        set.insert(key);
+    }
+
+    std::vector<int> queries;
+    for (int i = 0; i < 20000; ++i) queries.push_back(random() % 100010 - 5);
+
+    FrozenSet<int> from_avl(avl.begin(), avl.end());
+    check_queries(from_avl, set, queries);
+
+    FrozenSet<int> from_llrb(llrb.begin(), llrb.end());
+    check_queries(from_llrb, set, queries);
+}
+
+TEST(FrozenSetTest, Unsorted) {
+    std::default_random_engine random(1227992885);
+    std::vector<int> keys;
+    for (int i = 0; i < 10000; ++i) keys.push_back(random() % 3000);
+    std::set<int> set(keys.begin(), keys.end());
+
+    FrozenSet<int> frozen(keys.begin(), keys.end());
+    EXPECT_EQ(std::vector<int>(frozen.begin(), frozen.end()), std::vector<int>(set.begin(), set.end()));
+}
+
+TEST(FrozenSetTest, CopyMove) {
+    std::vector<int> keys;
+    for (int i = 0; i < 1000; ++i) keys.push_back(i);
+
+    FrozenSet<int> frozen(keys.begin(), keys.end());
+    FrozenSet<int> copy(frozen);
+    FrozenSet<int> moved(std::move(frozen));
+    EXPECT_TRUE(frozen.empty());
+    EXPECT_EQ(std::vector<int>(copy.begin(), copy.end()), keys);
+    EXPECT_EQ(std::vector<int>(moved.begin(), moved.end()), keys);
+
+    frozen = copy;
+    swap(frozen, moved);
+    EXPECT_EQ(std::vector<int>(frozen.begin(), frozen.end()), keys);
+    EXPECT_EQ(frozen.rank(500), 500u);
+}
+
+TEST(FrozenSetTest, StringKeys) {
+    std::set<std::string> set;
+    std::vector<std::string> queries;
+    for (int i = 0; i < 3000; ++i) {
+        std::string key = std::string(40, 'k') + std::to_string(i);
+        if (i % 3 != 0) set.insert(key);
+        queries.push_back(key);
+    }
+
+    FrozenSet<std::string> frozen(set.begin(), set.end());
+    check_queries(frozen, set, queries);
+}
+
+TEST(FrozenSetTest, Comparator) {
+    std::default_random_engine random(1227992885);
+    std::vector<int> keys, queries;
+    for (int i = 0; i < 10000; ++i) keys.push_back(random() % 3000);
+    for (int key = -2; key <= 3001; ++key) queries.push_back(key);
+    std::set<int, std::greater<int>> set(keys.begin(), keys.end());
+
+    // Keys on decreasing order, built from an unsorted and from a sorted range
+    FrozenSet<int, std::greater<int>> unsorted(keys.begin(), keys.end());
+    check_queries(unsorted, set, queries);
+
+    FrozenSet<int, std::greater<int>> sorted(set.begin(), set.end());
+    check_queries(sorted, set, queries);
+}
+
+TEST(FrozenSetTest, TransparentLookup) {
+    std::set<std::string> set;
+    for (int i = 0; i < 1000; ++i) set.insert(std::string(32, 'k') + std::to_string(i * 7 % 1000));
+    FrozenSet<std::string, StringLess> frozen(set.begin(), set.end());
+
+    for (int i = -5; i < 1005; ++i) {
+        std::string key = std::string(32, 'k') + std::to_string(i);
+        char const* c_key = key.c_str(); // Looked up without constructing a std::string
+
+        string_comparisons() = 0;
+        EXPECT_EQ(frozen.contains(c_key), set.count(key) == 1);
+        // One comparison per level, and one to check the equality
+        EXPECT_LE(string_comparisons(), 11);
+
+        EXPECT_EQ(frozen.count(c_key), set.count(key));
+        auto found = frozen.find(c_key);
+        EXPECT_EQ(found == frozen.end(), set.count(key) == 0);
+        if (found != frozen.end()) {
+            EXPECT_EQ(*found, key);
+        }
+
+        auto lower = frozen.lower_bound(c_key);
+        EXPECT_EQ(lower == frozen.end(), set.lower_bound(key) == set.end());
+        if (lower != frozen.end()) {
+            EXPECT_EQ(*lower, *set.lower_bound(key));
+        }
+
+        auto upper = frozen.upper_bound(c_key);
+        EXPECT_EQ(upper == frozen.end(), set.upper_bound(key) == set.end());
+        if (upper != frozen.end()) {
+            EXPECT_EQ(*upper, *set.upper_bound(key));
+        }
+    }
+}
@@ -0,0 +1,171 @@
+#include "TreeTest.hpp"
+
+#include "trees/IntegerSet.hpp"
+#include "allocators/BlockAllocator.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+TEST(IntegerSetTest, Construct) {
+    construct_test<IntegerSet<int>>();
+}
+
+TEST(IntegerSetTest, Insert1) {
+    insert1_test<IntegerSet<int>>();
+}
+
+TEST(IntegerSetTest, Insert2) {
+    insert2_test<IntegerSet<int>>();
+}
+
+TEST(IntegerSetTest, BigInsert1) {
+    big_insert1_test<IntegerSet<int>>();
+}
+
+TEST(IntegerSetTest, Copy) {
+    copy_test<IntegerSet<int>>();
+}
+
+TEST(IntegerSetTest, BigRandomErase) {
+    big_random_erase_test<IntegerSet<int>>();
+}
+
+TEST(IntegerSetTest, Iterators) {
+    iterator_test<IntegerSet<int>>();
+}
+
+TEST(IntegerSetTest, SortedBuild) {
+    sorted_build_test<IntegerSet<int>>();
+}
+
+TEST(IntegerSetTest, BlockAllocator) {
+    insert1_test<IntegerSet<int, BlockAllocator<int>>>();
+}
+
+template<class Key>
+void successor_test(std::vector<Key> const& probes, std::vector<Key> const& keys) {
+    IntegerSet<Key> set;
+    std::set<Key> expected;
+    for (Key key : keys) {
+        EXPECT_EQ(set.insert(key), expected.insert(key).second);
+    }
+    EXPECT_EQ(set.size(), expected.size());
+
+    for (Key key : probes) {
+        auto next = set.successor(key);
+        auto expected_next = expected.upper_bound(key);
+        EXPECT_EQ(next == set.end(), expected_next == expected.end());
+        if (expected_next != expected.end()) {
+            EXPECT_EQ(*next, *expected_next);
+        }
+
+        auto previous = set.predecessor(key);
+        auto expected_previous = expected.lower_bound(key);
+        EXPECT_EQ(previous == set.end(), expected_previous == expected.begin());
+        if (expected_previous != expected.begin()) {
+            EXPECT_EQ(*previous, *--expected_previous);
+        }
+    }
+
+    EXPECT_EQ(std::vector<Key>(set.begin(), set.end()), std::vector<Key>(expected.begin(), expected.end()));
+}
+
+TEST(IntegerSetTest, SuccessorPredecessor) {
+    std::default_random_engine random(1227992885);
+
+    // Dense and sparse keys
+    std::vector<int> dense, sparse, probes;
+    for (int i = 0; i < 20000; ++i) dense.push_back((int)(random() % 30000) - 15000);
+    for (int i = 0; i < 2000; ++i) sparse.push_back((int)random() * (random() % 2 == 0 ? 1 : -1));
+    for (int i = 0; i < 20000; ++i) probes.push_back((int)(random() % 40000) - 20000);
+    for (int key : sparse) {
+        probes.push_back(key);
+        probes.push_back(key - 1);
+        probes.push_back(key + 1);
+    }
+    successor_test<int>(probes, dense);
+    successor_test<int>(probes, sparse);
+
+    // 64-bit keys, spread over all the levels
+    std::mt19937_64 random64(1227992885);
+    std::vector<std::uint64_t> keys64, probes64;
+    for (int i = 0; i < 5000; ++i) {
+        std::uint64_t key = random64() >> (random64() % 64);
+        keys64.push_back(key);
+        probes64.push_back(key);
+        probes64.push_back(key + 1);
+        probes64.push_back(random64() >> (random64() % 64));
+    }
+    successor_test<std::uint64_t>(probes64, keys64);
+}
+
+TEST(IntegerSetTest, Limits) {
+    std::vector<std::int64_t> keys = {
+        std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::min() + 1,
+        -64, -1, 0, 1, 63, 64,
+        std::numeric_limits<std::int64_t>::max() - 1, std::numeric_limits<std::int64_t>::max()
+    };
+    successor_test<std::int64_t>(keys, keys);
+    successor_test<std::int64_t>(keys, std::vector<std::int64_t>());
+
+    std::vector<std::uint8_t> bytes;
+    for (int i = 0; i < 256; i += 3) bytes.push_back((std::uint8_t)i);
+    std::vector<std::uint8_t> all_bytes;
+    for (int i = 0; i < 256; ++i) all_bytes.push_back((std::uint8_t)i);
+    successor_test<std::uint8_t>(all_bytes, bytes);
+    successor_test<std::uint8_t>(all_bytes, all_bytes);
+
+    std::vector<short> shorts = {std::numeric_limits<short>::min(), -1, 0, std::numeric_limits<short>::max()};
+    successor_test<short>(shorts, shorts);
+
+    // The greatest key is the last one, and there is nothing above it
+    IntegerSet<std::uint64_t> set;
+    set.insert(std::numeric_limits<std::uint64_t>::max());
+    set.insert(0);
+    EXPECT_EQ(*set.begin(), 0u);
+    EXPECT_EQ(*--set.end(), std::numeric_limits<std::uint64_t>::max());
+    EXPECT_TRUE(set.upper_bound(std::numeric_limits<std::uint64_t>::max()) == set.end());
+    EXPECT_TRUE(++set.find(std::numeric_limits<std::uint64_t>::max()) == set.end());
+    EXPECT_TRUE(set.predecessor(0) == set.end());
+}
+
+TEST(IntegerSetTest, ReverseIterator) {
+    // Dereferencing returns the key by value, so std::reverse_iterator does not return a
+    // reference to its temporary copy
+    IntegerSet<int> set;
+    std::set<int> expected;
+    std::default_random_engine random(1227992885);
+    for (int i = 0; i < 5000; ++i) {
+        int key = (int)(random() % 20000) - 10000;
+        set.insert(key);
+        expected.insert(key);
+    }
+
+    std::reverse_iterator<IntegerSet<int>::iterator> rbegin(set.end()), rend(set.begin());
+    EXPECT_EQ(std::vector<int>(rbegin, rend), std::vector<int>(expected.rbegin(), expected.rend()));
+
+    auto it = rbegin;
+    for (auto expected_it = expected.rbegin(); expected_it != expected.rend(); ++expected_it, ++it) {
+        EXPECT_EQ(*it, *expected_it);
+    }
+    EXPECT_TRUE(it == rend);
+}
+
+TEST(IntegerSetTest, EraseAll) {
+    // Erasing every key frees the trie, it must keep working after it
+    IntegerSet<int> set;
+    std::default_random_engine random(1227992885);
+    std::vector<int> keys;
+    for (int i = 0; i < 10000; ++i) keys.push_back((int)random());
+    for (int round = 0; round < 3; ++round) {
+        for (int key : keys) set.insert(key);
+        for (int key : keys) set.erase(key);
+        EXPECT_TRUE(set.empty());
+        EXPECT_TRUE(set.begin() == set.end());
+        for (int key : keys) EXPECT_FALSE(set.contains(key));
+    }
+}
@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+
+#include "trees/IntervalTree.hpp"
+
+#include <random>
+#include <set>
+#include <vector>
+
+using Tree = IntervalTree<int>;
+
+std::vector<Interval<int>> brute_overlapping(std::set<Interval<int>> const& set, int lo, int hi) {
+    std::vector<Interval<int>> result;
+    for (Interval<int> const& interval : set) {
+        if (interval.overlaps(lo, hi)) result.push_back(interval);
+    }
+    return result;
+}
+
+TEST(IntervalTreeTest, InsertErase) {
+    Tree tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_FALSE(tree.overlaps(0, 100));
+
+    tree.insert(5, 10);
+    tree.insert(5, 10);
+    tree.insert(1, 3);
+    tree.insert(Interval<int>(5, 7));
+    EXPECT_EQ(tree.size(), 3u);
+    EXPECT_TRUE(tree.contains(5, 7));
+    EXPECT_FALSE(tree.contains(5, 8));
+    EXPECT_EQ(tree.summary(), 10);
+
+    // Ordered by lo, and then by hi
+    std::vector<Interval<int>> expected = {{1, 3}, {5, 7}, {5, 10}};
+    EXPECT_EQ(std::vector<Interval<int>>(tree.begin(), tree.end()), expected);
+
+    tree.erase(5, 10);
+    EXPECT_EQ(tree.size(), 2u);
+    EXPECT_EQ(tree.summary(), 7);
+    EXPECT_FALSE(tree.overlaps(8, 9));
+    EXPECT_TRUE(tree.overlaps(7, 9));
+}
+
+TEST(IntervalTreeTest, Stabbing) {
+    Tree tree;
+    for (int i = 0; i < 10; ++i) tree.insert(i, i + 2);
+
+    std::vector<Interval<int>> found;
+    EXPECT_EQ(tree.for_each_containing(5, [&found](Interval<int> const& interval) { found.push_back(interval); }), 3u);
+    std::vector<Interval<int>> expected = {{3, 5}, {4, 6}, {5, 7}};
+    EXPECT_EQ(found, expected);
+
+    // Closed endpoints
+    EXPECT_EQ(tree.count_overlapping(11, 11), 1u);
+    EXPECT_EQ(tree.count_overlapping(12, 20), 0u);
+    EXPECT_EQ(tree.count_overlapping(-5, -1), 0u);
+    EXPECT_EQ(tree.count_overlapping(-5, 0), 1u);
+}
+
+TEST(IntervalTreeTest, RandomQueries) {
+    std::default_random_engine random(1227992885);
+    Tree tree;
+    std::set<Interval<int>> set;
+
+    for (int i = 0; i < 5000; ++i) {
+        int lo = random() % 10000;
+        // Mostly short intervals, and a few long ones
+        int hi = lo + (random() % 10 == 0 ? random() % 3000 : random() % 50);
+        if (random() % 4 == 0 && !set.empty()) {
+            Interval<int> victim = *set.lower_bound(Interval<int>(lo, lo));
+            tree.erase(victim);
+            set.erase(victim);
+        }
+        else {
+            tree.insert(lo, hi);
+            set.insert(Interval<int>(lo, hi));
+        }
+    }
+    ASSERT_EQ(tree.size(), set.size());
+
+    for (int i = 0; i < 300; ++i) {
+        int lo = (int)(random() % 11000) - 500;
+        int hi = lo + (i % 2 == 0 ? 0 : (int)(random() % 200));
+
+        std::vector<Interval<int>> found;
+        std::size_t count = tree.for_each_overlapping(lo, hi, [&found](Interval<int> const& interval) {
+            found.push_back(interval);
+        });
+        std::vector<Interval<int>> expected = brute_overlapping(set, lo, hi);
+        EXPECT_EQ(found, expected);
+        EXPECT_EQ(count, expected.size());
+        EXPECT_EQ(tree.overlaps(lo, hi), !expected.empty());
+    }
+}
+
+TEST(IntervalTreeTest, SortedBuild) {
+    std::vector<Interval<int>> intervals;
+    for (int i = 0; i < 1000; ++i) intervals.push_back(Interval<int>(i, i + (i % 7) * 10));
+    std::set<Interval<int>> set(intervals.begin(), intervals.end());
+
+    Tree tree(intervals.begin(), intervals.end());
+    for (int point = -10; point < 1100; point += 3) {
+        EXPECT_EQ(tree.count_overlapping(point, point), brute_overlapping(set, point, point).size());
+    }
+}
+
+TEST(IntervalTreeTest, DoubleEndpoints) {
+    IntervalTree<double> tree;
+    tree.insert(-2.5, -1.0);
+    tree.insert(0.5, 1.5);
+    EXPECT_TRUE(tree.overlaps(-1.0, 0.0));
+    EXPECT_FALSE(tree.overlaps(-0.5, 0.25));
+    EXPECT_EQ(tree.count_overlapping(-3.0, 3.0), 2u);
+}
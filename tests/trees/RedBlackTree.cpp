@@ -1,6 +1,7 @@
 #include "TreeTest.hpp"
 
 #include "trees/RedBlackTree.hpp"
+#include "allocators/BlockAllocator.hpp"
 
 TEST(RedBlackTreeTest, Construct) {
 	construct_test<LeftLeaningRedBlackTree<int>>();
@@ -17,3 +18,39 @@ TEST(RedBlackTreeTest, Insert2) {
 TEST(RedBlackTreeTest, BigInsert1) {
     big_insert1_test<LeftLeaningRedBlackTree<int>>();
 }
+
+TEST(RedBlackTreeTest, Copy) {
+    copy_test<LeftLeaningRedBlackTree<int>>();
+}
+
+TEST(RedBlackTreeTest, BigRandomErase) {
+    big_random_erase_test<LeftLeaningRedBlackTree<int>>();
+}
+
+TEST(RedBlackTreeTest, BlockAllocatorInsert1) {
+    insert1_test<LeftLeaningRedBlackTree<int, std::less<int>, BlockAllocator<int>>>();
+}
+
+TEST(RedBlackTreeTest, BlockAllocatorBigInsert1) {
+    big_insert1_test<LeftLeaningRedBlackTree<int, std::less<int>, BlockAllocator<int>>>();
+}
+
+TEST(RedBlackTreeTest, Iterators) {
+    iterator_test<LeftLeaningRedBlackTree<int>>();
+}
+
+TEST(RedBlackTreeTest, SortedBuild) {
+    sorted_build_test<LeftLeaningRedBlackTree<int>>();
+}
+
+TEST(RedBlackTreeTest, BatchLookup) {
+    batch_lookup_test<LeftLeaningRedBlackTree<int>>();
+}
+
+TEST(RedBlackTreeTest, Comparator) {
+    comparator_test<LeftLeaningRedBlackTree<int, std::greater<int>>>();
+}
+
+TEST(RedBlackTreeTest, TransparentLookup) {
+    transparent_lookup_test<LeftLeaningRedBlackTree<std::string, StringLess>>();
+}
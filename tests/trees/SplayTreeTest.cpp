@@ -0,0 +1,158 @@
+#include "TreeTest.hpp"
+
+#include "trees/SplayTree.hpp"
+#include "allocators/BlockAllocator.hpp"
+
+#include <set>
+#include <string>
+#include <vector>
+
+TEST(SplayTreeTest, Construct) {
+    construct_test<SplayTree<int>>();
+}
+
+TEST(SplayTreeTest, Insert1) {
+    insert1_test<SplayTree<int>>();
+}
+
+TEST(SplayTreeTest, Insert2) {
+    insert2_test<SplayTree<int>>();
+}
+
+TEST(SplayTreeTest, BigInsert1) {
+    big_insert1_test<SplayTree<int>>();
+}
+
+TEST(SplayTreeTest, Copy) {
+    copy_test<SplayTree<int>>();
+}
+
+TEST(SplayTreeTest, BigRandomErase) {
+    big_random_erase_test<SplayTree<int>>();
+}
+
+TEST(SplayTreeTest, Iterators) {
+    iterator_test<SplayTree<int>>();
+}
+
+TEST(SplayTreeTest, SortedBuild) {
+    sorted_build_test<SplayTree<int>>();
+}
+
+TEST(SplayTreeTest, Comparator) {
+    comparator_test<SplayTree<int, std::greater<int>>>();
+}
+
+TEST(SplayTreeTest, BlockAllocator) {
+    insert1_test<SplayTree<int, std::less<int>, BlockAllocator<int>>>();
+}
+
+TEST(SplayTreeTest, HotKeysNearRoot) {
+    const int size = 1000;
+    SplayTree<std::string, StringLess> tree;
+    for (int i = 0; i < size; ++i) {
+        tree.insert(std::string(32, 'k') + std::to_string(i * 7 % size));
+    }
+
+    // After an access, the key is on the root
+    std::string hot = std::string(32, 'k') + std::to_string(123);
+    EXPECT_TRUE(tree.contains(hot));
+    string_comparisons() = 0;
+    EXPECT_TRUE(tree.contains(hot));
+    EXPECT_LE(string_comparisons(), 2);
+
+    // A few hot keys stay near the root while they are accessed
+    std::vector<std::string> hot_keys;
+    for (int i = 0; i < 4; ++i) hot_keys.push_back(std::string(32, 'k') + std::to_string(i * 250));
+    for (int round = 0; round < 10; ++round) {
+        for (std::string const& key : hot_keys) tree.contains(key);
+    }
+    string_comparisons() = 0;
+    for (std::string const& key : hot_keys) EXPECT_TRUE(tree.contains(key));
+    EXPECT_LE(string_comparisons(), 4 * 2 * 4);
+
+    // Const lookups do not move keys
+    SplayTree<std::string, StringLess> const& view = tree;
+    std::string cold = std::string(32, 'k') + std::to_string(999);
+    EXPECT_TRUE(view.contains(cold));
+    string_comparisons() = 0;
+    EXPECT_TRUE(tree.contains(hot_keys.back()));
+    EXPECT_LE(string_comparisons(), 2);
+}
+
+TEST(SplayTreeTest, RangeQueriesSplay) {
+    // Sorted inserts make a path, range queries must adapt like the other lookups
+    const int size = 1000;
+    SplayTree<std::string, StringLess> tree;
+    std::set<std::string> set;
+    for (int i = 0; i < size; ++i) {
+        std::string key = std::string(32, 'k') + std::to_string(100000 + i);
+        tree.insert(key);
+        set.insert(key);
+    }
+
+    std::string hot = std::string(32, 'k') + std::to_string(100123);
+    EXPECT_EQ(*tree.lower_bound(hot), hot);
+    string_comparisons() = 0;
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(*tree.lower_bound(hot), hot);
+    EXPECT_LE(string_comparisons(), 100 * 8);
+
+    EXPECT_EQ(*tree.upper_bound(hot), *set.upper_bound(hot));
+    string_comparisons() = 0;
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(*tree.upper_bound(hot), *set.upper_bound(hot));
+    EXPECT_LE(string_comparisons(), 100 * 8);
+
+    // The first key of the range goes to the root
+    std::string lo = std::string(32, 'k') + std::to_string(100900);
+    std::string hi = std::string(32, 'k') + std::to_string(100910);
+    std::vector<std::string> range;
+    tree.for_each_in_range(lo, hi, [&](std::string const& key) { range.push_back(key); });
+    EXPECT_EQ(range, std::vector<std::string>(set.lower_bound(lo), set.lower_bound(hi)));
+    string_comparisons() = 0;
+    EXPECT_EQ(*tree.lower_bound(lo), lo);
+    EXPECT_LE(string_comparisons(), 4);
+
+    EXPECT_EQ(*tree.begin(), *set.begin());
+    string_comparisons() = 0;
+    EXPECT_EQ(*tree.lower_bound(*set.begin()), *set.begin());
+    EXPECT_LE(string_comparisons(), 4);
+
+    // Const range queries only search
+    SplayTree<std::string, StringLess> const& view = tree;
+    std::vector<std::string> all;
+    view.for_each_in_range(*set.begin(), hot, [&](std::string const& key) { all.push_back(key); });
+    EXPECT_EQ(all, std::vector<std::string>(set.begin(), set.lower_bound(hot)));
+    EXPECT_EQ(*view.lower_bound(hot), hot);
+    EXPECT_EQ(*view.upper_bound(hot), *set.upper_bound(hot));
+    EXPECT_EQ(std::vector<std::string>(view.begin(), view.end()), std::vector<std::string>(set.begin(), set.end()));
+    string_comparisons() = 0;
+    EXPECT_EQ(*tree.lower_bound(*set.begin()), *set.begin());
+    EXPECT_LE(string_comparisons(), 4);
+}
+
+TEST(SplayTreeTest, DegenerateShapes) {
+    // Sorted inserts make a path of 10^6 nodes, that must be copied, iterated and destroyed
+    // without recursion
+    const int size = 1000000;
+    SplayTree<int> tree;
+    for (int i = 0; i < size; ++i) tree.insert(i);
+
+    SplayTree<int> copy(tree);
+    EXPECT_EQ(copy.size(), tree.size());
+
+    long long sum = 0;
+    for (int key : tree) sum += key;
+    EXPECT_EQ(sum, (long long)size * (size - 1) / 2);
+
+    // Iterators stay valid while other keys are accessed
+    auto it = tree.find(size / 2);
+    tree.contains(0);
+    tree.erase(size / 2 + 1);
+    EXPECT_EQ(*it, size / 2);
+    EXPECT_EQ(*++it, size / 2 + 2);
+
+    for (int i = 0; i < size; i += 2) tree.erase(i);
+    EXPECT_EQ(tree.size(), (std::size_t)size / 2 - 1);
+    EXPECT_TRUE(tree.contains(size - 1));
+    EXPECT_FALSE(tree.contains(0));
+}
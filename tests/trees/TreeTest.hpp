@@ -171,3 +171,307 @@ void big_insert1_test(){
         tree.erase(elem);
 	}
 }
+
+template<class T>
+void copy_test(){
+    T tree1;
+    for (int i = 0; i < 100; ++i) {
+        tree1.insert(i);
+    }
+
+    T tree2(tree1);
+    for (int i = 0; i < 100; i += 2) {
+        tree1.erase(i);
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(tree1.count(i) == 1, i % 2 == 1);
+        EXPECT_TRUE(tree2.count(i) == 1);
+    }
+
+    T tree3(std::move(tree2));
+    tree2 = tree3;
+    tree3 = std::move(tree1);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(tree2.count(i) == 1);
+        EXPECT_EQ(tree3.count(i) == 1, i % 2 == 1);
+    }
+}
+
+#include <set>
+template<class T>
+void big_random_erase_test(){
+    T tree;
+    std::set<int> set;
+    std::default_random_engine random(1227992885);
+    size_t size = 200000;
+
+    for (std::size_t i = 0; i < size; ++i) {
+        int elem = random() % 10000;
+        if (random() % 2 == 0) {
+            tree.insert(elem);
+            set.insert(elem);
+        }
+        else {
+            tree.erase(elem);
+            set.erase(elem);
+        }
+    }
+
+    for (int elem = 0; elem < 10000; ++elem) {
+        EXPECT_EQ(tree.count(elem) == 1, set.count(elem) == 1);
+    }
+}
+
+#include <iterator>
+template<class T>
+void iterator_test(){
+    T tree;
+    std::set<int> set;
+    std::default_random_engine random(1227992885);
+
+    EXPECT_TRUE(tree.begin() == tree.end());
+    for (std::size_t i = 0; i < 20000; ++i) {
+        int elem = random() % 10000;
+        if (random() % 3 == 0) {
+            tree.erase(elem);
+            set.erase(elem);
+        }
+        else {
+            tree.insert(elem);
+            set.insert(elem);
+        }
+    }
+
+    // Forward and backward
+    std::vector<int> expected(set.begin(), set.end());
+    std::vector<int> forward(tree.begin(), tree.end());
+    EXPECT_EQ(forward, expected);
+
+    std::vector<int> backward;
+    for (auto it = tree.end(); it != tree.begin();) {
+        --it;
+        backward.push_back(*it);
+    }
+    EXPECT_EQ(backward, std::vector<int>(set.rbegin(), set.rend()));
+
+    // Ordered queries
+    for (int key = -10; key < 10010; ++key) {
+        auto lower = tree.lower_bound(key);
+        auto set_lower = set.lower_bound(key);
+        EXPECT_EQ(lower == tree.end(), set_lower == set.end());
+        if (set_lower != set.end()) {
+            EXPECT_EQ(*lower, *set_lower);
+        }
+
+        auto upper = tree.upper_bound(key);
+        auto set_upper = set.upper_bound(key);
+        EXPECT_EQ(upper == tree.end(), set_upper == set.end());
+        if (set_upper != set.end()) {
+            EXPECT_EQ(*upper, *set_upper);
+        }
+
+        auto found = tree.find(key);
+        EXPECT_EQ(found == tree.end(), set.count(key) == 0);
+        if (found != tree.end()) {
+            EXPECT_EQ(*found, key);
+            if (++found != tree.end()) {
+                EXPECT_EQ(*found, *set.upper_bound(key));
+            }
+        }
+    }
+
+    // Range scans
+    for (int i = 0; i < 200; ++i) {
+        int lo = random() % 11000 - 500;
+        int hi = lo + random() % 2000;
+        std::vector<int> scanned;
+        tree.for_each_in_range(lo, hi, [&scanned](int const& key) { scanned.push_back(key); });
+        EXPECT_EQ(scanned, std::vector<int>(set.lower_bound(lo), set.lower_bound(hi)));
+    }
+}
+
+template<class T>
+void sorted_build_test(){
+    std::default_random_engine random(1227992885);
+
+    for (int size = 0; size < 300; ++size) {
+        std::vector<int> keys;
+        for (int i = 0; i < size; ++i) keys.push_back(3 * i);
+
+        T tree;
+        tree.insert(-1);
+        tree.assign_sorted(keys.begin(), keys.end());
+        EXPECT_EQ(std::vector<int>(tree.begin(), tree.end()), keys);
+
+        // The tree must stay valid after the build
+        std::set<int> set(keys.begin(), keys.end());
+        for (int i = 0; i < size; ++i) {
+            int elem = random() % (3 * size + 3);
+            if (random() % 2 == 0) {
+                tree.insert(elem);
+                set.insert(elem);
+            }
+            else {
+                tree.erase(elem);
+                set.erase(elem);
+            }
+        }
+        EXPECT_EQ(std::vector<int>(tree.begin(), tree.end()), std::vector<int>(set.begin(), set.end()));
+    }
+
+    // Unsorted ranges, with repeated keys
+    std::vector<int> keys;
+    for (int i = 0; i < 10000; ++i) keys.push_back(random() % 3000);
+    std::set<int> set(keys.begin(), keys.end());
+
+    T tree(keys.begin(), keys.end());
+    EXPECT_EQ(std::vector<int>(tree.begin(), tree.end()), std::vector<int>(set.begin(), set.end()));
+
+    tree.assign(set.rbegin(), set.rend());
+    EXPECT_EQ(std::vector<int>(tree.begin(), tree.end()), std::vector<int>(set.begin(), set.end()));
+}
+
+template<class T>
+void batch_lookup_test(){
+    std::default_random_engine random(1227992885);
+
+    for (int size : {0, 1, 15, 16, 17, 1000}) {
+        T tree;
+        std::set<int> set;
+        for (int i = 0; i < size; ++i) {
+            int elem = random() % (2 * size);
+            tree.insert(elem);
+            set.insert(elem);
+        }
+
+        // Groups of every size, with repeated and missing keys
+        std::vector<int> queries;
+        for (int i = 0; i < 3 * size + 5; ++i) queries.push_back((int)(random() % (2 * size + 2)) - 1);
+
+        std::vector<bool> contained;
+        tree.contains_batch(queries.begin(), queries.end(), std::back_inserter(contained));
+        std::vector<int const*> found(queries.size());
+        EXPECT_EQ(tree.find_batch(queries.begin(), queries.end(), found.begin()), found.end());
+
+        ASSERT_EQ(contained.size(), queries.size());
+        for (std::size_t i = 0; i < queries.size(); ++i) {
+            EXPECT_EQ(contained[i], set.count(queries[i]) == 1);
+            if (set.count(queries[i]) == 1) {
+                ASSERT_NE(found[i], nullptr);
+                EXPECT_EQ(*found[i], queries[i]);
+                EXPECT_EQ(found[i], &*tree.find(queries[i]));
+            }
+            else EXPECT_EQ(found[i], nullptr);
+        }
+    }
+}
+
+#include <functional>
+#include <string>
+template<class T>
+void comparator_test(){
+    std::default_random_engine random(1227992885);
+    std::set<int, std::greater<int>> set;
+    T tree;
+    for (int i = 0; i < 2000; ++i) {
+        int elem = random() % 1000;
+        if (random() % 3 == 0) {
+            tree.erase(elem);
+            set.erase(elem);
+        }
+        else {
+            tree.insert(elem);
+            set.insert(elem);
+        }
+    }
+
+    // Keys on decreasing order
+    EXPECT_EQ(std::vector<int>(tree.begin(), tree.end()), std::vector<int>(set.begin(), set.end()));
+    for (int elem = -1; elem <= 1000; ++elem) {
+        EXPECT_EQ(tree.count(elem) == 1, set.count(elem) == 1);
+
+        auto lower = tree.lower_bound(elem);
+        EXPECT_EQ(lower == tree.end(), set.lower_bound(elem) == set.end());
+        if (lower != tree.end()) {
+            EXPECT_EQ(*lower, *set.lower_bound(elem));
+        }
+    }
+
+    std::vector<int> keys(set.begin(), set.end());
+    T sorted(keys.begin(), keys.end());
+    EXPECT_EQ(std::vector<int>(sorted.begin(), sorted.end()), keys);
+    T unsorted(keys.rbegin(), keys.rend());
+    EXPECT_EQ(std::vector<int>(unsorted.begin(), unsorted.end()), keys);
+}
+
+/**
+ * @brief Number of comparisons made by StringLess
+ */
+inline int& string_comparisons() {
+    static int comparisons = 0;
+    return comparisons;
+}
+
+/**
+ * @brief Transparent comparator between std::string and C strings
+ */
+struct StringLess {
+    using is_transparent = void;
+
+    bool operator()(std::string const& a, std::string const& b) const {
+        ++string_comparisons();
+        return a < b;
+    }
+
+    bool operator()(std::string const& a, char const* b) const {
+        ++string_comparisons();
+        return a.compare(b) < 0;
+    }
+
+    bool operator()(char const* a, std::string const& b) const {
+        ++string_comparisons();
+        return b.compare(a) > 0;
+    }
+};
+
+template<class T>
+void transparent_lookup_test(){
+    const int size = 1000;
+    T tree;
+    std::set<std::string> set;
+    for (int i = 0; i < size; ++i) {
+        std::string key = std::string(32, 'k') + std::to_string(i * 7 % size);
+        tree.insert(key);
+        set.insert(key);
+    }
+
+    for (int i = -5; i < size + 5; ++i) {
+        std::string key = std::string(32, 'k') + std::to_string(i);
+        char const* c_key = key.c_str(); // Looked up without constructing a std::string
+
+        string_comparisons() = 0;
+        EXPECT_EQ(tree.contains(c_key), set.count(key) == 1);
+        // One comparison per level, and one to check the equality
+        EXPECT_LE(string_comparisons(), 21);
+
+        EXPECT_EQ(tree.count(c_key), set.count(key));
+        auto found = tree.find(c_key);
+        EXPECT_EQ(found == tree.end(), set.count(key) == 0);
+        if (found != tree.end()) {
+            EXPECT_EQ(*found, key);
+        }
+
+        auto lower = tree.lower_bound(c_key);
+        EXPECT_EQ(lower == tree.end(), set.lower_bound(key) == set.end());
+        if (lower != tree.end()) {
+            EXPECT_EQ(*lower, *set.lower_bound(key));
+        }
+
+        auto upper = tree.upper_bound(c_key);
+        EXPECT_EQ(upper == tree.end(), set.upper_bound(key) == set.end());
+        if (upper != tree.end()) {
+            EXPECT_EQ(*upper, *set.upper_bound(key));
+        }
+    }
+}